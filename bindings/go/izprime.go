@@ -89,6 +89,66 @@ func NextPrime(baseExpr string, forward bool) (string, error) {
 	return C.GoString(out), nil
 }
 
+func RandomPrimes(bitSize int, count int, threads int) ([]string, float64, error) {
+	if count < 0 {
+		return nil, 0, &Error{Status: 1, Message: "count must be non-negative"}
+	}
+
+	var out C.IZP_STR_BUFFER
+	var rate C.double
+	status := int(C.izp_ffi_random_primes(C.int(bitSize), C.size_t(count), C.int(threads), &out, &rate))
+	if status != 0 {
+		return nil, 0, statusError(status)
+	}
+	defer C.izp_ffi_free_str_buffer(&out)
+
+	return strBufferToSlice(&out), float64(rate), nil
+}
+
+func NextPrimeBatch(baseExprs []string, forward bool, threads int) ([]string, error) {
+	if len(baseExprs) == 0 {
+		return []string{}, nil
+	}
+
+	cBases := unsafe.Slice((**C.char)(C.malloc(C.size_t(len(baseExprs))*C.size_t(unsafe.Sizeof((*C.char)(nil))))), len(baseExprs))
+	defer C.free(unsafe.Pointer(&cBases[0]))
+	for i, expr := range baseExprs {
+		cBases[i] = C.CString(expr)
+	}
+	defer func() {
+		for _, v := range cBases {
+			C.free(unsafe.Pointer(v))
+		}
+	}()
+
+	dir := C.int(0)
+	if forward {
+		dir = 1
+	}
+
+	var out C.IZP_STR_BUFFER
+	status := int(C.izp_ffi_next_prime_batch(&cBases[0], C.size_t(len(baseExprs)), dir, C.int(threads), &out))
+	if status != 0 {
+		return nil, statusError(status)
+	}
+	defer C.izp_ffi_free_str_buffer(&out)
+
+	return strBufferToSlice(&out), nil
+}
+
+func strBufferToSlice(buf *C.IZP_STR_BUFFER) []string {
+	if buf.len == 0 || buf.data == nil {
+		return []string{}
+	}
+
+	vals := unsafe.Slice(buf.data, int(buf.len))
+	result := make([]string, len(vals))
+	for i, v := range vals {
+		result[i] = C.GoString(v)
+	}
+	return result
+}
+
 func statusError(status int) error {
 	msg := C.GoString(C.izp_ffi_last_error())
 	if msg == "" {
@@ -6,7 +6,7 @@ from dataclasses import dataclass
 from enum import IntEnum
 import ctypes
 
-from ._ffi import IzpU64Buffer, load_library
+from ._ffi import IzpStrBuffer, IzpU64Buffer, load_library
 
 
 class Status(IntEnum):
@@ -106,12 +106,34 @@ class Izprime:
         finally:
             self._lib.izp_ffi_free_string(ctypes.byref(out))
 
+    def next_primes(self, base_exprs: list[str], forward: bool = True, threads: int = 1) -> list[int]:
+        """Next (or previous) prime of every base, in input order."""
+        exprs = (ctypes.c_char_p * len(base_exprs))(*(str(b).encode("utf-8") for b in base_exprs))
+        out = IzpStrBuffer()
+        status = self._lib.izp_ffi_next_prime_batch(exprs, len(base_exprs), 1 if forward else 0, int(threads), ctypes.byref(out))
+        self._raise_if_error(status)
+        try:
+            return [int(out.data[i].decode("utf-8")) for i in range(out.len)]
+        finally:
+            self._lib.izp_ffi_free_str_buffer(ctypes.byref(out))
+
     def random_prime_vx(self, bit_size: int, cores: int = 1) -> int:
         return self._random_prime(self._lib.izp_ffi_random_prime_vx, bit_size, cores)
 
     def random_prime_vy(self, bit_size: int, cores: int = 1) -> int:
         return self._random_prime(self._lib.izp_ffi_random_prime_vy, bit_size, cores)
 
+    def random_primes(self, bit_size: int, count: int, threads: int = 1) -> tuple[list[int], float]:
+        """Generate `count` random primes; returns (primes, primes_per_second)."""
+        out = IzpStrBuffer()
+        rate = ctypes.c_double(0.0)
+        status = self._lib.izp_ffi_random_primes(int(bit_size), int(count), int(threads), ctypes.byref(out), ctypes.byref(rate))
+        self._raise_if_error(status)
+        try:
+            return [int(out.data[i].decode("utf-8")) for i in range(out.len)], float(rate.value)
+        finally:
+            self._lib.izp_ffi_free_str_buffer(ctypes.byref(out))
+
     def _random_prime(self, fn, bit_size: int, cores: int) -> int:
         out = ctypes.c_char_p()
         status = fn(int(bit_size), int(cores), ctypes.byref(out))
@@ -20,6 +20,13 @@ class IzpU64Buffer(ctypes.Structure):
 IZP_U64_BUFFER = IzpU64Buffer
 
 
+class IzpStrBuffer(ctypes.Structure):
+    _fields_ = [
+        ("data", ctypes.POINTER(ctypes.c_char_p)),
+        ("len", ctypes.c_size_t),
+    ]
+
+
 def _library_candidates() -> list[str]:
     env_path = os.environ.get("IZPRIME_LIB")
     candidates: list[str] = []
@@ -105,14 +112,35 @@ def _configure_signatures(lib: ctypes.CDLL) -> None:
     lib.izp_ffi_next_prime.restype = ctypes.c_int
     lib.izp_ffi_next_prime.argtypes = [ctypes.c_char_p, ctypes.c_int, ctypes.POINTER(ctypes.c_char_p)]
 
+    lib.izp_ffi_next_prime_batch.restype = ctypes.c_int
+    lib.izp_ffi_next_prime_batch.argtypes = [
+        ctypes.POINTER(ctypes.c_char_p),
+        ctypes.c_size_t,
+        ctypes.c_int,
+        ctypes.c_int,
+        ctypes.POINTER(IzpStrBuffer),
+    ]
+
     lib.izp_ffi_random_prime_vx.restype = ctypes.c_int
     lib.izp_ffi_random_prime_vx.argtypes = [ctypes.c_int, ctypes.c_int, ctypes.POINTER(ctypes.c_char_p)]
 
     lib.izp_ffi_random_prime_vy.restype = ctypes.c_int
     lib.izp_ffi_random_prime_vy.argtypes = [ctypes.c_int, ctypes.c_int, ctypes.POINTER(ctypes.c_char_p)]
 
+    lib.izp_ffi_random_primes.restype = ctypes.c_int
+    lib.izp_ffi_random_primes.argtypes = [
+        ctypes.c_int,
+        ctypes.c_size_t,
+        ctypes.c_int,
+        ctypes.POINTER(IzpStrBuffer),
+        ctypes.POINTER(ctypes.c_double),
+    ]
+
     lib.izp_ffi_free_u64_buffer.restype = None
     lib.izp_ffi_free_u64_buffer.argtypes = [ctypes.POINTER(IzpU64Buffer)]
 
     lib.izp_ffi_free_string.restype = None
     lib.izp_ffi_free_string.argtypes = [ctypes.POINTER(ctypes.c_char_p)]
+
+    lib.izp_ffi_free_str_buffer.restype = None
+    lib.izp_ffi_free_str_buffer.argtypes = [ctypes.POINTER(IzpStrBuffer)]
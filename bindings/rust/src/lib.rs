@@ -21,6 +21,12 @@ struct U64Buffer {
     len: usize,
 }
 
+#[repr(C)]
+struct StrBuffer {
+    data: *mut *mut c_char,
+    len: usize,
+}
+
 #[derive(Debug)]
 pub struct IzprimeError {
     pub status: i32,
@@ -44,9 +50,12 @@ extern "C" {
     fn izp_ffi_sieve_u64(kind: c_int, limit: u64, out: *mut U64Buffer) -> c_int;
     fn izp_ffi_count_range(start: *const c_char, range: u64, mr_rounds: c_int, cores: c_int, out_count: *mut u64) -> c_int;
     fn izp_ffi_next_prime(base_expr: *const c_char, forward: c_int, out_prime_base10: *mut *mut c_char) -> c_int;
+    fn izp_ffi_next_prime_batch(base_exprs: *const *const c_char, count: usize, forward: c_int, threads: c_int, out: *mut StrBuffer) -> c_int;
+    fn izp_ffi_random_primes(bit_size: c_int, count: usize, threads: c_int, out: *mut StrBuffer, out_primes_per_sec: *mut f64) -> c_int;
 
     fn izp_ffi_free_u64_buffer(out: *mut U64Buffer);
     fn izp_ffi_free_string(out: *mut *mut c_char);
+    fn izp_ffi_free_str_buffer(out: *mut StrBuffer);
 }
 
 pub fn version() -> String {
@@ -124,6 +133,65 @@ pub fn next_prime(base_expr: &str, forward: bool) -> Result<String, IzprimeError
     Ok(s)
 }
 
+/// Resolves the next (or previous) prime of every base expression on `threads` workers.
+pub fn next_prime_batch(base_exprs: &[&str], forward: bool, threads: i32) -> Result<Vec<String>, IzprimeError> {
+    if base_exprs.is_empty() {
+        return Ok(vec![]);
+    }
+
+    let c_bases = base_exprs
+        .iter()
+        .map(|&expr| CString::new(expr))
+        .collect::<Result<Vec<_>, _>>()
+        .map_err(|_| IzprimeError {
+            status: 1,
+            message: "base expression contains interior NUL".to_string(),
+        })?;
+    let c_ptrs: Vec<*const c_char> = c_bases.iter().map(|s| s.as_ptr()).collect();
+
+    let mut out = StrBuffer {
+        data: std::ptr::null_mut(),
+        len: 0,
+    };
+    let direction = if forward { 1 } else { 0 };
+
+    let status = unsafe { izp_ffi_next_prime_batch(c_ptrs.as_ptr(), c_ptrs.len(), direction, threads as c_int, &mut out) };
+    if status != 0 {
+        return Err(last_error(status));
+    }
+
+    Ok(unsafe { take_str_buffer(&mut out) })
+}
+
+/// Generates `count` random primes of `bit_size` bits; returns (primes, primes_per_second).
+pub fn random_primes(bit_size: i32, count: usize, threads: i32) -> Result<(Vec<String>, f64), IzprimeError> {
+    let mut out = StrBuffer {
+        data: std::ptr::null_mut(),
+        len: 0,
+    };
+    let mut rate = 0.0_f64;
+
+    let status = unsafe { izp_ffi_random_primes(bit_size as c_int, count, threads as c_int, &mut out, &mut rate) };
+    if status != 0 {
+        return Err(last_error(status));
+    }
+
+    Ok((unsafe { take_str_buffer(&mut out) }, rate))
+}
+
+unsafe fn take_str_buffer(out: &mut StrBuffer) -> Vec<String> {
+    let vals = if out.data.is_null() || out.len == 0 {
+        vec![]
+    } else {
+        std::slice::from_raw_parts(out.data, out.len)
+            .iter()
+            .map(|&s| cstr_to_string(s as *const c_char))
+            .collect()
+    };
+    izp_ffi_free_str_buffer(out);
+    vals
+}
+
 fn last_error(status: i32) -> IzprimeError {
     unsafe {
         let raw = izp_ffi_last_error();
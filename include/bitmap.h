@@ -114,7 +114,11 @@ void bitmap_clear_all(BITMAP *bitmap);
 void bitmap_clear_steps(BITMAP *bitmap, uint64_t step, uint64_t start_idx, uint64_t limit);
 
 /**
- * @brief SIMD-accelerated variant of bitmap_clear_steps().
+ * @brief Fast variant of bitmap_clear_steps() with per-step-size kernels.
+ *
+ * Steps below 8 use periodic 64-bit word masks, steps with at least 8 hits
+ * use an unrolled byte-mask wheel, and sparse steps fall back to a scalar loop.
+ *
  * @param bitmap Bitmap to modify.
  * @param step Index increment between cleared bits.
  * @param start_idx First index to clear.
@@ -123,6 +127,97 @@ void bitmap_clear_steps(BITMAP *bitmap, uint64_t step, uint64_t start_idx, uint6
 void bitmap_clear_steps_simd(BITMAP *bitmap, uint64_t step, uint64_t start_idx, uint64_t limit);
 /** @} */
 
+/** @name Word-level Scans */
+/** @{ */
+/** Sentinel returned by bitmap_next_set_bit() when no set bit is found. */
+#define BITMAP_NPOS ((size_t)-1)
+
+/**
+ * @brief Callback invoked by bitmap_for_each_set_bit() for every set bit.
+ * @param idx Zero-based index of the set bit.
+ * @param ctx Caller-provided context pointer.
+ */
+typedef void (*BITMAP_BIT_VISITOR)(size_t idx, void *ctx);
+
+/**
+ * @brief Count set bits in the inclusive index range [@p start_idx, @p end_idx].
+ *
+ * Bits are consumed 64 at a time with hardware popcount where available.
+ *
+ * @param bitmap Bitmap to inspect.
+ * @param start_idx First index to count.
+ * @param end_idx Inclusive upper index bound (capped to size-1).
+ * @return Number of set bits in the range, or 0 for an empty range.
+ */
+size_t bitmap_count_range(BITMAP *bitmap, size_t start_idx, size_t end_idx);
+
+/**
+ * @brief Find the first set bit in the inclusive range [@p start_idx, @p limit].
+ * @param bitmap Bitmap to scan.
+ * @param start_idx First index to inspect.
+ * @param limit Inclusive upper index bound (capped to size-1).
+ * @return Index of the first set bit, or @ref BITMAP_NPOS when none is found.
+ */
+size_t bitmap_next_set_bit(BITMAP *bitmap, size_t start_idx, size_t limit);
+
+/**
+ * @brief Invoke @p visitor for every set bit in [@p start_idx, @p end_idx], in ascending order.
+ * @param bitmap Bitmap to scan.
+ * @param start_idx First index to inspect.
+ * @param end_idx Inclusive upper index bound (capped to size-1).
+ * @param visitor Callback invoked with each set-bit index.
+ * @param ctx Opaque pointer forwarded to @p visitor.
+ */
+void bitmap_for_each_set_bit(BITMAP *bitmap, size_t start_idx, size_t end_idx, BITMAP_BIT_VISITOR visitor, void *ctx);
+/** @} */
+
+/** @name Periodic Patterns */
+/** @{ */
+/** Maximum number of steps a single BITMAP_PATTERN may hold. */
+#define BITMAP_PATTERN_MAX_COUNT 32
+
+/**
+ * @brief Precomputed 64-bit clearing masks for a set of small odd steps.
+ *
+ * Lets dense progressions (small sieving primes) be cleared a whole word at a
+ * time instead of bit by bit. Tables are read-only once built.
+ */
+typedef struct
+{
+    int count;        /**< Number of steps. */
+    uint64_t *steps;  /**< Odd steps (periods in bits), each >= 5. */
+    uint64_t *inv64;  /**< 64^-1 mod step, used to locate the table row of a start offset. */
+    uint64_t **masks; /**< Per-step table of step + 3 words; the last 3 wrap around. */
+} BITMAP_PATTERN;
+
+/**
+ * @brief Build clearing masks for @p count odd steps.
+ * @param steps Odd steps >= 5.
+ * @param count Number of steps (at most @ref BITMAP_PATTERN_MAX_COUNT).
+ * @return Newly allocated pattern, or NULL on allocation failure.
+ */
+BITMAP_PATTERN *bitmap_pattern_init(const uint64_t *steps, int count);
+
+/**
+ * @brief Free a pattern and set the caller pointer to NULL.
+ * @param pattern Address of a BITMAP_PATTERN pointer.
+ */
+void bitmap_pattern_free(BITMAP_PATTERN **pattern);
+
+/**
+ * @brief Clear every step progression of @p pattern in one word-level pass.
+ *
+ * Equivalent to bitmap_clear_steps(bitmap, steps[i], start_idx[i], limit) for
+ * each step i, vectorized with AVX2/NEON where available.
+ *
+ * @param bitmap Bitmap to modify.
+ * @param pattern Pattern built by bitmap_pattern_init().
+ * @param start_idx Per-step first index to clear; values above @p limit skip the step.
+ * @param limit Inclusive upper index bound.
+ */
+void bitmap_apply_pattern(BITMAP *bitmap, const BITMAP_PATTERN *pattern, const uint64_t *start_idx, uint64_t limit);
+/** @} */
+
 /** @name Integrity and I/O */
 /** @{ */
 /**
@@ -103,6 +103,19 @@ UI64_ARRAY *SiZ(uint64_t n);
  */
 UI64_ARRAY *SiZm(uint64_t n);
 
+/**
+ * @brief Multi-threaded Sieve-iZm (VX segmented, blocks of segments per pthread).
+ *
+ * Same output as `SiZm` (sorted), with segments y >= 1 split into contiguous
+ * blocks sieved by worker threads and concatenated in order.
+ *
+ * @param n Upper bound (inclusive).
+ * @param threads Worker threads; <= 0 uses every online core.
+ * @return Heap-allocated prime list, or NULL on allocation failure.
+ * @pre n <= 10^12.
+ */
+UI64_ARRAY *SiZm_mt(uint64_t n, int threads);
+
 /**
  * @brief Segmented Sieve-iZm with vertical (y-major) traversal.
  *
@@ -116,6 +129,32 @@ UI64_ARRAY *SiZm(uint64_t n);
  */
 UI64_ARRAY *SiZm_vy(uint64_t n);
 
+/**
+ * @brief Multi-threaded Sieve-iZm with vertical (vy) traversal.
+ *
+ * Worker threads claim iZm columns dynamically and sieve them in private lane
+ * bitmaps; per-thread prime buffers are joined at the end (unordered output).
+ *
+ * @param n Upper bound (inclusive).
+ * @param threads Worker threads; <= 0 uses every online core.
+ * @return Heap-allocated prime list (unordered), or NULL on allocation failure.
+ * @pre n <= 10^12.
+ */
+UI64_ARRAY *SiZm_vy_mt(uint64_t n, int threads);
+
+/**
+ * @brief Sieve-iZm with vertical lanes and sorted output.
+ *
+ * Sieves blocks of rows across all iZm columns and emits each block row by
+ * row through a bit-matrix transpose, so the output is ascending without a
+ * global sort. Use `SiZm_vy` when order does not matter (e.g. counting).
+ *
+ * @param n Upper bound (inclusive).
+ * @return Heap-allocated prime list (ascending), or NULL on allocation failure.
+ * @pre n <= 10^12.
+ */
+UI64_ARRAY *SiZm_vy_ordered(uint64_t n);
+
 ///@}
 
 /** @name SiZ Range Variants
@@ -132,11 +171,13 @@ UI64_ARRAY *SiZm_vy(uint64_t n);
  */
 typedef struct INPUT_SIEVE_RANGE
 {
-    char *start;     ///< Start of range as a base-10 numeric string.
-    uint64_t range;  ///< Interval size (number of integers to cover).
-    int mr_rounds;   ///< Miller–Rabin rounds for large primality checks.
-    char *filepath;  ///< Output path for streaming primes (NULL to disable output).
-    int stream_gaps; ///< Non-zero streams prime gaps instead of absolute primes.
+    char *start;          ///< Start of range as a base-10 numeric string.
+    uint64_t range;       ///< Interval size (number of integers to cover).
+    int mr_rounds;        ///< Miller–Rabin rounds for primality checks at 2^128 and above.
+    char *filepath;       ///< Output path for streaming primes (NULL to disable output).
+    int stream_gaps;      ///< Non-zero streams prime gaps instead of absolute primes.
+    int primality;        ///< Primality backend at 2^128 and above (@ref IZ_PRIMALITY_BACKEND; 0 = Miller–Rabin); smaller ranges use the exact 64-bit and native BPSW tests.
+    uint64_t sieve_depth; ///< Largest sieving prime before primality tests (0 = automatic up to 2^22, ~10 MB; explicit depths capped at 2^26, ~125 MB per worker).
 } INPUT_SIEVE_RANGE;
 
 /**
@@ -165,7 +206,7 @@ uint64_t SiZ_count(INPUT_SIEVE_RANGE *input_range, int cores_num);
  * @brief Search for a random prime using vertical (vy) sieving.
  * @param p Output prime (initialized by caller).
  * @param bit_size Target size of @p p in bits.
- * @param cores_num Requested worker processes.
+ * @param cores_num Requested worker threads (the first to find a prime cancels the others).
  * @return 1 on success, 0 on failure.
  */
 int vy_random_prime(mpz_t p, int bit_size, int cores_num);
@@ -174,11 +215,45 @@ int vy_random_prime(mpz_t p, int bit_size, int cores_num);
  * @brief Search for a random prime using horizontal (vx) sieving.
  * @param p Output prime (initialized by caller).
  * @param bit_size Target size of @p p in bits.
- * @param cores_num Requested worker processes.
+ * @param cores_num Requested worker threads (the first to find a prime cancels the others).
  * @return 1 on success, 0 on failure.
  */
 int vx_random_prime(mpz_t p, int bit_size, int cores_num);
 
+/**
+ * @brief Search for a random prime meeting a constraint spec (top bits, residue class, gcd(p - 1, e) = 1).
+ * @param p Output prime (initialized by caller).
+ * @param bit_size Target size of @p p in bits.
+ * @param cons Constraints (NULL for none); see @ref IZ_PRIME_CONSTRAINTS.
+ * @param cores_num Requested worker threads (the first to find a prime cancels the others).
+ * @return 1 on success, 0 on failure or unsatisfiable constraints.
+ */
+int vx_random_prime_constrained(mpz_t p, int bit_size, const IZ_PRIME_CONSTRAINTS *cons, int cores_num);
+
+/**
+ * @brief Search for a random safe prime p = 2s + 1 (s a Sophie Germain prime) using joint vx sieving.
+ * @param p Output safe prime (initialized by caller); (p - 1) / 2 is its Sophie Germain prime.
+ * @param bit_size Target size of @p p in bits.
+ * @param cores_num Requested worker threads (the first to find a safe prime cancels the others).
+ * @return 1 on success, 0 on failure.
+ */
+int vx_random_safe_prime(mpz_t p, int bit_size, int cores_num);
+
+/** Smallest bit size accepted by iZ_random_primes(): the search starts past the
+ *  first VX5 segment, whose primes already reach 12 * VX5 < 2^20. */
+#define IZ_RANDOM_PRIMES_MIN_BITS 20
+
+/**
+ * @brief Generate a batch of random primes, sharing the search setup across the batch.
+ * @param out Array of @p count initialized mpz_t values receiving the primes.
+ * @param count Number of primes to generate.
+ * @param bit_size Target size of each prime in bits (>= @ref IZ_RANDOM_PRIMES_MIN_BITS).
+ * @param threads Worker threads kept alive for the whole batch (capped at @p count and 256).
+ * @param primes_per_sec Optional output: generation throughput (may be NULL).
+ * @return Number of primes generated (@p count on success, 0 on invalid input).
+ */
+int iZ_random_primes(mpz_t *out, int count, int bit_size, int threads, double *primes_per_sec);
+
 /**
  * @brief Advance to the next (or previous) prime from a base value.
  * @param p Output prime (initialized by caller).
@@ -188,6 +263,17 @@ int vx_random_prime(mpz_t p, int bit_size, int cores_num);
  */
 int iZ_next_prime(mpz_t p, mpz_t base, int forward);
 
+/**
+ * @brief Advance every base of a batch to its next (or previous) prime, sharing the window sieve tables.
+ * @param out Array of @p count initialized mpz_t values; out[i] receives the prime of bases[i].
+ * @param bases Array of @p count starting values.
+ * @param count Number of bases.
+ * @param forward Non-zero to search forward, 0 to search backward.
+ * @param threads Worker threads kept alive for the whole batch (capped at @p count).
+ * @return Number of bases resolved (@p count on success).
+ */
+int iZ_next_prime_batch(mpz_t *out, mpz_t *bases, int count, int forward, int threads);
+
 ///@}
 
 /** @} */
@@ -56,12 +56,97 @@ void process_iZ_bitmaps(UI64_ARRAY *primes, BITMAP *x5, BITMAP *x7, uint64_t x_l
 void get_root_primes(UI64_ARRAY *primes, uint64_t limit);
 
 /**
- * @brief Check the primality of a number using GMP's probabilistic test.
+ * @brief Primality test backends selectable per call via test_primality_with().
+ */
+typedef enum
+{
+    IZ_PRIMALITY_MR = 0,   /**< GMP mpz_probab_prime_p with the given Miller-Rabin rounds (default). */
+    IZ_PRIMALITY_BPSW = 1, /**< Baillie-PSW: strong base-2 test plus strong Lucas test; rounds are ignored. */
+} IZ_PRIMALITY_BACKEND;
+
+/**
+ * @brief Check the primality of a number.
+ *
+ * Numbers below 2^128 take the GMP-free test_primality_u64() and
+ * test_primality_u128() paths, which do not use @p rounds.
+ *
  * @param n Number to check.
- * @param rounds Number of Miller-Rabin rounds.
+ * @param rounds Number of Miller-Rabin rounds for larger numbers.
  * @return Non-zero if probably prime, 0 if composite.
  */
 int test_primality(mpz_t n, int rounds);
+
+/**
+ * @brief Check the primality of a number with an explicit backend.
+ *
+ * @ref IZ_PRIMALITY_MR always runs GMP's test with @p rounds. With
+ * @ref IZ_PRIMALITY_BPSW, numbers below 2^64 are decided exactly by
+ * test_primality_u64(), and numbers below 2^128 by test_primality_u128().
+ *
+ * @param n Number to check.
+ * @param rounds Miller-Rabin rounds (used by @ref IZ_PRIMALITY_MR only).
+ * @param backend Primality backend.
+ * @return 2 if definitely prime, 1 if probably prime, 0 if composite.
+ */
+int test_primality_with(mpz_t n, int rounds, IZ_PRIMALITY_BACKEND backend);
+
+/**
+ * @brief Baillie-PSW probable-prime test.
+ *
+ * Small-prime trial division, a strong Fermat test to base 2, then a strong
+ * Lucas test with Selfridge parameters. No composite is known to pass.
+ *
+ * @param n Number to check.
+ * @return 2 if definitely prime (small n), 1 if probably prime, 0 if composite.
+ */
+int test_bpsw(mpz_t n);
+
+/**
+ * @brief Deterministic primality test for 64-bit integers.
+ *
+ * Strong probable-prime tests to the seven bases of Sinclair's set, which
+ * has no 64-bit strong pseudoprime, run in Montgomery form without GMP.
+ *
+ * @param n Number to check.
+ * @return 1 if prime, 0 otherwise.
+ */
+int test_primality_u64(uint64_t n);
+
+/**
+ * @brief Deterministic primality of many 64-bit integers at once.
+ *
+ * Same answers as test_primality_u64(), but base by base across the batch
+ * (base-2 survivors only take the remaining bases) with independent
+ * exponentiations in SIMD lanes (CPUs with AVX-512 IFMA) or interleaved scalar
+ * chains.
+ *
+ * @param n Input values.
+ * @param count Number of values.
+ * @param is_prime Output flags, 1 where the value is prime.
+ * @return Number of primes in @p n.
+ */
+int test_primality_u64_batch(const uint64_t *n, int count, uint8_t *is_prime);
+
+/**
+ * @brief Keep test_primality_u64_batch() on its interleaved scalar lanes, even on IFMA CPUs.
+ *
+ * Test hook so one host can check both lane paths; set it while no batch runs.
+ *
+ * @param force Non-zero for the scalar lanes, 0 to follow the CPU again.
+ */
+void test_primality_u64_batch_force_scalar(int force);
+
+/**
+ * @brief Baillie-PSW test for integers below 2^128, without GMP.
+ *
+ * Strong base-2 and strong Lucas (Selfridge) tests in two-limb Montgomery
+ * arithmetic; values below 2^64 are handed to test_primality_u64().
+ *
+ * @param hi High 64 bits of n.
+ * @param lo Low 64 bits of n.
+ * @return 1 if probably prime (prime when @p hi is 0), 0 otherwise.
+ */
+int test_primality_u128(uint64_t hi, uint64_t lo);
 /** @} */
 
 /** @name Standard VX Sizes (primorial products excluding 2,3) */
@@ -78,6 +163,40 @@ int test_primality(mpz_t n, int rounds);
 /** Default Miller-Rabin rounds used by toolkit search/sieve helpers. */
 #define MR_ROUNDS 25
 
+/** Largest root prime cleared through word-level BITMAP_PATTERN masks. */
+#define IZM_PATTERN_LIMIT 127
+
+/**
+ * Upper bound on the deterministic sieving depth (tracked primes must fit 32 bits).
+ * A state to depth B holds about 32 bytes per prime, ~32 B / ln(B) in total:
+ * ~10 MB at 2^22, ~125 MB at 2^26 and ~6.5 GB at 2^32.
+ */
+#define IZ_SIEVE_DEPTH_MAX (1ULL << 32)
+/** Upper bound of iZ_auto_sieve_depth(); keeps an automatic sieving state near 10 MB. */
+#define IZ_SIEVE_DEPTH_AUTO_MAX (1ULL << 22)
+/** Upper bound of explicit range sieving depths; each range worker then holds up to ~125 MB of offsets. */
+#define IZ_SIEVE_DEPTH_RANGE_MAX (1ULL << 26)
+
+/**
+ * @brief Per-prime constants of the iZm hit solvers, as a structure of arrays.
+ *
+ * Solving a prime's first hit needs its iZ index x_p, its line, vx mod p and,
+ * for vertical lanes, vx^-1 mod p. Computing these per call costs a gcd and a
+ * modular inversion per prime and lane; the table computes them once for a
+ * fixed vx, together with a reciprocal that replaces `% p` by a multiply.
+ */
+typedef struct
+{
+    int count;        /**< Number of primes. */
+    uint64_t vx;      /**< Segment width the residues refer to. */
+    uint32_t *p;      /**< Primes (< 2^32). */
+    uint32_t *xp;     /**< iZ index of p: (p + 1) / 6. */
+    int8_t *ip;       /**< iZ line of p: -1 (6x-1) or +1 (6x+1). */
+    uint32_t *vx_mod; /**< vx mod p. */
+    uint32_t *vx_inv; /**< vx^-1 mod p, or 0 when p divides vx. */
+    uint64_t *p_rcp;  /**< floor((2^64 - 1) / p), for Barrett reduction. */
+} IZM_ROOTS;
+
 /**
  * @brief Precomputed iZm assets for repeated VX-segment sieving.
  */
@@ -88,6 +207,8 @@ typedef struct
     BITMAP *base_x5;         /**< Pre-sieved base bitmap for 6x-1 line. */
     BITMAP *base_x7;         /**< Pre-sieved base bitmap for 6x+1 line. */
     UI64_ARRAY *root_primes; /**< Root primes used for deterministic marking. */
+    IZM_ROOTS *roots;        /**< Solver constants, index-aligned with @ref root_primes. */
+    BITMAP_PATTERN *pattern; /**< Word masks for root primes past the wheel, up to @ref IZM_PATTERN_LIMIT. */
 } IZM;
 
 /** @name IZM Lifecycle */
@@ -145,6 +266,18 @@ void compute_max_vx(mpz_t vx, int bit_size);
  */
 void iZm_construct_vx_base(uint64_t vx, BITMAP *base_x5, BITMAP *base_x7);
 
+/**
+ * @brief Build word-level clearing masks for small root primes past the wheel.
+ *
+ * Covers @p primes[@p k ..] up to @ref IZM_PATTERN_LIMIT (at most
+ * @ref BITMAP_PATTERN_MAX_COUNT primes). Masks are shared by both iZ lines.
+ *
+ * @param primes Ascending prime list.
+ * @param k Index of the first prime not folded into the vx wheel.
+ * @return Pattern object (possibly empty), or NULL on allocation failure.
+ */
+BITMAP_PATTERN *iZm_construct_pattern(UI64_ARRAY *primes, int k);
+
 /** @name Modular Hit Solvers */
 /** @{ */
 /**
@@ -178,25 +311,241 @@ uint64_t iZm_solve_for_x0_mpz(int m_id, uint64_t p, uint64_t vx, mpz_t y);
 int64_t iZm_solve_for_y0(int m_id, uint64_t p, uint64_t vx, uint64_t x);
 /** @} */
 
+/** @name Root Prime Tables */
+/** @{ */
+/**
+ * @brief Build solver constants for @p count primes and segment width @p vx.
+ * @param primes Primes (< 2^32); 2 and 3 are accepted but never solved for.
+ * @param count Number of primes.
+ * @param vx Segment width.
+ * @return Table, or NULL on allocation failure.
+ */
+IZM_ROOTS *iZm_roots_init(const uint64_t *primes, int count, uint64_t vx);
+
+/**
+ * @brief Deep-copy a root prime table.
+ * @param src Source table.
+ * @return Copy, or NULL on allocation failure.
+ */
+IZM_ROOTS *iZm_roots_clone(const IZM_ROOTS *src);
+
+/**
+ * @brief Release a root prime table and set the caller pointer to NULL.
+ * @param roots Address of a table pointer.
+ */
+void iZm_roots_free(IZM_ROOTS **roots);
+
+/**
+ * @brief Reduce @p a modulo the prime at index @p i (Barrett reduction).
+ * @param roots Root prime table.
+ * @param i Prime index.
+ * @param a Any 64-bit value.
+ * @return a mod p.
+ */
+uint64_t iZm_roots_mod(const IZM_ROOTS *roots, int i, uint64_t a);
+
+/**
+ * @brief Table-driven iZm_solve_for_x0() for the prime at index @p i.
+ * @param roots Root prime table (its vx is the segment width).
+ * @param i Prime index.
+ * @param m_id Line id (-1 for x5, +1 for x7).
+ * @param y Segment index.
+ * @return First x index to clear, as iZm_solve_for_x0() (0 when p > vx misses segment y).
+ */
+uint64_t iZm_roots_solve_for_x0(const IZM_ROOTS *roots, int i, int m_id, uint64_t y);
+
+/**
+ * @brief Table-driven iZm_solve_for_y0() for the prime at index @p i.
+ * @param roots Root prime table (its vx is the lane stride).
+ * @param i Prime index.
+ * @param m_id Line id (-1 for x5, +1 for x7).
+ * @param x Fixed x-coordinate.
+ * @return y index in [0, p), or -1 when p divides vx.
+ */
+int64_t iZm_roots_solve_for_y0(const IZM_ROOTS *roots, int i, int m_id, uint64_t x);
+/** @} */
+
+/**
+ * @brief Bucket sieve for root primes larger than the segment width.
+ *
+ * A root prime p > vx hits a VX segment at most once per line, so solving its
+ * first hit in every segment wastes a modulo on mostly empty work. Instead,
+ * each prime is parked in the bucket of the segment it hits next (a ring of
+ * buckets indexed relative to the current segment) and only touched when that
+ * segment is sieved, after which it is moved to the bucket of its following hit.
+ */
+typedef struct
+{
+    int vx;          /**< Segment width. */
+    int count;       /**< Number of buckets in the ring. */
+    int current;     /**< Ring index of the segment sieved next. */
+    UI64_ARRAY **x5; /**< Per-bucket hits on the 6x-1 line, packed as (p << 32) | x. */
+    UI64_ARRAY **x7; /**< Per-bucket hits on the 6x+1 line, packed as (p << 32) | x. */
+} VX_BUCKETS;
+
+/** @name Bucket Sieve */
+/** @{ */
+/**
+ * @brief Allocate a bucket ring for root primes up to @p max_prime.
+ * @param vx Segment width.
+ * @param max_prime Largest prime that will be added (must be < 2^32).
+ * @return Initialized bucket ring, or NULL on failure.
+ */
+VX_BUCKETS *vx_buckets_init(int vx, uint64_t max_prime);
+
+/**
+ * @brief Free a bucket ring and set the caller pointer to NULL.
+ * @param buckets Address of a VX_BUCKETS pointer.
+ */
+void vx_buckets_free(VX_BUCKETS **buckets);
+
+/**
+ * @brief Park prime @p p at its next hit on both lines.
+ *
+ * Hits are x offsets relative to the start of the segment sieved next
+ * (x = 1 is its first column); offsets beyond vx land in later segments.
+ *
+ * @param buckets Bucket ring.
+ * @param p Prime (< 2^32).
+ * @param x5_hit Next hit on the 6x-1 line.
+ * @param x7_hit Next hit on the 6x+1 line.
+ */
+void vx_buckets_add(VX_BUCKETS *buckets, uint64_t p, uint64_t x5_hit, uint64_t x7_hit);
+
+/**
+ * @brief Clear this segment's bucket hits in @p x5 / @p x7 and advance to the next segment.
+ * @param buckets Bucket ring.
+ * @param x5 Candidate bitmap for 6x-1.
+ * @param x7 Candidate bitmap for 6x+1.
+ * @param end_x Inclusive last x to clear in this segment.
+ */
+void vx_buckets_sieve(VX_BUCKETS *buckets, BITMAP *x5, BITMAP *x7, int end_x);
+/** @} */
+
+/**
+ * @brief Per-prime next-hit offsets carried across consecutive VX segments.
+ *
+ * Solving the first hit of every root prime costs a modulo per prime (an mpz
+ * multiply and modulo once y exceeds 64 bits). Consecutive segments shift every
+ * hit by the same vx, so after one solve each offset advances by a subtraction
+ * of the cached vx mod p. Solves for multi-word y reduce y once per group of
+ * primes packed into a machine word, instead of once per prime.
+ */
+typedef struct
+{
+    int vx;                /**< Segment width. */
+    int k;                 /**< Index of the first tracked root prime in IZM::root_primes. */
+    int count;             /**< Number of tracked root primes. */
+    int deep_start;        /**< Index of the first tracked prime above vx (== count when none). */
+    uint64_t depth;        /**< Sieving depth: every prime up to depth is tracked (at least vx). */
+    int synced;            /**< Non-zero once offsets have been solved for @ref y. */
+    mpz_t y;               /**< Segment the offsets refer to. */
+    uint32_t *primes;      /**< Tracked root primes (past 2, 3 and the wheel primes). */
+    uint32_t *vx_mod;      /**< vx mod p per tracked prime. */
+    uint32_t *y_mod;       /**< y mod p per tracked prime, cached by the last solve. */
+    uint32_t *x5_next;     /**< First hit in segment @ref y on the 6x-1 line, in [1, p]. */
+    uint32_t *x7_next;     /**< First hit in segment @ref y on the 6x+1 line, in [1, p]. */
+    int group_count;       /**< Number of multi-prime moduli. */
+    unsigned long *moduli; /**< Products of consecutive tracked primes, each fitting one word. */
+    int *group_end;        /**< Exclusive end index (into @ref primes) of each modulus group. */
+} VX_SIEVE_STATE;
+
+/** @name VX Sieving State */
+/** @{ */
+/**
+ * @brief Allocate a sieving state tracking the root primes of @p iZm.
+ * @param iZm Initialized toolkit context.
+ * @return Unsynced state, or NULL on allocation failure.
+ */
+VX_SIEVE_STATE *vx_state_init(IZM *iZm);
+
+/**
+ * @brief Allocate a sieving state tracking every prime up to @p depth.
+ *
+ * Primes above vx hit a segment at most once per line, so they extend the
+ * deterministic phase past the root primes of @p iZm at one offset update
+ * per prime and segment.
+ *
+ * @param iZm Initialized toolkit context.
+ * @param depth Sieving depth, at most @ref IZ_SIEVE_DEPTH_MAX (values <= vx track the root primes only).
+ * @return Unsynced state, or NULL on allocation failure.
+ */
+VX_SIEVE_STATE *vx_state_init_depth(IZM *iZm, uint64_t depth);
+
+/**
+ * @brief Copy a sieving state, offsets and sync point included.
+ *
+ * Cheaper than vx_state_init_depth() for deep states, which generate their
+ * primes: a state built once can be cloned per worker or per query.
+ *
+ * @param src Source state.
+ * @return Independent copy, or NULL on allocation failure.
+ */
+VX_SIEVE_STATE *vx_state_clone(const VX_SIEVE_STATE *src);
+
+/**
+ * @brief Free a sieving state and set the caller pointer to NULL.
+ * @param state Address of a VX_SIEVE_STATE pointer.
+ */
+void vx_state_free(VX_SIEVE_STATE **state);
+
+/**
+ * @brief Point @p state at segment @p y, solving offsets only when it is not already there.
+ * @param state Sieving state.
+ * @param y Segment index (must be > 0).
+ */
+void vx_state_sync(VX_SIEVE_STATE *state, mpz_t y);
+
+/**
+ * @brief Move all offsets to the following segment (y + 1).
+ * @param state Synced sieving state.
+ */
+void vx_state_advance(VX_SIEVE_STATE *state);
+
+/**
+ * @brief Choose a sieving depth balancing sieve cost against primality-test cost.
+ *
+ * Sieving to depth B leaves about 1.68 / ln(B) of the 6x +/- 1 candidates, so
+ * the last primes added around B each remove ~1.68 N / (B ln B) of N candidates
+ * while costing one offset update per segment plus their generation. The
+ * break-even B is solved against a Miller-Rabin cost model in @p bit_size.
+ *
+ * @param vx Segment width.
+ * @param bit_size Bit size of the largest number to sieve.
+ * @param x_span Number of x columns one worker sieves (0 = one full segment).
+ * @return Depth in [vx, @ref IZ_SIEVE_DEPTH_AUTO_MAX], or vx when deeper sieving does not pay off.
+ */
+uint64_t iZ_auto_sieve_depth(int vx, int bit_size, uint64_t x_span);
+/** @} */
+
 /**
  * @brief Runtime state for one VX segment at a specific y.
  */
 typedef struct
 {
-    int vx;             /**< Segment width. */
-    mpz_t y;            /**< Segment index y. */
-    mpz_t yvx;          /**< Cached product y*vx. */
-    mpz_t root_limit;   /**< sqrt(iZ(yvx + vx, +1)). */
-    int is_large_limit; /**< Non-zero => requires probabilistic primality checks. */
-    int mr_rounds;      /**< Miller-Rabin rounds when probabilistic checks are used. */
-    int start_x;        /**< Inclusive start x for this segment. */
-    int end_x;          /**< Inclusive end x for this segment. */
-    BITMAP *x5;         /**< Candidate bitmap for 6x-1. */
-    BITMAP *x7;         /**< Candidate bitmap for 6x+1. */
-    int p_count;        /**< Count of primes found in this segment. */
-    UI16_ARRAY *p_gaps; /**< Optional prime-gap encoding for streamed output. */
-    int bit_ops;        /**< Approximate deterministic mark operations. */
-    int p_test_ops;     /**< Probabilistic primality tests executed. */
+    int vx;                /**< Segment width. */
+    mpz_t y;               /**< Segment index y. */
+    mpz_t yvx;             /**< Cached product y*vx. */
+    mpz_t root_limit;      /**< sqrt(iZ(yvx + vx, +1)). */
+    int is_large_limit;    /**< Non-zero => requires probabilistic primality checks. */
+    int is_u64;            /**< Non-zero when every candidate fits 64 bits (GMP-free checks). */
+    uint64_t yvx_u64;      /**< y*vx as a machine word, valid when @ref is_u64 is set. */
+    int is_u128;           /**< Non-zero when every candidate fits 128 bits (GMP-free checks). */
+    uint64_t yvx_u128[2];  /**< y*vx as {low, high} words, valid when @ref is_u128 is set. */
+    uint64_t sieve_depth;  /**< Largest prime bound applied by the deterministic phase. */
+    int mr_rounds;         /**< Miller-Rabin rounds when probabilistic checks are used (ignored while @ref is_u128 is set). */
+    int primality;         /**< @ref IZ_PRIMALITY_BACKEND of probabilistic checks; ignored while @ref is_u128 is set, where
+                                candidates always take test_primality_u64() or the native BPSW test_primality_u128(). */
+    int start_x;           /**< Inclusive start x for this segment. */
+    int end_x;             /**< Inclusive end x for this segment. */
+    BITMAP *x5;            /**< Candidate bitmap for 6x-1. */
+    BITMAP *x7;            /**< Candidate bitmap for 6x+1. */
+    int p_count;           /**< Count of primes found in this segment. */
+    UI16_ARRAY *p_gaps;    /**< Optional prime-gap encoding for streamed output. */
+    int bit_ops;           /**< Approximate deterministic mark operations. */
+    int p_test_ops;        /**< Probabilistic primality tests executed. */
+    IZM *iZm;              /**< Borrowed toolkit context (set by vx_create(), otherwise NULL). */
+    VX_SIEVE_STATE *state; /**< Owned sieving state (set by vx_create(), or cached by multi-word one-shot segments). */
 } VX_SEG;
 
 /** @name VX Segment Lifecycle and Execution */
@@ -212,6 +561,70 @@ typedef struct
  */
 VX_SEG *vx_init(IZM *iZm, int start_x, int end_x, char *y_str, int mr_rounds);
 
+/**
+ * @brief Like vx_init(), but take root-prime offsets from @p state.
+ *
+ * The state is synced to y (solving offsets only on a jump) and advanced to
+ * y + 1 afterwards, so consecutive calls skip the per-prime modular solve.
+ *
+ * @param iZm Initialized toolkit context.
+ * @param state Sieving state built from @p iZm, or NULL to solve offsets directly.
+ * @param start_x Inclusive x start index.
+ * @param end_x Inclusive x end index.
+ * @param y_str Segment index y as a decimal string.
+ * @param mr_rounds Miller-Rabin rounds (0 uses default).
+ * @return Initialized and partially processed segment, or NULL on failure.
+ */
+VX_SEG *vx_init_with_state(IZM *iZm, VX_SIEVE_STATE *state, int start_x, int end_x, char *y_str, int mr_rounds);
+
+/**
+ * @brief Allocate a long-lived VX segment for re-use across many segments.
+ * @param iZm Initialized toolkit context; must outlive the segment.
+ * @param mr_rounds Miller-Rabin rounds (0 uses default).
+ * @return Unsieved segment to be targeted with vx_reset(), or NULL on failure.
+ */
+VX_SEG *vx_create(IZM *iZm, int mr_rounds);
+
+/**
+ * @brief Rebuild the owned sieving state of a vx_create() segment to sieve up to @p depth.
+ *
+ * Takes effect from the next vx_reset(). Segments whose root limit stays within
+ * @p depth are sieved fully deterministically. The segment owns about 32 bytes
+ * per prime up to @p depth (~10 MB at 2^22, ~125 MB at 2^26, ~6.5 GB at 2^32),
+ * plus ~12 bytes per prime transiently while the primes are generated.
+ *
+ * @param vx_obj Segment created by vx_create().
+ * @param depth Sieving depth (see vx_state_init_depth()).
+ * @return 1 on success, 0 on invalid depth or allocation failure (the segment is unchanged).
+ */
+int vx_set_sieve_depth(VX_SEG *vx_obj, uint64_t depth);
+
+/**
+ * @brief Hand a prepared sieving state to a long-lived VX_SEG, which takes ownership.
+ *
+ * Lets one deep state, built once, serve a segment without regenerating its
+ * primes (forked workers adopt their copy-on-write copy of the parent's state).
+ *
+ * @param vx_obj Segment created by vx_create().
+ * @param state State built for the same IZM layout; freed with the segment.
+ * @return 1 on success, 0 when @p state does not match the segment (ownership stays with the caller).
+ */
+int vx_set_sieve_state(VX_SEG *vx_obj, VX_SIEVE_STATE *state);
+
+/**
+ * @brief Re-target a segment from vx_create() at @p y and sieve it deterministically.
+ *
+ * Reuses the existing bitmaps and mpz fields; consecutive y values also reuse
+ * the carried root-prime offsets.
+ *
+ * @param vx_obj Segment created by vx_create().
+ * @param y Segment index y.
+ * @param start_x Inclusive x start index.
+ * @param end_x Inclusive x end index.
+ * @return 1 on success, 0 on invalid input.
+ */
+int vx_reset(VX_SEG *vx_obj, mpz_t y, int start_x, int end_x);
+
 /**
  * @brief Free a VX segment and all owned resources.
  * @param vx_obj Address of a VX_SEG pointer.
@@ -226,6 +639,11 @@ void vx_collect_p_gaps(VX_SEG *vx_obj);
 
 /**
  * @brief Complete segment processing (probabilistic stage and optional gaps).
+ *
+ * Segments below 2^128 (@ref VX_SEG::is_u128) test survivors with
+ * test_primality_u64() and test_primality_u128() whatever the segment's
+ * @ref VX_SEG::primality and @ref VX_SEG::mr_rounds; larger segments use them.
+ *
  * @param vx_obj Segment object.
  * @param collect_p_gaps Non-zero to populate @ref VX_SEG::p_gaps.
  */
@@ -233,6 +651,10 @@ void vx_full_sieve(VX_SEG *vx_obj, int collect_p_gaps);
 
 /**
  * @brief Stream segment primes to an output stream.
+ *
+ * Survivors are tested as in vx_full_sieve(), so @ref VX_SEG::primality only
+ * applies to segments at 2^128 and above.
+ *
  * @param vx_obj Segment object.
  * @param output Writable output stream (e.g. stdout or a file).
  * @param stream_gaps Non-zero to stream prime gaps instead of absolute primes.
@@ -275,8 +697,74 @@ IZM_RANGE_INFO range_info_init(INPUT_SIEVE_RANGE *input_range, int vx);
 /** @brief Clear all GMP fields owned by @p info. */
 void range_info_free(IZM_RANGE_INFO *info);
 
+/**
+ * @brief Reusable state for repeated vx_search_prime() calls with one vx.
+ *
+ * Holds the IZM assets (root primes, pre-sieved bases, word patterns), the
+ * carried root-prime offsets, one candidate bitmap and its own random state, so a search only solves
+ * its random starting segment once and every following segment costs an
+ * offset update per root prime. Opaque; the fields live in iZ_toolkit.c.
+ */
+typedef struct VX_SEARCH_CTX VX_SEARCH_CTX;
+
+/**
+ * @brief Constraints applied up front by vx_search_prime_constrained().
+ *
+ * Zero-initialize for no constraint. Residue and exponent conditions are
+ * folded into the line, x-progression and sieve of the search, and the top
+ * bits into the random start, so no prime is generated only to be rejected.
+ */
+typedef struct
+{
+    int top_bits;     /**< Leading bits of p forced to 1 (2 for RSA); 0 keeps p below 2^bit_size only. */
+    uint64_t modulus; /**< Require p = @ref residue (mod modulus), modulus < 2^32; 0 or 1 for none. */
+    uint64_t residue; /**< Required residue of p modulo @ref modulus. */
+    uint64_t e;       /**< Require gcd(p - 1, e) = 1 for this odd e < 2^32; 0 or 1 for none. */
+} IZ_PRIME_CONSTRAINTS;
+
 /** @name Random Prime Search Routines */
 /** @{ */
+/**
+ * @brief Allocate a reusable vx_search_prime() context.
+ * @param vx Segment width.
+ * @return Initialized context, or NULL on failure.
+ */
+VX_SEARCH_CTX *vx_search_ctx_init(int vx);
+
+/**
+ * @brief Allocate a search context over a caller-owned IZM.
+ *
+ * The IZM is only read by searches, so one instance can back the contexts of
+ * several threads; it must outlive them and is not freed with them.
+ *
+ * @param iZm Initialized toolkit context.
+ * @return Initialized context, or NULL on failure.
+ */
+VX_SEARCH_CTX *vx_search_ctx_init_with_iZm(IZM *iZm);
+
+/**
+ * @brief Free a search context and set the caller pointer to NULL.
+ * @param ctx Address of a VX_SEARCH_CTX pointer.
+ */
+void vx_search_ctx_free(VX_SEARCH_CTX **ctx);
+
+/**
+ * @brief Attach a cancel flag that searches with @p ctx check between candidates.
+ * @param ctx Search context from vx_search_ctx_init().
+ * @param stop Address of an `atomic_int` raised to cancel (NULL: search until found).
+ */
+void vx_search_ctx_set_stop(VX_SEARCH_CTX *ctx, void *stop);
+
+/**
+ * @brief Horizontal iZm/VX random-prime search reusing @p ctx.
+ * @param ctx Search context from vx_search_ctx_init().
+ * @param p Output prime.
+ * @param m_id Requested line id (-1, +1, or random when other value).
+ * @param bit_size Target bit size.
+ * @return 1 on success, 0 on failure or when the vx_search_ctx_set_stop() flag is raised.
+ */
+int vx_search_prime_ctx(VX_SEARCH_CTX *ctx, mpz_t p, int m_id, int bit_size);
+
 /**
  * @brief Horizontal iZm/VX random-prime search.
  * @param p Output prime.
@@ -287,6 +775,29 @@ void range_info_free(IZM_RANGE_INFO *info);
  */
 int vx_search_prime(mpz_t p, int m_id, int vx, int bit_size);
 
+/**
+ * @brief Horizontal iZm/VX random-prime search satisfying @p cons.
+ * @param ctx Search context from vx_search_ctx_init().
+ * @param p Output prime.
+ * @param bit_size Target bit size.
+ * @param cons Constraints (NULL for none).
+ * @return 1 on success, 0 when @p cons cannot be met, on failure, or when the vx_search_ctx_set_stop() flag is raised.
+ */
+int vx_search_prime_constrained(VX_SEARCH_CTX *ctx, mpz_t p, int bit_size, const IZ_PRIME_CONSTRAINTS *cons);
+
+/**
+ * @brief Horizontal iZm/VX random safe-prime search reusing @p ctx.
+ *
+ * Sieves the Sophie Germain candidate s and 2s + 1 together, so @p p = 2s + 1
+ * is a safe prime and (p - 1) / 2 its Sophie Germain prime.
+ *
+ * @param ctx Search context from vx_search_ctx_init().
+ * @param p Output safe prime.
+ * @param bit_size Target bit size of @p p.
+ * @return 1 on success, 0 on failure or when the vx_search_ctx_set_stop() flag is raised.
+ */
+int vx_search_safe_prime_ctx(VX_SEARCH_CTX *ctx, mpz_t p, int bit_size);
+
 /**
  * @brief Vertical iZm/VY random-prime search.
  * @param p Output prime.
@@ -295,6 +806,16 @@ int vx_search_prime(mpz_t p, int m_id, int vx, int bit_size);
  * @return 1 on success, otherwise 0.
  */
 int vy_search_prime(mpz_t p, int m_id, mpz_t vx);
+
+/**
+ * @brief Vertical iZm/VY random-prime search that gives up once @p stop is raised.
+ * @param p Output prime.
+ * @param m_id Requested line id (-1, +1, or random when other value).
+ * @param vx Segment width.
+ * @param stop Address of an `atomic_int` cancel flag checked between candidates (NULL: search until found).
+ * @return 1 on success, 0 when cancelled.
+ */
+int vy_search_prime_until(mpz_t p, int m_id, mpz_t vx, void *stop);
 /** @} */
 
 /** @name Toolkit Tests */
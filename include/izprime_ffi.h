@@ -74,6 +74,17 @@ typedef struct
     size_t len;     /**< Number of entries in @p data. */
 } IZP_U64_BUFFER;
 
+/**
+ * @brief Owned array of decimal strings returned by FFI batch routines.
+ *
+ * Caller must release with @ref izp_ffi_free_str_buffer.
+ */
+typedef struct
+{
+    char **data; /**< Heap-allocated NUL-terminated decimal strings. */
+    size_t len;  /**< Number of entries in @p data. */
+} IZP_STR_BUFFER;
+
 /** @brief Return the iZprime semantic version string. */
 IZP_FFI_API const char *izp_ffi_version(void);
 
@@ -140,10 +151,20 @@ IZP_FFI_API int izp_ffi_stream_range(const char *start, uint64_t range, int mr_r
  */
 IZP_FFI_API int izp_ffi_next_prime(const char *base_expr, int forward, char **out_prime_base10);
 
+/**
+ * @brief Find the next/previous prime of every base in a batch, sharing sieve tables across bases.
+ * @param base_exprs Array of @p count base numeric expressions.
+ * @param count Number of bases (1 to INT_MAX).
+ * @param forward Non-zero for next primes, zero for previous primes.
+ * @param threads Requested worker-thread count (capped at @p count).
+ * @param out Buffer receiving @p count decimal strings in input order (caller frees via @ref izp_ffi_free_str_buffer).
+ */
+IZP_FFI_API int izp_ffi_next_prime_batch(const char *const *base_exprs, size_t count, int forward, int threads, IZP_STR_BUFFER *out);
+
 /**
  * @brief Generate a random prime using vx-based search.
  * @param bit_size Target prime bit length.
- * @param cores_num Requested worker-process count.
+ * @param cores_num Requested worker-thread count.
  * @param out_prime_base10 Receives heap-allocated decimal string.
  */
 IZP_FFI_API int izp_ffi_random_prime_vx(int bit_size, int cores_num, char **out_prime_base10);
@@ -151,11 +172,21 @@ IZP_FFI_API int izp_ffi_random_prime_vx(int bit_size, int cores_num, char **out_
 /**
  * @brief Generate a random prime using vy-based search.
  * @param bit_size Target prime bit length.
- * @param cores_num Requested worker-process count.
+ * @param cores_num Requested worker-thread count.
  * @param out_prime_base10 Receives heap-allocated decimal string.
  */
 IZP_FFI_API int izp_ffi_random_prime_vy(int bit_size, int cores_num, char **out_prime_base10);
 
+/**
+ * @brief Generate a batch of random primes with one shared search setup.
+ * @param bit_size Target prime bit length (>= 20).
+ * @param count Number of primes to generate (1 to INT_MAX).
+ * @param threads Requested worker-thread count (capped at @p count and 256).
+ * @param out Buffer receiving @p count decimal strings (caller frees via @ref izp_ffi_free_str_buffer).
+ * @param out_primes_per_sec Optional; receives the batch throughput.
+ */
+IZP_FFI_API int izp_ffi_random_primes(int bit_size, size_t count, int threads, IZP_STR_BUFFER *out, double *out_primes_per_sec);
+
 /**
  * @brief Free a buffer returned by @ref izp_ffi_sieve_u64.
  * @param buffer Address of owned buffer object.
@@ -168,6 +199,12 @@ IZP_FFI_API void izp_ffi_free_u64_buffer(IZP_U64_BUFFER *buffer);
  */
 IZP_FFI_API void izp_ffi_free_string(char **str);
 
+/**
+ * @brief Free a buffer returned by @ref izp_ffi_random_primes or @ref izp_ffi_next_prime_batch.
+ * @param buffer Address of owned buffer object.
+ */
+IZP_FFI_API void izp_ffi_free_str_buffer(IZP_STR_BUFFER *buffer);
+
 /** @} */
 
 #ifdef __cplusplus
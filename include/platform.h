@@ -36,6 +36,15 @@
 #endif
 #endif
 
+// Native 128-bit integers (GCC/Clang on 64-bit targets) for double-word arithmetic
+#if defined(__SIZEOF_INT128__)
+#define IZ_PLATFORM_HAS_INT128 1
+/** Unsigned 128-bit integer (`__extension__` keeps -Wpedantic builds quiet). */
+__extension__ typedef unsigned __int128 iz_uint128_t;
+#else
+#define IZ_PLATFORM_HAS_INT128 0
+#endif
+
 /** @defgroup iz_platform Platform Abstraction
  *  @brief OS-adaptation helpers used by utility and API layers.
  *  @{
@@ -68,6 +77,12 @@ int iz_platform_cpu_cores_count(void);
  */
 int iz_platform_l2_cache_size_bits(void);
 
+/**
+ * @brief Report whether the CPU runs AVX-512 F, DQ and IFMA instructions.
+ * @return 1 if supported, 0 otherwise (including non-x86 targets).
+ */
+int iz_platform_cpu_has_avx512ifma(void);
+
 /**
  * @brief Return a monotonic timestamp in seconds.
  * @return Monotonic seconds.
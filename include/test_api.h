@@ -65,6 +65,14 @@ int TEST_iZ_next_prime(int verbose);
 int TEST_vy_random_prime(int verbose);
 /** @brief Validate `vx_random_prime` for primality and bit-length constraints. */
 int TEST_vx_random_prime(int verbose);
+/** @brief Validate `vx_random_prime_constrained` for every constraint and for unsatisfiable specs. */
+int TEST_vx_random_prime_constrained(int verbose);
+/** @brief Validate `vx_random_safe_prime` for safe-prime and bit-length constraints. */
+int TEST_vx_random_safe_prime(int verbose);
+/** @brief Validate `iZ_random_primes` batches for primality and bit-length constraints. */
+int TEST_iZ_random_primes(int verbose);
+/** @brief Validate `iZ_next_prime_batch` against per-base `iZ_next_prime` calls. */
+int TEST_iZ_next_prime_batch(int verbose);
 
 /** @brief Benchmark random-prime generation routines over repeated trials. */
 int BENCHMARK_P_GEN_ALGORITHMS(int bit_size, int test_rounds, int save_results);
@@ -5,6 +5,7 @@
 
 #include <cli.h>
 #include <iZ_api.h>
+#include <ctype.h>
 #include <inttypes.h>
 #include <limits.h>
 #include <openssl/crypto.h>
@@ -26,6 +27,10 @@ typedef struct
     SIEVE_FN fn;
 } CLI_SIEVE_MODEL;
 
+// threaded models run an explicit worker count, so their threaded paths run on any host
+static UI64_ARRAY *cli_SiZm_mt(uint64_t n) { return SiZm_mt(n, 4); }
+static UI64_ARRAY *cli_SiZm_vy_mt(uint64_t n) { return SiZm_vy_mt(n, 4); }
+
 static const CLI_SIEVE_MODEL k_sieve_models[] = {
     {"SoE", SoE},
     {"SSoE", SSoE},
@@ -34,6 +39,10 @@ static const CLI_SIEVE_MODEL k_sieve_models[] = {
     {"SoA", SoA},
     {"SiZ", SiZ},
     {"SiZm", SiZm},
+    {"SiZm_mt", cli_SiZm_mt},
+    {"SiZm_vy", SiZm_vy},
+    {"SiZm_vy_ordered", SiZm_vy_ordered},
+    {"SiZm_vy_mt", cli_SiZm_vy_mt},
 };
 
 static const size_t k_sieve_models_count = sizeof(k_sieve_models) / sizeof(k_sieve_models[0]);
@@ -78,6 +87,42 @@ static int parse_cores_value(const char *value, int *out)
     return 1;
 }
 
+static int parse_primality_value(const char *value, IZ_PRIMALITY_BACKEND *out)
+{
+    if (value == NULL || out == NULL)
+        return 0;
+
+    if (strcmp(value, "mr") == 0)
+    {
+        *out = IZ_PRIMALITY_MR;
+        return 1;
+    }
+    if (strcmp(value, "bpsw") == 0)
+    {
+        *out = IZ_PRIMALITY_BPSW;
+        return 1;
+    }
+
+    return 0;
+}
+
+static int parse_sieve_depth_value(const char *value, uint64_t *out)
+{
+    if (value == NULL || out == NULL)
+        return 0;
+
+    if (strcmp(value, "auto") == 0)
+    {
+        *out = 0;
+        return 1;
+    }
+
+    if (!parse_expr_u64(value, out) || *out < 1 || *out > IZ_SIEVE_DEPTH_RANGE_MAX)
+        return 0;
+
+    return 1;
+}
+
 static int read_cli_option_value(
     int argc,
     char **argv,
@@ -204,43 +249,60 @@ static void print_general_help(const char *prog)
 
 static void print_stream_help(const char *prog)
 {
-    printf("Usage: %s stream_primes --range \"[LOWER, UPPER]\" [--print | --stream-to FILE] [--print-gaps] [--mr-rounds N]\n", prog);
+    printf("Usage: %s stream_primes --range \"[LOWER, UPPER]\" [--print | --stream-to FILE] [--print-gaps] [--mr-rounds N] [--primality mr|bpsw] [--sieve-depth N|auto]\n", prog);
     printf("Notes:\n");
     printf("  - Range is inclusive and accepts large-number expressions.\n");
     printf("  - Supported numeric operators: + - * / ^ e and parentheses.\n");
     printf("  - If no output option is set, output defaults to output/stream_<timestamp>.txt\n");
     printf("  - --print-gaps emits prime gaps from segment base (implies --print).\n");
+    printf("  - --primality selects Miller-Rabin (default) or Baillie-PSW for large candidates.\n");
+    printf("  - Ranges below 2^128 use exact 64-bit and native Baillie-PSW tests; --mr-rounds and\n");
+    printf("    --primality only apply to larger ranges.\n");
+    printf("  - --sieve-depth sets the largest sieving prime (<= 2^26) before primality tests; default auto.\n");
 }
 
 static void print_count_help(const char *prog)
 {
-    printf("Usage: %s count_primes --range \"[LOWER, UPPER]\" [--cores N|max] [--mr-rounds N]\n", prog);
+    printf("Usage: %s count_primes --range \"[LOWER, UPPER]\" [--cores N|max] [--mr-rounds N] [--primality mr|bpsw] [--sieve-depth N|auto]\n", prog);
     printf("Notes:\n");
     printf("  - Range is inclusive and accepts large-number expressions.\n");
     printf("  - --cores accepts an integer >= 1 or the literal 'max'.\n");
     printf("  - core count is clamped to available CPU cores.\n");
     printf("  - --cores-number is accepted as a backward-compatible alias.\n");
+    printf("  - --primality selects Miller-Rabin (default) or Baillie-PSW for large candidates.\n");
+    printf("  - Ranges below 2^128 use exact 64-bit and native Baillie-PSW tests; --mr-rounds and\n");
+    printf("    --primality only apply to larger ranges.\n");
+    printf("  - --sieve-depth sets the largest sieving prime (<= 2^26) before primality tests; default auto.\n");
 }
 
 static void print_next_prime_help(const char *prog)
 {
     printf("Usage: %s next_prime --n VALUE\n", prog);
+    printf("   or: %s next_prime --input FILE|- [--cores N|max]\n", prog);
     printf("Notes:\n");
     printf("  - VALUE accepts the same numeric expression syntax as range bounds.\n");
+    printf("  - --input reads one base per line from FILE ('-' for stdin), skipping blank and '#' lines,\n");
+    printf("    and prints one prime per line in input order (batched with iZ_next_prime_batch).\n");
+    printf("  - --cores applies to --input batches only.\n");
 }
 
 static void print_prev_prime_help(const char *prog)
 {
     printf("Usage: %s prev_prime --n VALUE\n", prog);
+    printf("   or: %s prev_prime --input FILE|- [--cores N|max]\n", prog);
     printf("Notes:\n");
     printf("  - VALUE accepts the same numeric expression syntax as range bounds.\n");
+    printf("  - --input reads one base per line from FILE ('-' for stdin), skipping blank and '#' lines,\n");
+    printf("    and prints one prime per line in input order (batched with iZ_next_prime_batch).\n");
+    printf("  - --cores applies to --input batches only.\n");
 }
 
 static void print_is_prime_help(const char *prog)
 {
-    printf("Usage: %s is_prime --n VALUE [--rounds N]\n", prog);
+    printf("Usage: %s is_prime --n VALUE [--rounds N] [--primality mr|bpsw]\n", prog);
     printf("Notes:\n");
-    printf("  - --rounds defaults to %d.\n", MR_ROUNDS);
+    printf("  - --rounds defaults to %d (Miller-Rabin only).\n", MR_ROUNDS);
+    printf("  - --primality bpsw runs a Baillie-PSW test instead of Miller-Rabin; --rounds is then ignored.\n");
 }
 
 static void print_gcd_help(const char *prog)
@@ -283,6 +345,8 @@ typedef struct
     int has_range;
     CLI_RANGE range;
     int mr_rounds;
+    IZ_PRIMALITY_BACKEND primality;
+    uint64_t sieve_depth;
     int print_to_console;
     int print_gaps;
     const char *stream_path;
@@ -364,6 +428,44 @@ static STREAM_PARSE_RESULT parse_stream_rounds_option(
     return STREAM_PARSE_OK;
 }
 
+static STREAM_PARSE_RESULT parse_stream_primality_option(
+    int argc,
+    char **argv,
+    int *index,
+    STREAM_CMD_OPTIONS *options)
+{
+    const char *value = NULL;
+    if (!stream_read_option_value(argc, argv, index, &value, "--primality"))
+        return STREAM_PARSE_ERROR;
+
+    if (!parse_primality_value(value, &options->primality))
+    {
+        fprintf(stderr, "Invalid --primality value. Use 'mr' or 'bpsw'.\n");
+        return STREAM_PARSE_ERROR;
+    }
+
+    return STREAM_PARSE_OK;
+}
+
+static STREAM_PARSE_RESULT parse_stream_depth_option(
+    int argc,
+    char **argv,
+    int *index,
+    STREAM_CMD_OPTIONS *options)
+{
+    const char *value = NULL;
+    if (!stream_read_option_value(argc, argv, index, &value, "--sieve-depth"))
+        return STREAM_PARSE_ERROR;
+
+    if (!parse_sieve_depth_value(value, &options->sieve_depth))
+    {
+        fprintf(stderr, "Invalid --sieve-depth value. Use an integer in [1, 2^26] or 'auto'.\n");
+        return STREAM_PARSE_ERROR;
+    }
+
+    return STREAM_PARSE_OK;
+}
+
 static STREAM_PARSE_RESULT parse_stream_primes_option(
     int argc,
     char **argv,
@@ -389,6 +491,10 @@ static STREAM_PARSE_RESULT parse_stream_primes_option(
         return parse_stream_output_option(argc, argv, index, options, arg);
     if (strcmp(arg, "--mr-rounds") == 0)
         return parse_stream_rounds_option(argc, argv, index, options);
+    if (strcmp(arg, "--primality") == 0)
+        return parse_stream_primality_option(argc, argv, index, options);
+    if (strcmp(arg, "--sieve-depth") == 0)
+        return parse_stream_depth_option(argc, argv, index, options);
 
     fprintf(stderr, "Unknown option: %s\n", arg);
     return STREAM_PARSE_ERROR;
@@ -550,6 +656,8 @@ static int run_stream_primes_cmd(int argc, char **argv)
         .start = options.range.lower,
         .range = options.range.range_size,
         .mr_rounds = options.mr_rounds,
+        .primality = options.primality,
+        .sieve_depth = options.sieve_depth,
         .stream_gaps = options.print_gaps,
         // NULL filepath tells SiZ_stream() to emit directly to stdout.
         .filepath = stream_path_mut};
@@ -574,6 +682,8 @@ static int run_count_primes_cmd(int argc, char **argv)
     int has_range = 0;
     CLI_RANGE range = {0};
     int mr_rounds = 25;
+    IZ_PRIMALITY_BACKEND primality = IZ_PRIMALITY_MR;
+    uint64_t sieve_depth = 0; // auto
     int cores = get_cpu_cores_count();
 
     for (int i = 2; i < argc; ++i)
@@ -620,6 +730,30 @@ static int run_count_primes_cmd(int argc, char **argv)
             }
             continue;
         }
+        if (strcmp(argv[i], "--primality") == 0)
+        {
+            const char *primality_value = NULL;
+            if (!read_cli_option_value(argc, argv, &i, &primality_value, "--primality"))
+                return EXIT_FAILURE;
+            if (!parse_primality_value(primality_value, &primality))
+            {
+                fprintf(stderr, "Invalid --primality value. Use 'mr' or 'bpsw'.\n");
+                return EXIT_FAILURE;
+            }
+            continue;
+        }
+        if (strcmp(argv[i], "--sieve-depth") == 0)
+        {
+            const char *depth_value = NULL;
+            if (!read_cli_option_value(argc, argv, &i, &depth_value, "--sieve-depth"))
+                return EXIT_FAILURE;
+            if (!parse_sieve_depth_value(depth_value, &sieve_depth))
+            {
+                fprintf(stderr, "Invalid --sieve-depth value. Use an integer in [1, 2^26] or 'auto'.\n");
+                return EXIT_FAILURE;
+            }
+            continue;
+        }
 
         fprintf(stderr, "Unknown option: %s\n", argv[i]);
         return EXIT_FAILURE;
@@ -641,6 +775,8 @@ static int run_count_primes_cmd(int argc, char **argv)
         .start = range.lower,
         .range = range.range_size,
         .mr_rounds = mr_rounds,
+        .primality = primality,
+        .sieve_depth = sieve_depth,
         .stream_gaps = 0,
         .filepath = NULL,
     };
@@ -711,6 +847,9 @@ static int run_test_cmd(int argc, char **argv)
             continue;
         }
 
+        if (!arr->ordered)
+            ui64_sort(arr); // vertical models emit unordered primes
+
         int ok = (arr->count == baseline->count);
         if (ok)
         {
@@ -816,7 +955,7 @@ static int run_benchmark_cmd(int argc, char **argv)
         fprintf(out, "algorithm,limit,repeat,avg_seconds,prime_count\n");
     }
     printf("Benchmark: n=%" PRIu64 ", repeat=%d\n", limit, repeat);
-    printf("%-10s %-12s %-14s %-12s\n", "Model", "Primes", "Avg(s)", "Status");
+    printf("%-16s %-12s %-14s %-12s\n", "Model", "Primes", "Avg(s)", "Status");
 
     int failures = 0;
     int matched_models = 0;
@@ -850,13 +989,13 @@ static int run_benchmark_cmd(int argc, char **argv)
 
         if (!ok)
         {
-            printf("%-10s %-12s %-14s %-12s\n", k_sieve_models[i].name, "-", "-", "FAIL");
+            printf("%-16s %-12s %-14s %-12s\n", k_sieve_models[i].name, "-", "-", "FAIL");
             failures++;
             continue;
         }
 
         double avg = total_seconds / (double)repeat;
-        printf("%-10s %-12d %-14.6f %-12s\n", k_sieve_models[i].name, prime_count, avg, "OK");
+        printf("%-16s %-12d %-14.6f %-12s\n", k_sieve_models[i].name, prime_count, avg, "OK");
         if (out != NULL)
             fprintf(out, "%s,%" PRIu64 ",%d,%.6f,%d\n", k_sieve_models[i].name, limit, repeat, avg, prime_count);
     }
@@ -883,9 +1022,151 @@ static int run_next_prime_cmd(int argc, char **argv)
     return run_directional_prime_cmd(argc, argv, 1);
 }
 
+/** Longest accepted line of a --input base list. */
+#define CLI_BASE_LINE_CAP 8192
+
+static void free_cli_mpz_array(mpz_t *bases, int count)
+{
+    for (int i = 0; i < count; ++i)
+        mpz_clear(bases[i]);
+    free(bases);
+}
+
+// Read one base expression per line; blank lines and '#' comments are skipped.
+static int read_cli_bases(const char *path, mpz_t **out_bases, int *out_count)
+{
+    int use_stdin = strcmp(path, "-") == 0;
+    FILE *input = use_stdin ? stdin : fopen(path, "r");
+    if (input == NULL)
+    {
+        fprintf(stderr, "Failed to open input file: %s\n", path);
+        return 0;
+    }
+
+    mpz_t *bases = NULL;
+    int count = 0;
+    int capacity = 0;
+    int ok = 1;
+    int line_no = 0;
+    char line[CLI_BASE_LINE_CAP];
+
+    while (ok && fgets(line, sizeof(line), input) != NULL)
+    {
+        line_no++;
+        size_t len = strlen(line);
+        if (len == sizeof(line) - 1 && line[len - 1] != '\n' && !feof(input))
+        {
+            fprintf(stderr, "Input line %d is longer than %d characters.\n", line_no, CLI_BASE_LINE_CAP - 2);
+            ok = 0;
+            break;
+        }
+
+        // trim surrounding whitespace
+        while (len > 0 && isspace((unsigned char)line[len - 1]))
+            line[--len] = '\0';
+        char *expr = line;
+        while (isspace((unsigned char)*expr))
+            expr++;
+        if (*expr == '\0' || *expr == '#')
+            continue;
+
+        if (count == capacity)
+        {
+            int new_capacity = capacity ? 2 * capacity : 64;
+            mpz_t *grown = realloc(bases, (size_t)new_capacity * sizeof(mpz_t));
+            if (grown == NULL)
+            {
+                fprintf(stderr, "Out of memory while reading bases.\n");
+                ok = 0;
+                break;
+            }
+            bases = grown;
+            capacity = new_capacity;
+        }
+
+        mpz_init(bases[count]);
+        if (!parse_numeric_expr_mpz(bases[count], expr) || mpz_sgn(bases[count]) < 0)
+        {
+            fprintf(stderr, "Invalid numeric expression on input line %d.\n", line_no);
+            mpz_clear(bases[count]);
+            ok = 0;
+            break;
+        }
+        count++;
+    }
+
+    if (ok && ferror(input))
+    {
+        fprintf(stderr, "Failed to read input: %s\n", path);
+        ok = 0;
+    }
+    if (ok && count == 0)
+    {
+        fprintf(stderr, "No bases found in input: %s\n", path);
+        ok = 0;
+    }
+    if (!use_stdin)
+        fclose(input);
+
+    if (!ok)
+    {
+        free_cli_mpz_array(bases, count);
+        return 0;
+    }
+
+    *out_bases = bases;
+    *out_count = count;
+    return 1;
+}
+
+static int run_batch_prime_cmd(const char *input_path, int forward, int cores)
+{
+    mpz_t *bases = NULL;
+    int count = 0;
+    if (!read_cli_bases(input_path, &bases, &count))
+        return EXIT_FAILURE;
+
+    mpz_t *primes = malloc((size_t)count * sizeof(mpz_t));
+    if (primes == NULL)
+    {
+        fprintf(stderr, "Out of memory while preparing %d bases.\n", count);
+        free_cli_mpz_array(bases, count);
+        return EXIT_FAILURE;
+    }
+    for (int i = 0; i < count; ++i)
+        mpz_init(primes[i]);
+
+    cores = MIN(cores, get_cpu_cores_count());
+
+    STOPWATCH timer;
+    sw_start(&timer);
+    int found = iZ_next_prime_batch(primes, bases, count, forward, cores);
+    sw_stop(&timer);
+
+    // primes go to stdout alone so the output can be piped; the summary goes to stderr
+    if (found == count)
+    {
+        for (int i = 0; i < count; ++i)
+            gmp_printf("%Zd\n", primes[i]);
+        fprintf(stderr, "Found %s primes for %d bases. Cores used: %d Elapsed (s): %.6f\n",
+                forward ? "next" : "previous", count, cores, timer.elapsed_sec);
+    }
+    else
+    {
+        fprintf(stderr, "Failed to find the %s prime for %d of %d bases.\n", forward ? "next" : "previous", count - found, count);
+    }
+
+    free_cli_mpz_array(primes, count);
+    free_cli_mpz_array(bases, count);
+    return (found == count) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
 static int run_directional_prime_cmd(int argc, char **argv, int forward)
 {
     const char *value_expr = NULL;
+    const char *input_path = NULL;
+    int cores = 1;
+    int cores_set = 0;
 
     for (int i = 2; i < argc; ++i)
     {
@@ -905,6 +1186,25 @@ static int run_directional_prime_cmd(int argc, char **argv, int forward)
             value_expr = n_value;
             continue;
         }
+        if (strcmp(argv[i], "--input") == 0)
+        {
+            if (!read_cli_option_value(argc, argv, &i, &input_path, "--input"))
+                return EXIT_FAILURE;
+            continue;
+        }
+        if (strcmp(argv[i], "--cores") == 0)
+        {
+            const char *cores_value = NULL;
+            if (!read_cli_option_value(argc, argv, &i, &cores_value, "--cores"))
+                return EXIT_FAILURE;
+            if (!parse_cores_value(cores_value, &cores))
+            {
+                fprintf(stderr, "Invalid --cores value. Use an integer >= 1 or 'max'.\n");
+                return EXIT_FAILURE;
+            }
+            cores_set = 1;
+            continue;
+        }
         if (argv[i][0] != '-' && value_expr == NULL)
         {
             value_expr = argv[i];
@@ -915,9 +1215,24 @@ static int run_directional_prime_cmd(int argc, char **argv, int forward)
         return EXIT_FAILURE;
     }
 
+    if (value_expr != NULL && input_path != NULL)
+    {
+        fprintf(stderr, "Use either --n VALUE or --input FILE, not both.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (cores_set && input_path == NULL)
+    {
+        fprintf(stderr, "--cores only applies to --input batches.\n");
+        return EXIT_FAILURE;
+    }
+
+    if (input_path != NULL)
+        return run_batch_prime_cmd(input_path, forward, cores);
+
     if (value_expr == NULL)
     {
-        fprintf(stderr, "Missing required value. Use --n VALUE.\n");
+        fprintf(stderr, "Missing required value. Use --n VALUE or --input FILE.\n");
         return EXIT_FAILURE;
     }
 
@@ -962,6 +1277,7 @@ static int run_is_prime_cmd(int argc, char **argv)
 {
     const char *value_expr = NULL;
     int rounds = MR_ROUNDS;
+    IZ_PRIMALITY_BACKEND primality = IZ_PRIMALITY_MR;
 
     for (int i = 2; i < argc; ++i)
     {
@@ -990,6 +1306,18 @@ static int run_is_prime_cmd(int argc, char **argv)
             }
             continue;
         }
+        if (strcmp(argv[i], "--primality") == 0)
+        {
+            const char *primality_value = NULL;
+            if (!read_cli_option_value(argc, argv, &i, &primality_value, "--primality"))
+                return EXIT_FAILURE;
+            if (!parse_primality_value(primality_value, &primality))
+            {
+                fprintf(stderr, "Invalid --primality value. Use 'mr' or 'bpsw'.\n");
+                return EXIT_FAILURE;
+            }
+            continue;
+        }
         if (argv[i][0] != '-' && value_expr == NULL)
         {
             value_expr = argv[i];
@@ -1017,7 +1345,7 @@ static int run_is_prime_cmd(int argc, char **argv)
 
     STOPWATCH timer;
     sw_start(&timer);
-    int result = test_primality(n, rounds);
+    int result = test_primality_with(n, rounds, primality);
     sw_stop(&timer);
 
     if (result > 0)
@@ -398,6 +398,76 @@ int izp_ffi_next_prime(const char *base_expr, int forward, char **out_prime_base
     return status;
 }
 
+int izp_ffi_next_prime_batch(const char *const *base_exprs, size_t count, int forward, int threads, IZP_STR_BUFFER *out)
+{
+    izp_ffi_clear_error();
+
+    if (out == NULL)
+    {
+        izp_ffi_set_error("out buffer pointer is NULL.");
+        return IZP_FFI_ERR_INVALID_ARG;
+    }
+
+    out->data = NULL;
+    out->len = 0;
+
+    if (base_exprs == NULL || count == 0 || count > INT_MAX)
+    {
+        izp_ffi_set_error("base_exprs must hold count in [1, INT_MAX] expressions.");
+        return IZP_FFI_ERR_INVALID_ARG;
+    }
+
+    mpz_t *bases = malloc(count * sizeof(mpz_t));
+    mpz_t *primes = malloc(count * sizeof(mpz_t));
+    char **strings = calloc(count, sizeof(char *));
+    if (bases == NULL || primes == NULL || strings == NULL)
+    {
+        free(bases);
+        free(primes);
+        free(strings);
+        izp_ffi_set_error("Failed to allocate next-prime batch.");
+        return IZP_FFI_ERR_ALLOC;
+    }
+
+    for (size_t i = 0; i < count; i++)
+        mpz_inits(bases[i], primes[i], NULL);
+
+    int status = IZP_FFI_OK;
+    for (size_t i = 0; i < count && status == IZP_FFI_OK; i++)
+    {
+        if (!izp_ffi_validate_expr_nonnegative(base_exprs[i], bases[i]))
+        {
+            izp_ffi_set_error("Failed to parse non-negative base expression.");
+            status = IZP_FFI_ERR_PARSE;
+        }
+    }
+
+    if (status == IZP_FFI_OK && (size_t)iZ_next_prime_batch(primes, bases, (int)count, forward ? 1 : 0, MAX(threads, 1)) != count)
+    {
+        izp_ffi_set_error("No prime found for the requested direction.");
+        status = IZP_FFI_ERR_NOT_FOUND;
+    }
+
+    for (size_t i = 0; i < count && status == IZP_FFI_OK; i++)
+        status = izp_ffi_copy_mpz_to_string(primes[i], &strings[i]);
+
+    for (size_t i = 0; i < count; i++)
+        mpz_clears(bases[i], primes[i], NULL);
+    free(bases);
+    free(primes);
+
+    if (status != IZP_FFI_OK)
+    {
+        IZP_STR_BUFFER partial = {strings, count};
+        izp_ffi_free_str_buffer(&partial);
+        return status;
+    }
+
+    out->data = strings;
+    out->len = count;
+    return IZP_FFI_OK;
+}
+
 int izp_ffi_random_prime_vx(int bit_size, int cores_num, char **out_prime_base10)
 {
     izp_ffi_clear_error();
@@ -464,6 +534,73 @@ int izp_ffi_random_prime_vy(int bit_size, int cores_num, char **out_prime_base10
     return status;
 }
 
+int izp_ffi_random_primes(int bit_size, size_t count, int threads, IZP_STR_BUFFER *out, double *out_primes_per_sec)
+{
+    izp_ffi_clear_error();
+
+    if (out == NULL)
+    {
+        izp_ffi_set_error("out buffer pointer is NULL.");
+        return IZP_FFI_ERR_INVALID_ARG;
+    }
+
+    out->data = NULL;
+    out->len = 0;
+    if (out_primes_per_sec)
+        *out_primes_per_sec = 0.0;
+
+    if (bit_size < IZ_RANDOM_PRIMES_MIN_BITS)
+    {
+        izp_ffi_set_error("bit_size must be >= 20.");
+        return IZP_FFI_ERR_INVALID_ARG;
+    }
+
+    if (count == 0 || count > INT_MAX)
+    {
+        izp_ffi_set_error("count must be in [1, INT_MAX].");
+        return IZP_FFI_ERR_INVALID_ARG;
+    }
+
+    mpz_t *primes = malloc(count * sizeof(mpz_t));
+    char **strings = calloc(count, sizeof(char *));
+    if (primes == NULL || strings == NULL)
+    {
+        free(primes);
+        free(strings);
+        izp_ffi_set_error("Failed to allocate prime batch.");
+        return IZP_FFI_ERR_ALLOC;
+    }
+
+    for (size_t i = 0; i < count; i++)
+        mpz_init(primes[i]);
+
+    int status = IZP_FFI_OK;
+    int found = iZ_random_primes(primes, (int)count, bit_size, MAX(threads, 1), out_primes_per_sec);
+    if ((size_t)found != count)
+    {
+        izp_ffi_set_error("iZ_random_primes failed.");
+        status = IZP_FFI_ERR_OPERATION;
+    }
+
+    for (size_t i = 0; i < count && status == IZP_FFI_OK; i++)
+        status = izp_ffi_copy_mpz_to_string(primes[i], &strings[i]);
+
+    for (size_t i = 0; i < count; i++)
+        mpz_clear(primes[i]);
+    free(primes);
+
+    if (status != IZP_FFI_OK)
+    {
+        IZP_STR_BUFFER partial = {strings, count};
+        izp_ffi_free_str_buffer(&partial);
+        return status;
+    }
+
+    out->data = strings;
+    out->len = count;
+    return IZP_FFI_OK;
+}
+
 void izp_ffi_free_u64_buffer(IZP_U64_BUFFER *buffer)
 {
     if (buffer == NULL)
@@ -482,3 +619,15 @@ void izp_ffi_free_string(char **str)
     free(*str);
     *str = NULL;
 }
+
+void izp_ffi_free_str_buffer(IZP_STR_BUFFER *buffer)
+{
+    if (buffer == NULL)
+        return;
+
+    for (size_t i = 0; buffer->data && i < buffer->len; i++)
+        free(buffer->data[i]);
+    free(buffer->data);
+    buffer->data = NULL;
+    buffer->len = 0;
+}
@@ -9,35 +9,31 @@
 
 #include <iZ_api.h>
 
-#define PRIME_STR_CAP_PADDING 64U
-
-#if IZ_PLATFORM_HAS_FORK
-static int write_all_bytes(int fd, const char *buf, size_t len)
-{
-    size_t total = 0;
-    while (total < len)
-    {
-        ssize_t written = write(fd, buf + total, len - total);
-        if (written <= 0)
-            return 0;
-        total += (size_t)written;
-    }
-    return 1;
-}
-#endif
+#include <pthread.h>
+#include <stdatomic.h>
 
 // Global iZm instance for VX6 segments, initialized once and reused by range APIs.
 static IZM *iZmX = NULL;
 
-// Constructor to initialize iZmX at program startup
+// Global iZm instance for VX4 windows (5005 columns, 30030 integers), sieved deeply
+// by iZ_next_prime(); one window spans several prime gaps even at 4096 bits.
+static IZM *iZmW = NULL;
+
+// Global iZm instance for VX5 segments, shared read-only by the random-prime
+// searches up to 2048 bits (larger sizes share iZmX).
+static IZM *iZmR = NULL;
+
+// Constructor to initialize iZmX, iZmW and iZmR at program startup
 __attribute__((constructor)) static void init_iZmX(void)
 {
     int vx = VX6; // 1616615, suitable for up to 10^12 on typical hardware,
     // for larger limits on capable hardware consider VX7 or VX8
     iZmX = iZm_init(vx);
-    if (!iZmX)
+    iZmW = iZm_init(VX4);
+    iZmR = iZm_init(VX5);
+    if (!iZmX || !iZmW || !iZmR)
     {
-        log_error("Failed to initialize iZmX in constructor.");
+        log_error("Failed to initialize iZmX/iZmW/iZmR in constructor.");
         exit(EXIT_FAILURE);
     }
 }
@@ -46,6 +42,27 @@ __attribute__((constructor)) static void init_iZmX(void)
 // * SiZ Range Variants
 // =========================================================
 
+/**
+ * @brief Resolve the deterministic sieving depth requested for a range.
+ * @param input_range Range configuration (sieve_depth 0 selects the depth automatically).
+ * @param info Mapped range coordinates.
+ * @param workers Number of workers sharing the range.
+ * @return Depth to apply with vx_set_sieve_depth(), at most IZ_SIEVE_DEPTH_RANGE_MAX.
+ */
+static uint64_t range_sieve_depth(INPUT_SIEVE_RANGE *input_range, IZM_RANGE_INFO *info, int workers)
+{
+    if (input_range->sieve_depth > IZ_SIEVE_DEPTH_RANGE_MAX)
+    {
+        log_warn("Sieving depth %" PRIu64 " clamped to 2^26 (each worker holds its own offsets)", input_range->sieve_depth);
+        return IZ_SIEVE_DEPTH_RANGE_MAX;
+    }
+    if (input_range->sieve_depth > 0)
+        return input_range->sieve_depth;
+
+    uint64_t x_span = input_range->range / 6 + 1;
+    return iZ_auto_sieve_depth(info->vx, (int)mpz_sizeinbase(info->Ze, 2), x_span / MAX(workers, 1) + 1);
+}
+
 /**
  * @ingroup iz_api
  * @brief Stream primes in an arbitrary numeric range using iZ toolkit.
@@ -87,6 +104,7 @@ uint64_t SiZ_stream(INPUT_SIEVE_RANGE *input_range)
     int vx = iZmX->vx;
     // Miller-Rabin rounds, bounded [5, 50]
     int mr_rounds = MIN(MAX(input_range->mr_rounds, 5), 50);
+    IZ_PRIMALITY_BACKEND primality = (input_range->primality == IZ_PRIMALITY_BPSW) ? IZ_PRIMALITY_BPSW : IZ_PRIMALITY_MR;
 
     IZM_RANGE_INFO info = range_info_init(input_range, vx);
     if (info.y_range < 0)
@@ -97,6 +115,7 @@ uint64_t SiZ_stream(INPUT_SIEVE_RANGE *input_range)
         return 0;
     }
 
+    VX_SEG *vx_obj = NULL;
     mpz_t current_y;
     mpz_init(current_y);
     mpz_set(current_y, info.Ys);
@@ -156,22 +175,22 @@ uint64_t SiZ_stream(INPUT_SIEVE_RANGE *input_range)
         goto stream_cleanup;
     }
 
+    // One long-lived segment, re-targeted per y (carries root-prime offsets too)
+    vx_obj = vx_create(iZmX, mr_rounds);
+    if (!vx_obj || !vx_set_sieve_depth(vx_obj, range_sieve_depth(input_range, &info, 1)))
+    {
+        total = 0;
+        goto stream_cleanup;
+    }
+    vx_obj->primality = primality;
+
     // Process remaining segments for y in [current_y:Ye]
     int first_segment = 1;
     while (mpz_cmp(current_y, info.Ye) <= 0)
     {
         int seg_start_x = first_segment ? start_x : 1;
         int seg_end_x = (mpz_cmp(current_y, info.Ye) == 0) ? end_x : vx;
-        char *y_str = mpz_get_str(NULL, 10, current_y);
-        if (!y_str)
-        {
-            total = 0;
-            goto stream_cleanup;
-        }
-
-        VX_SEG *vx_obj = vx_init(iZmX, seg_start_x, seg_end_x, y_str, mr_rounds);
-        free(y_str);
-        if (!vx_obj)
+        if (!vx_reset(vx_obj, current_y, seg_start_x, seg_end_x))
         {
             // check logs for errors
             total = 0;
@@ -181,12 +200,12 @@ uint64_t SiZ_stream(INPUT_SIEVE_RANGE *input_range)
         vx_stream(vx_obj, output, input_range->stream_gaps);
         total += vx_obj->p_count; // accumulate prime count
 
-        vx_free(&vx_obj);
         first_segment = 0;
         mpz_add_ui(current_y, current_y, 1); // increment Ys for the next segment
     }
 
 stream_cleanup:
+    vx_free(&vx_obj);
     range_info_free(&info);
     mpz_clear(current_y);
     if (has_output_file)
@@ -230,6 +249,7 @@ uint64_t SiZ_count(INPUT_SIEVE_RANGE *input_range, int cores_num)
     int vx = iZmX->vx;
     // Miller-Rabin rounds, bounded [5, 50]
     int mr_rounds = MIN(MAX(input_range->mr_rounds, 5), 50);
+    IZ_PRIMALITY_BACKEND primality = (input_range->primality == IZ_PRIMALITY_BPSW) ? IZ_PRIMALITY_BPSW : IZ_PRIMALITY_MR;
     cores_num = MAX(1, MIN(cores_num, get_cpu_cores_count()));
 #if !IZ_PLATFORM_HAS_FORK
     if (cores_num > 1)
@@ -250,6 +270,8 @@ uint64_t SiZ_count(INPUT_SIEVE_RANGE *input_range, int cores_num)
         return 0;
     }
 
+    VX_SEG *vx_obj = NULL;
+    VX_SIEVE_STATE *depth_state = NULL; // sieving state shared by all workers
     mpz_t current_y;
     mpz_init(current_y);
     mpz_set(current_y, info.Ys);
@@ -307,7 +329,7 @@ uint64_t SiZ_count(INPUT_SIEVE_RANGE *input_range, int cores_num)
         iZ_mpz(prime_z, info.Xs, -1);
         if (mpz_cmp(prime_z, info.Zs) < 0)
         {
-            if (mpz_probab_prime_p(prime_z, 25))
+            if (test_primality_with(prime_z, mr_rounds, primality))
             {
                 total--;
             }
@@ -320,7 +342,7 @@ uint64_t SiZ_count(INPUT_SIEVE_RANGE *input_range, int cores_num)
         iZ_mpz(prime_z, info.Xe, 1);
         if (mpz_cmp(prime_z, info.Ze) > 0)
         {
-            if (mpz_probab_prime_p(prime_z, 25))
+            if (test_primality_with(prime_z, mr_rounds, primality))
             {
                 total--;
             }
@@ -334,24 +356,34 @@ uint64_t SiZ_count(INPUT_SIEVE_RANGE *input_range, int cores_num)
         goto count_cleanup;
     }
 
+    // Deterministic sieving depth, balanced against each worker's share of the range;
+    // its primes are generated once here and every worker adopts the state
+    uint64_t sieve_depth = range_sieve_depth(input_range, &info, MIN(cores_num, total_segments));
+    depth_state = vx_state_init_depth(iZmX, sieve_depth);
+    if (!depth_state)
+    {
+        total = 0;
+        goto count_cleanup;
+    }
+
     // Single-process processing of all segments
     if (cores_num == 1)
     {
+        vx_obj = vx_create(iZmX, mr_rounds);
+        if (!vx_obj || !vx_set_sieve_state(vx_obj, depth_state))
+        {
+            total = 0;
+            goto count_cleanup;
+        }
+        depth_state = NULL; // owned by vx_obj
+        vx_obj->primality = primality;
+
         int first_segment = 1;
         for (int i = 0; i < total_segments; i++)
         {
             int seg_start_x = first_segment ? start_x : 1;
             int seg_end_x = (i == total_segments - 1) ? end_x : vx;
-            char *y_str = mpz_get_str(NULL, 10, current_y);
-            if (!y_str)
-            {
-                total = 0;
-                goto count_cleanup;
-            }
-
-            VX_SEG *vx_obj = vx_init(iZmX, seg_start_x, seg_end_x, y_str, mr_rounds);
-            free(y_str);
-            if (!vx_obj)
+            if (!vx_reset(vx_obj, current_y, seg_start_x, seg_end_x))
             {
                 total = 0;
                 goto count_cleanup;
@@ -360,7 +392,6 @@ uint64_t SiZ_count(INPUT_SIEVE_RANGE *input_range, int cores_num)
             vx_full_sieve(vx_obj, 0);
             total += vx_obj->p_count;
 
-            vx_free(&vx_obj);
             first_segment = 0;
             mpz_add_ui(current_y, current_y, 1); // increment Ys for the next segment
         }
@@ -453,46 +484,41 @@ uint64_t SiZ_count(INPUT_SIEVE_RANGE *input_range, int cores_num)
                 mpz_set(local_Ys, current_y);
                 mpz_add_ui(local_Ys, local_Ys, offset);
 
-                // Each child has its own IZM to avoid data races
+                // Each child has its own IZM to avoid data races, and adopts its
+                // copy-on-write copy of the parent's sieving state
                 IZM *iZm_local = iZm_clone(iZmX);
-                if (!iZm_local)
+                VX_SEG *vx_local = iZm_local ? vx_create(iZm_local, mr_rounds) : NULL;
+                if (!vx_local || !vx_set_sieve_state(vx_local, depth_state))
                 {
+                    vx_free(&vx_local);
+                    iZm_free(&iZm_local);
                     mpz_clear(local_Ys);
                     close(pipe_fds[core][1]);
                     exit(1);
                 }
+                vx_local->primality = primality;
 
                 for (int i = 0; i < local_segments; i++)
                 {
                     int global_segment = offset + i;
                     int seg_start_x = (global_segment == 0) ? start_x : 1;
                     int seg_end_x = (global_segment == total_segments - 1) ? end_x : vx;
-                    char *y_str = mpz_get_str(NULL, 10, local_Ys);
-                    if (!y_str)
-                    {
-                        iZm_free(&iZm_local);
-                        mpz_clear(local_Ys);
-                        close(pipe_fds[core][1]);
-                        exit(1);
-                    }
-
-                    VX_SEG *vx_obj = vx_init(iZm_local, seg_start_x, seg_end_x, y_str, mr_rounds);
-                    free(y_str);
-                    if (!vx_obj)
+                    if (!vx_reset(vx_local, local_Ys, seg_start_x, seg_end_x))
                     {
+                        vx_free(&vx_local);
                         iZm_free(&iZm_local);
                         mpz_clear(local_Ys);
                         close(pipe_fds[core][1]);
                         exit(1);
                     }
 
-                    vx_full_sieve(vx_obj, 0);
-                    child_total += vx_obj->p_count;
+                    vx_full_sieve(vx_local, 0);
+                    child_total += vx_local->p_count;
 
-                    vx_free(&vx_obj);
                     mpz_add_ui(local_Ys, local_Ys, 1);
                 }
 
+                vx_free(&vx_local);
                 iZm_free(&iZm_local);
                 mpz_clear(local_Ys);
             }
@@ -571,6 +597,8 @@ count_cleanup:
     free(pids);
     free(pipe_fds);
 #endif
+    vx_state_free(&depth_state);
+    vx_free(&vx_obj);
     range_info_free(&info);
     mpz_clear(current_y);
 
@@ -581,18 +609,141 @@ count_cleanup:
 // * Random Prime Generation
 // =========================================================
 
+/** Upper bound on random-prime worker threads (bounds the thread-handle arrays on the stack). */
+#define RANDOM_PRIME_THREADS_MAX 256
+
+/**
+ * @brief Shared state of a threaded random-prime search.
+ *
+ * Every worker runs its own search with its own seeded random state, and reads
+ * @ref found between candidates. The first worker to find a prime claims the
+ * flag and copies its prime into @ref p; the others see it and return.
+ */
+typedef struct
+{
+    int bit_size;                     /**< Target bit size of the vx search. */
+    IZM *iZm;                         /**< Shared read-only assets of the vx search (unused by the vy search). */
+    int safe;                         /**< Non-zero to search safe primes with the vx search. */
+    const IZ_PRIME_CONSTRAINTS *cons; /**< Constraints of the vx search, or NULL. */
+    mpz_ptr vy_vx;                    /**< Lane width of the vy search, or NULL for the vx search. */
+    atomic_int found;                 /**< Raised by the first worker that finds a prime. */
+    mpz_ptr p;                        /**< Output prime, written by the claiming worker only. */
+} RANDOM_PRIME_JOB;
+
+/**
+ * @brief Pick the shared iZm for random primes of @p bit_size bits.
+ * @param bit_size Target bit size.
+ * @return iZmR (VX5) up to 2048 bits, iZmX (VX6) above.
+ */
+static IZM *random_prime_iZm(int bit_size)
+{
+    return bit_size <= 2048 ? iZmR : iZmX;
+}
+
+/**
+ * @brief Worker thread of random_prime_threads().
+ * @param arg Shared RANDOM_PRIME_JOB.
+ * @return NULL.
+ */
+static void *random_prime_worker(void *arg)
+{
+    RANDOM_PRIME_JOB *job = arg;
+
+    mpz_t local_p;
+    mpz_init(local_p);
+
+    int found = 0;
+    if (job->vy_vx)
+    {
+        found = vy_search_prime_until(local_p, 0, job->vy_vx, &job->found);
+    }
+    else
+    {
+        VX_SEARCH_CTX *ctx = vx_search_ctx_init_with_iZm(job->iZm);
+        if (ctx)
+        {
+            vx_search_ctx_set_stop(ctx, &job->found);
+            if (job->safe)
+                found = vx_search_safe_prime_ctx(ctx, local_p, job->bit_size);
+            else if (job->cons)
+                found = vx_search_prime_constrained(ctx, local_p, job->bit_size, job->cons);
+            else
+                found = vx_search_prime_ctx(ctx, local_p, 0, job->bit_size);
+            vx_search_ctx_free(&ctx);
+        }
+        else
+        {
+            log_error("Failed to initialize search context in random_prime_worker");
+        }
+    }
+
+    // hand the prime back only if no other worker claimed the result first
+    int expected = 0;
+    if (found && atomic_compare_exchange_strong(&job->found, &expected, 1))
+        mpz_set(job->p, local_p);
+
+    mpz_clear(local_p);
+    return NULL;
+}
+
+/**
+ * @brief Run @p threads random-prime workers until one of them finds a prime.
+ *
+ * Workers are joined before returning, so the result is complete and no
+ * search outlives the call. A single worker, or the fallback when no thread
+ * can be created, runs on the calling thread.
+ *
+ * @param job Shared job (found must be 0).
+ * @param threads Number of worker threads (at most RANDOM_PRIME_THREADS_MAX).
+ * @return 1 if a prime was stored in job->p, 0 otherwise.
+ */
+static int random_prime_threads(RANDOM_PRIME_JOB *job, int threads)
+{
+    threads = MAX(1, MIN(threads, RANDOM_PRIME_THREADS_MAX));
+    if (threads < 2)
+    {
+        random_prime_worker(job);
+        return atomic_load(&job->found);
+    }
+
+    pthread_t tids[threads];
+    int threads_created = 0;
+
+    for (int i = 0; i < threads; i++)
+    {
+        if (pthread_create(&tids[threads_created], NULL, random_prime_worker, job) != 0)
+        {
+            log_error("Failed to create thread %d in random_prime_threads", i);
+            continue;
+        }
+        threads_created++;
+    }
+
+    if (threads_created == 0)
+    {
+        log_error("No worker threads were created in random_prime_threads, falling back to in-thread search");
+        random_prime_worker(job);
+    }
+
+    for (int i = 0; i < threads_created; i++)
+        pthread_join(tids[i], NULL);
+
+    return atomic_load(&job->found);
+}
+
 /**
  * @ingroup iz_api
  * @brief Generates a random prime candidate using the vy_search_prime routine.
  *
  * Description: This function generates a random prime of a given bit size using the vy_search_prime routine.
  * It initializes the random base and sets up the search parameters. The function also allows
- * for parallel processing of the search using multiple child processes. The generated prime
+ * for parallel processing of the search using multiple threads that share a cancel
+ * flag, so the others stop at their next candidate once one finds a prime. The generated prime
  * is stored in the provided mpz_t p variable.
  *
  * @param p The mpz_t variable to store the generated prime number.
  * @param bit_size The target bit size of the prime.
- * @param cores_num The number of cores to use for parallel processing.
+ * @param cores_num The number of threads to use for parallel processing.
  * @return 1 if a prime is found, 0 otherwise.
  */
 int vy_random_prime(mpz_t p, int bit_size, int cores_num)
@@ -613,282 +764,459 @@ int vy_random_prime(mpz_t p, int bit_size, int cores_num)
         return found;
     }
 
-#if !IZ_PLATFORM_HAS_FORK
-    log_info("vy_random_prime: multi-process mode is unavailable on this platform; using single-process mode.");
-    found = vy_search_prime(p, 0, vx);
+    // 3. Else, race cores_num threads for the first prime
+    RANDOM_PRIME_JOB job = {.bit_size = bit_size, .vy_vx = vx, .p = p};
+    atomic_init(&job.found, 0);
+    found = random_prime_threads(&job, cores_num);
+
     mpz_clear(vx);
+
     return found;
-#else
-    // 3. Else, fork multiple processes to search for a prime
-    // Create a pipe for inter-process communication.
-    int fd[2];
-    if (pipe(fd) == -1)
-    {
-        log_error("Failed to create pipe in vy_random_prime. Falling back to in-process search.");
-        found = vy_search_prime(p, 0, vx);
-        mpz_clear(vx);
-        return found;
-    }
+}
 
-    pid_t pids[cores_num];
-    int forks_created = 0;
+/**
+ * @ingroup iz_api
+ * @brief Generates a random prime candidate using the vx_search_prime routine.
+ *
+ * Description: This function generates a random prime of a given bit size using the vx_search_prime routine.
+ * It initializes the random base and sets up the search parameters. The function also allows
+ * for parallel processing of the search using multiple threads that share a cancel
+ * flag, so the others stop at their next candidate once one finds a prime. The generated prime
+ * is stored in the provided mpz_t p variable.
+ *
+ * @param p The mpz_t variable to store the generated prime number.
+ * @param bit_size The target bit size of the prime.
+ * @param cores_num The number of threads to use for parallel processing.
+ * @return 1 if a prime is found, 0 otherwise.
+ */
+int vx_random_prime(mpz_t p, int bit_size, int cores_num)
+{
+    bit_size = MAX(bit_size, 10);
 
-    // Fork child processes.
-    for (int i = 0; i < cores_num; i++)
-    {
-        pid_t pid = fork();
-        if (pid < 0)
-        {
-            log_error("Failed to fork process %d in vy_random_prime", i);
-            continue; // Skip this fork failure and continue creating other forks
-        }
-        else if (pid == 0)
-        {
-            // Child process: close the read-end.
-            close(fd[0]);
+    // 1. Share the prebuilt iZm of the size class; each worker only builds its own offsets
+    RANDOM_PRIME_JOB job = {.bit_size = bit_size, .iZm = random_prime_iZm(bit_size), .p = p};
+    atomic_init(&job.found, 0);
 
-            mpz_t local_p; // local prime candidate
-            mpz_init(local_p);
+    // 2. Race cores_num threads for the first prime (one search runs in-process)
+    return random_prime_threads(&job, cores_num);
+}
 
-            // Search for a candidate prime
-            found = vy_search_prime(local_p, 0, vx);
+/**
+ * @ingroup iz_api
+ * @brief Generates a random prime meeting a constraint spec using the vx_search_prime_constrained routine.
+ *
+ * Description: This function generates a random prime of a given bit size whose
+ * top bits, residue class and coprimality of p - 1 to an exponent e are fixed by
+ * @p cons (e.g. RSA: top_bits = 2, e = 65537). The constraints shape the line,
+ * x-progression, sieve and start of the search, so every tested candidate
+ * already satisfies them. With @p cores_num > 1 the search races threads as in
+ * vx_random_prime().
+ *
+ * @param p The mpz_t variable to store the generated prime number.
+ * @param bit_size The target bit size of the prime.
+ * @param cons Constraints (NULL for none).
+ * @param cores_num The number of threads to use for parallel processing.
+ * @return 1 if a prime is found, 0 otherwise (including unsatisfiable constraints).
+ */
+int vx_random_prime_constrained(mpz_t p, int bit_size, const IZ_PRIME_CONSTRAINTS *cons, int cores_num)
+{
+    bit_size = MAX(bit_size, 10);
 
-            // If a candidate is found, send it via the pipe.
-            if (found)
-            {
-                char *p_str = mpz_get_str(NULL, 10, local_p);
-                if (p_str)
-                {
-                    size_t p_cap = (size_t)bit_size + PRIME_STR_CAP_PADDING;
-                    size_t p_len = strnlen(p_str, p_cap + 1);
-                    if (p_len > p_cap || !write_all_bytes(fd[1], p_str, p_len + 1))
-                        log_warn("Failed to write prime candidate from child process in vy_random_prime");
-                    free(p_str);
-                }
-            }
-            mpz_clear(local_p);
+    // 1. Share the prebuilt iZm of the size class; no constraints still take the constrained search
+    IZ_PRIME_CONSTRAINTS none = {0};
+    RANDOM_PRIME_JOB job = {.bit_size = bit_size, .iZm = random_prime_iZm(bit_size), .cons = cons ? cons : &none, .p = p};
+    atomic_init(&job.found, 0);
 
-            close(fd[1]); // Close the write-end.
-            exit(0);
-        }
-        else
-        {
-            // Parent process saves child's PID.
-            pids[i] = pid;
-            forks_created++;
-        }
+    // 2. Race cores_num threads for the first prime (one search runs in-process)
+    return random_prime_threads(&job, cores_num);
+}
+
+/**
+ * @ingroup iz_api
+ * @brief Generates a random safe prime using the vx_search_safe_prime_ctx routine.
+ *
+ * Description: This function generates a random safe prime p = 2s + 1 of a given
+ * bit size, where s is a Sophie Germain prime, by sieving s and 2s + 1 jointly
+ * over iZm segments. With @p cores_num > 1 the search races threads as in
+ * vx_random_prime(). The generated prime is stored in the provided mpz_t p
+ * variable; (p - 1) / 2 is its Sophie Germain prime.
+ *
+ * @param p The mpz_t variable to store the generated safe prime.
+ * @param bit_size The target bit size of the safe prime.
+ * @param cores_num The number of threads to use for parallel processing.
+ * @return 1 if a safe prime is found, 0 otherwise.
+ */
+int vx_random_safe_prime(mpz_t p, int bit_size, int cores_num)
+{
+    bit_size = MAX(bit_size, 10);
+
+    // 1. Share iZmX: deeper root primes pay off twice, as they sieve s and 2s + 1
+    RANDOM_PRIME_JOB job = {.bit_size = bit_size, .iZm = iZmX, .safe = 1, .p = p};
+    atomic_init(&job.found, 0);
+
+    // 2. Race cores_num threads for the first safe prime (one search runs in-process)
+    return random_prime_threads(&job, cores_num);
+}
+
+/**
+ * @brief Shared state of an iZ_random_primes() batch.
+ *
+ * The IZM is the shared one of vx_random_prime() and only read by the workers; each
+ * worker keeps one VX_SEARCH_CTX alive and claims output slots until the
+ * batch is exhausted.
+ */
+typedef struct
+{
+    IZM *iZm;         /**< Shared read-only assets for the batch vx. */
+    mpz_t *out;       /**< Output primes (caller-initialized). */
+    int count;        /**< Number of output slots. */
+    int bit_size;     /**< Target bit size. */
+    atomic_int next;  /**< Next unclaimed output slot. */
+    atomic_int found; /**< Number of primes stored. */
+} RANDOM_PRIMES_BATCH;
+
+/**
+ * @brief Worker thread of iZ_random_primes().
+ * @param arg Shared RANDOM_PRIMES_BATCH.
+ * @return NULL.
+ */
+static void *random_primes_worker(void *arg)
+{
+    RANDOM_PRIMES_BATCH *batch = arg;
+
+    VX_SEARCH_CTX *ctx = vx_search_ctx_init_with_iZm(batch->iZm);
+    if (!ctx)
+    {
+        log_error("Failed to initialize search context in random_primes_worker");
+        return NULL;
     }
 
-    // 4. Parent reads first result from the pipe.
-    close(fd[1]); // Close the write-end.
+    for (;;)
+    {
+        int i = atomic_fetch_add(&batch->next, 1);
+        if (i >= batch->count)
+            break;
+
+        if (vx_search_prime_ctx(ctx, batch->out[i], 0, batch->bit_size))
+            atomic_fetch_add(&batch->found, 1);
+    }
 
-    if (forks_created == 0)
+    vx_search_ctx_free(&ctx);
+    return NULL;
+}
+
+/**
+ * @ingroup iz_api
+ * @brief Generates a batch of random primes with one shared search setup.
+ *
+ * Description: The iZm assets (root primes, pre-sieved bases, word patterns)
+ * for the bit size are built once per process. Each of the @p threads workers then keeps
+ * one search context with its own seeded random state for the whole batch and
+ * claims output slots until all @p count primes are generated, so per-prime
+ * cost is the search itself. Slots are filled with independent primes in the
+ * order they are claimed.
+ *
+ * @param out Array of @p count initialized mpz_t values receiving the primes.
+ * @param count Number of primes to generate.
+ * @param bit_size The target bit size of the primes (>= IZ_RANDOM_PRIMES_MIN_BITS).
+ * @param threads The number of worker threads (capped at count and RANDOM_PRIME_THREADS_MAX).
+ * @param primes_per_sec Optional output: generation throughput of the batch.
+ * @return The number of primes generated (count on success, 0 on invalid input).
+ */
+int iZ_random_primes(mpz_t *out, int count, int bit_size, int threads, double *primes_per_sec)
+{
+    assert((out || count <= 0) && "out cannot be NULL in iZ_random_primes.");
+
+    if (primes_per_sec)
+        *primes_per_sec = 0.0;
+    if (count <= 0)
+        return 0;
+
+    // smaller sizes would still start the search past the first vx segment
+    if (bit_size < IZ_RANDOM_PRIMES_MIN_BITS)
     {
-        log_error("No child processes were created in vy_random_prime, falling back to in-process search");
-        close(fd[0]);
-        found = vy_search_prime(p, 0, vx);
-        mpz_clear(vx);
-        return found;
+        log_error("iZ_random_primes: bit_size %d is below %d.", bit_size, IZ_RANDOM_PRIMES_MIN_BITS);
+        return 0;
     }
 
-    // Allocate a sufficiently large buffer to hold the prime string + null terminator
-    // bit_size * 0.302 is approx digits, add extra padding for safety
-    size_t buf_size = (size_t)(bit_size * 0.4);
-    char *buf = malloc(buf_size);
-    if (!buf)
+    threads = MAX(1, MIN(MIN(threads, count), RANDOM_PRIME_THREADS_MAX));
+
+    STOPWATCH sw;
+    sw_start(&sw);
+
+    // 1. Share the prebuilt search assets, as in vx_random_prime
+    RANDOM_PRIMES_BATCH batch = {.out = out, .count = count, .bit_size = bit_size, .iZm = random_prime_iZm(bit_size)};
+    atomic_init(&batch.next, 0);
+    atomic_init(&batch.found, 0);
+
+    // 2. Run the workers; a single worker runs on the calling thread
+    if (threads < 2)
     {
-        log_error("Failed to allocate buffer in vy_random_prime");
-        found = 0;
+        random_primes_worker(&batch);
     }
     else
     {
-        ssize_t n = read(fd[0], buf, buf_size - 1);
-        if (n == -1)
-        {
-            log_error("Failed to read from pipe in vx_random_prime");
-            found = 0;
-        }
-        else if (n > 0)
+        pthread_t tids[threads];
+        int threads_created = 0;
+
+        for (int i = 0; i < threads; i++)
         {
-            buf[n] = '\0'; // Ensure null-termination
-            if (mpz_set_str(p, buf, 10) == 0)
-            {
-                found = 1;
-            }
-            else
+            if (pthread_create(&tids[threads_created], NULL, random_primes_worker, &batch) != 0)
             {
-                log_error("Failed to set prime from buffer in vx_random_prime");
-                found = 0;
+                log_error("Failed to create thread %d in iZ_random_primes", i);
+                continue;
             }
+            threads_created++;
         }
-        free(buf);
-    }
-    close(fd[0]); // Close the read-end of the pipe.
 
-    // 5. Terminate all child processes
-    for (int i = 0; i < forks_created; i++)
-    {
-        kill(pids[i], SIGTERM);    // Terminate child process
-        waitpid(pids[i], NULL, 0); // Wait for child process to terminate
+        if (threads_created == 0)
+            random_primes_worker(&batch);
+
+        for (int i = 0; i < threads_created; i++)
+            pthread_join(tids[i], NULL);
     }
 
-    mpz_clear(vx);
+    // 3. Report the batch throughput
+    sw_stop(&sw);
+    int found = atomic_load(&batch.found);
+    if (primes_per_sec && sw.elapsed_sec > 0.0)
+        *primes_per_sec = found / sw.elapsed_sec;
 
     return found;
-#endif
 }
 
+/** Deepest window sieving used by iZ_next_prime() (bounds a cached state to ~34 MB). */
+#define NEXT_PRIME_DEPTH_MAX (1ULL << 24)
+
+/** Power-of-two depth classes of the window sieving states (2^k for k < 26). */
+#define NEXT_PRIME_DEPTH_CLASSES 26
+
+// Window sieving states per power-of-two depth, built on first use and cloned per query
+static VX_SIEVE_STATE *next_prime_states[NEXT_PRIME_DEPTH_CLASSES];
+static pthread_mutex_t next_prime_states_lock = PTHREAD_MUTEX_INITIALIZER;
+
 /**
- * @ingroup iz_api
- * @brief Generates a random prime candidate using the vx_search_prime routine.
+ * @brief Depth class of the window sieving state for bases near @p bit_size bits.
  *
- * Description: This function generates a random prime of a given bit size using the vx_search_prime routine.
- * It initializes the random base and sets up the search parameters. The function also allows
- * for parallel processing of the search using multiple child processes. The generated prime
- * is stored in the provided mpz_t p variable.
+ * The depth balances sieving against Miller-Rabin over about four expected
+ * prime gaps (bit_size columns) and is rounded up to a power of two, so nearby
+ * sizes share one class.
  *
- * @param p The mpz_t variable to store the generated prime number.
- * @param bit_size The target bit size of the prime.
- * @param cores_num The number of cores to use for parallel processing.
- * @return 1 if a prime is found, 0 otherwise.
+ * @param bit_size Bit size of the bases to search from.
+ * @return k such that the state sieves up to 2^k.
  */
-int vx_random_prime(mpz_t p, int bit_size, int cores_num)
+static int next_prime_depth_class(int bit_size)
 {
-    int found = 0;
-    bit_size = MAX(bit_size, 10);
-    int vx = bit_size <= 2048 ? VX5 : VX6;
+    uint64_t depth = MIN(iZ_auto_sieve_depth(iZmW->vx, bit_size, (uint64_t)bit_size), NEXT_PRIME_DEPTH_MAX);
+    int k = 0;
+    while ((1ULL << k) < depth)
+        k++;
+    return k;
+}
 
-    // 2. If < 2 cores, run the search in-process
-    if (cores_num < 2)
-    {
-        found = vx_search_prime(p, 0, vx, bit_size);
-        return found;
-    }
+/**
+ * @brief Clone the window sieving state for next-prime searches near @p bit_size bits.
+ *
+ * One state is cached per next_prime_depth_class(). Building a deep state
+ * generates its primes; cloning it only copies them.
+ *
+ * @param bit_size Bit size of the bases to search from.
+ * @return Unsynced state for iZmW, or NULL on allocation failure.
+ */
+static VX_SIEVE_STATE *next_prime_state(int bit_size)
+{
+    int k = next_prime_depth_class(bit_size);
 
-#if !IZ_PLATFORM_HAS_FORK
-    log_info("vx_random_prime: multi-process mode is unavailable on this platform; using single-process mode.");
-    found = vx_search_prime(p, 0, vx, bit_size);
-    return found;
-#else
-    // 3. Multi-core: fork processes
-    int fd[2];
-    if (pipe(fd) == -1)
+    pthread_mutex_lock(&next_prime_states_lock);
+    if (!next_prime_states[k])
+        next_prime_states[k] = vx_state_init_depth(iZmW, 1ULL << k);
+    VX_SIEVE_STATE *shared = next_prime_states[k];
+    pthread_mutex_unlock(&next_prime_states_lock);
+
+    // cached states are never modified once built, so cloning needs no lock
+    return shared ? vx_state_clone(shared) : NULL;
+}
+
+// Destructor to release the cached window states and the global iZm instances
+__attribute__((destructor)) static void free_iZmX(void)
+{
+    for (int k = 0; k < NEXT_PRIME_DEPTH_CLASSES; k++)
+        vx_state_free(&next_prime_states[k]);
+
+    iZm_free(&iZmR);
+    iZm_free(&iZmW);
+    iZm_free(&iZmX);
+}
+
+/**
+ * @brief Create a resettable VX4 window segment for next-prime searches near @p bit_size bits.
+ *
+ * The segment owns a clone of the cached window state from next_prime_state(),
+ * so one segment serves every window of a query (or every base of a worker).
+ *
+ * @param bit_size Bit size of the bases to search from.
+ * @return Segment for iZmW, or NULL on allocation failure.
+ */
+static VX_SEG *next_prime_seg(int bit_size)
+{
+    VX_SEG *seg = vx_create(iZmW, 0);
+    if (!seg)
+        return NULL;
+
+    VX_SIEVE_STATE *state = next_prime_state(bit_size);
+    if (!state || !vx_set_sieve_state(seg, state))
     {
-        log_error("Failed to create pipe in vx_random_prime. Falling back to in-process search.");
-        found = vx_search_prime(p, 0, vx, bit_size);
-        return found;
+        log_error("Failed to set up the window sieving state in next_prime_seg");
+        vx_state_free(&state);
+        vx_free(&seg);
+        return NULL;
     }
 
-    pid_t pids[cores_num];
-    int forks_created = 0;
+    return seg;
+}
 
-    for (int i = 0; i < cores_num; i++)
-    {
-        pid_t pid = fork();
-        if (pid < 0)
-        {
-            log_error("Failed to fork process %d in vx_random_prime", i);
-            continue;
-        }
-        else if (pid == 0)
-        {
-            // CHILD PROCESS: Initialize everything fresh
-            close(fd[0]);
+/**
+ * @brief Find the first prime in consecutive sieved VX4 windows from column @p x_p.
+ *
+ * Each window re-targets @p seg with vx_reset(), sieving it by every prime
+ * tracked in its state; only the survivors are tested with test_primality(),
+ * in order of distance from x_p. Forward walks reuse the carried offsets
+ * from one window to the next.
+ *
+ * @param p Output prime.
+ * @param x_p First column to test (both of its candidates are admissible).
+ * @param forward Non-zero to walk up from x_p, 0 to walk down.
+ * @param seg Window segment from next_prime_seg().
+ * @return 1 if a prime was found, 0 otherwise.
+ */
+static int iZ_next_prime_window(mpz_t p, mpz_t x_p, int forward, VX_SEG *seg)
+{
+    int vx = iZmW->vx;
+    int found = 0;
+
+    // locate x_p = y * vx + x with x in [1, vx]
+    mpz_t y;
+    mpz_init(y);
+    mpz_sub_ui(y, x_p, 1);
+    int x = (int)mpz_fdiv_q_ui(y, y, vx) + 1;
 
-            // Search for prime with child's own objects
-            mpz_t local_p;
-            mpz_init(local_p);
-            int child_found = vx_search_prime(local_p, 0, vx, bit_size);
+    // within a column 6x - 1 comes before 6x + 1, so backward scans test x7 first
+    const int m_ids[2] = {forward ? -1 : 1, forward ? 1 : -1};
 
-            if (child_found)
+    while (!found && mpz_sgn(y) > 0)
+    {
+        if (!vx_reset(seg, y, forward ? x : 1, forward ? vx : x))
+            break;
+
+        for (; !found && x >= 1 && x <= vx; x += forward ? 1 : -1)
+        {
+            for (int j = 0; j < 2 && !found; j++)
             {
-                char *p_str = mpz_get_str(NULL, 10, local_p);
-                if (p_str != NULL)
+                BITMAP *line = (m_ids[j] == -1) ? seg->x5 : seg->x7;
+                if (bitmap_get_bit(line, x))
                 {
-                    size_t p_cap = (size_t)bit_size + PRIME_STR_CAP_PADDING;
-                    size_t p_len = strnlen(p_str, p_cap + 1);
-                    if (p_len > p_cap || !write_all_bytes(fd[1], p_str, p_len + 1))
-                        log_warn("Failed to write prime candidate from child process in vx_random_prime");
-                    free(p_str);
+                    mpz_add_ui(p, seg->yvx, x);
+                    iZ_mpz(p, p, m_ids[j]);
+                    found = test_primality(p, MR_ROUNDS);
                 }
             }
+        }
 
-            // Cleanup child resources
-            mpz_clear(local_p);
-            close(fd[1]);
-            exit(0);
+        if (forward)
+        {
+            mpz_add_ui(y, y, 1);
+            x = 1;
         }
         else
         {
-            pids[i] = pid;
-            forks_created++;
+            mpz_sub_ui(y, y, 1);
+            x = vx;
         }
     }
 
-    // 4. Parent process reads result
-    close(fd[1]);
+    mpz_clear(y);
+    return found;
+}
+
+/**
+ * @brief GMP-free iZ_next_prime() for bases whose search stays within 64 bits.
+ *
+ * Walks the 6x +/- 1 candidates away from @p base, skipping those cleared in
+ * the pre-sieved iZmX base bitmaps, and settles each with test_primality_u64().
+ *
+ * @param p Output prime.
+ * @param base Starting value (>= vx).
+ * @param forward Non-zero to search forward, 0 to search backward.
+ * @return 1 if a prime was found, 0 when the search would leave 64 bits.
+ */
+static int iZ_next_prime_u64(uint64_t *p, uint64_t base, int forward)
+{
+    const uint64_t x_max = (UINT64_MAX - 1) / 6; // largest x with iZ(x, 1) < 2^64
+    uint64_t vx = iZmX->vx;
+    uint64_t r = base % 6;
+    uint64_t x = base / 6;
 
-    if (forks_created == 0)
+    // * 1. Candidates sharing x with base: 6x + 1 ahead of it, 6x - 1 behind it
+    if (forward && r == 0 && test_primality_u64(base + 1))
     {
-        log_error("No child processes were created in vx_random_prime, falling back to in-process search");
-        close(fd[0]);
-        // fallback to in-process search
-        found = vx_search_prime(p, 0, vx, bit_size);
-        return found;
+        *p = base + 1;
+        return 1;
     }
-
-    // Allocate a sufficiently large buffer to hold the prime string + null terminator
-    size_t buf_size = (size_t)(bit_size * 0.4);
-    char *buf = malloc(buf_size);
-    if (!buf)
+    if (forward && r == 5 && x + 1 <= x_max && test_primality_u64(base + 2))
     {
-        log_error("Failed to allocate buffer in vx_random_prime");
-        found = 0;
+        *p = base + 2;
+        return 1;
     }
-    else
+    if (!forward && r <= 1 && test_primality_u64(iZ(x, -1)))
     {
-        ssize_t n = read(fd[0], buf, buf_size - 1);
-        if (n > 0)
+        *p = iZ(x, -1);
+        return 1;
+    }
+
+    // * 2. Scan whole x columns, skipping multiples of the vx wheel primes
+    x = forward ? x + (r == 5 ? 2 : 1) : x - (r <= 1 ? 1 : 0);
+    uint64_t col = (x - 1) % vx + 1; // column of x in the base bitmaps
+
+    // within a column 6x - 1 comes before 6x + 1, so backward scans test x7 first
+    const int m_ids[2] = {forward ? -1 : 1, forward ? 1 : -1};
+
+    while (x <= x_max)
+    {
+        for (int j = 0; j < 2; j++)
         {
-            buf[n] = '\0'; // Ensure null-termination
-            if (mpz_set_str(p, buf, 10) == 0)
+            int m_id = m_ids[j];
+            BITMAP *base_line = (m_id == -1) ? iZmX->base_x5 : iZmX->base_x7;
+            if (bitmap_get_bit(base_line, col) && test_primality_u64(iZ(x, m_id)))
             {
-                found = 1;
-            }
-            else
-            {
-                log_error("Failed to set prime from buffer in vx_random_prime");
-                found = 0;
+                *p = iZ(x, m_id);
+                return 1;
             }
         }
-        free(buf);
-    }
-
-    close(fd[0]); // Close the read-end of the pipe.
 
-    // Terminate children
-    for (int i = 0; i < forks_created; i++)
-    {
-        kill(pids[i], SIGTERM);
-        waitpid(pids[i], NULL, 0);
+        if (forward)
+        {
+            x++;
+            col = (col == vx) ? 1 : col + 1;
+        }
+        else
+        {
+            x--;
+            col = (col == 1) ? vx : col - 1;
+        }
     }
 
-    return found;
-#endif
+    return 0;
 }
 
 /**
- * @ingroup iz_api
- * @brief Find the next prime number after a given base.
- *
- * Description: This function searches for the next/previous prime number after a given base using the iZ framework.
- *
- * @param p The mpz_t variable to store the found prime number.
- * @param base The base number to start the search from.
- * @param forward If true, search for the next prime; if false, search for the previous prime.
+ * @brief iZ_next_prime() with the window sieving state supplied by the caller.
+ * @param p Output prime.
+ * @param base Starting value.
+ * @param forward Non-zero to search forward, 0 to search backward.
+ * @param seg Window segment from next_prime_seg(), or NULL to create one for this call.
  * @return 1 if a prime is found, 0 otherwise.
  */
-int iZ_next_prime(mpz_t p, mpz_t base, int forward)
+static int iZ_next_prime_with(mpz_t p, mpz_t base, int forward, VX_SEG *seg)
 {
     // 1. Initialization
     int found = 0; // flag to indicate if a prime was found
@@ -930,15 +1258,43 @@ int iZ_next_prime(mpz_t p, mpz_t base, int forward)
             }
         }
 
+        mpz_clear(z);
         return found;
     }
 
+    // Bases whose search stays below 2^64 are handled without GMP
+    if (mpz_sizeinbase(base, 2) <= 64)
+    {
+        uint64_t prime = 0;
+        if (iZ_next_prime_u64(&prime, mpz_get_ui(base), forward))
+        {
+            mpz_set_ui(p, prime);
+            mpz_clear(z);
+            return 1;
+        }
+    }
+
     // Edge cases 2:
+    // if base = 6x, 6x + 1 is the next candidate forward and 6x - 1 the previous one
+    if (mpz_fdiv_ui(z, 6) == 0)
+    {
+        if (forward)
+            mpz_add_ui(z, z, 1);
+        else
+            mpz_sub_ui(z, z, 1);
+        if (test_primality(z, MR_ROUNDS))
+        {
+            mpz_set(p, z);
+            mpz_clear(z);
+            return 1;
+        }
+    }
+
     // if forward and base is iZ-, check next iZ+
     if (mpz_fdiv_ui(z, 6) == 5 && forward)
     {
         mpz_add_ui(z, z, 2); // increment tmp by 2
-        if (mpz_probab_prime_p(z, MR_ROUNDS))
+        if (test_primality(z, MR_ROUNDS))
         {
             mpz_set(p, z); // set p = tmp + 2
             mpz_clear(z);
@@ -951,7 +1307,7 @@ int iZ_next_prime(mpz_t p, mpz_t base, int forward)
     if (mpz_fdiv_ui(z, 6) == 1 && !forward)
     {
         mpz_sub_ui(z, z, 2); // decrement tmp by 2
-        if (mpz_probab_prime_p(z, MR_ROUNDS))
+        if (test_primality(z, MR_ROUNDS))
         {
             mpz_set(p, z); // set p = tmp - 2
             mpz_clear(z);
@@ -959,107 +1315,162 @@ int iZ_next_prime(mpz_t p, mpz_t base, int forward)
         }
     }
 
-    // Initialize and set y and yvx
-    mpz_t y, yvx, x_p;
-    mpz_init(y);
-    mpz_init(yvx);
+    // first x with candidates left: past base's x forward (past 6x + 7 for base = 6x + 5),
+    // base's x backward unless its 6x - 1 was checked above
+    mpz_t x_p;
     mpz_init(x_p);
+    unsigned long r = mpz_fdiv_ui(base, 6);
+    mpz_fdiv_q_ui(x_p, base, 6);
+    if (forward)
+        mpz_add_ui(x_p, x_p, (r == 5) ? 2 : 1);
+    else if (r <= 1)
+        mpz_sub_ui(x_p, x_p, 1);
+
+    // 2. Sieve windows from x_p deeply, so that few candidates reach the primality test
+    VX_SEG *own_seg = seg ? NULL : next_prime_seg((int)mpz_sizeinbase(base, 2));
+    if (seg || own_seg)
+        found = iZ_next_prime_window(z, x_p, forward, seg ? seg : own_seg);
 
-    mpz_div_ui(y, base, 6 * vx); // compute y = base / 6 * vx
-    mpz_mul_ui(yvx, y, vx);      // compute yvx = y * vx
-    mpz_div_ui(x_p, z, 6);       // compute x_p = z / 6
-
-    // 2. Iterate over the x5 and x7 bitmaps to find a prime
-    // set start_x = x_p % vx +/- 1
-    int step = forward ? 1 : -1;
-    int start_x = mpz_fdiv_ui(x_p, vx) + step;
-    int end_x = forward ? vx : 1;
+    // 3. Set the found prime
+    if (found)
+        mpz_set(p, z); // set p = tmp
+    else
+        log_debug("No prime found :/");
 
-    int i = 0; // segment counter
+    // cleanup
+    vx_free(&own_seg);
+    mpz_clears(x_p, z, NULL);
 
-    while (!found)
-    {
-        if (forward)
-        {
-            if (i > 0)
-                start_x = 1; // start from the beginning of the bitmap
+    return found;
+}
 
-            for (int x = start_x; x <= end_x; x++)
-            {
-                // check if x5[x] is set
-                if (bitmap_get_bit(iZmX->base_x5, x))
-                {
-                    mpz_add_ui(x_p, yvx, x); // set x_p = yvx + x
-                    iZ_mpz(z, x_p, -1);      // compute p = iZ(x_p, -1)
-                    // check if tmp is prime
-                    found = mpz_probab_prime_p(z, MR_ROUNDS);
+/**
+ * @ingroup iz_api
+ * @brief Find the next prime number after a given base.
+ *
+ * Description: This function searches for the next/previous prime number after a given base using the iZ framework.
+ * Bases past 64 bits are sieved in VX4 windows up to a depth chosen for their size before Miller-Rabin.
+ *
+ * @param p The mpz_t variable to store the found prime number.
+ * @param base The base number to start the search from.
+ * @param forward If true, search for the next prime; if false, search for the previous prime.
+ * @return 1 if a prime is found, 0 otherwise.
+ */
+int iZ_next_prime(mpz_t p, mpz_t base, int forward)
+{
+    return iZ_next_prime_with(p, base, forward, NULL);
+}
 
-                    if (found)
-                        break;
-                }
+/**
+ * @brief Shared work queue of iZ_next_prime_batch().
+ */
+typedef struct
+{
+    mpz_t *out;       /**< Output slots, one per base. */
+    mpz_t *bases;     /**< Bases to search from. */
+    int count;        /**< Number of bases. */
+    int forward;      /**< Search direction. */
+    atomic_int next;  /**< Next base to claim. */
+    atomic_int found; /**< Bases resolved so far. */
+} NEXT_PRIME_BATCH;
 
-                // check if x7[x] is set
-                if (bitmap_get_bit(iZmX->base_x7, x))
-                {
-                    mpz_add_ui(x_p, yvx, x); // set x_p = yvx + x
-                    iZ_mpz(z, x_p, 1);       // compute tmp = iZ(x_p, 1)
-                    // check if tmp is prime
-                    found = mpz_probab_prime_p(z, MR_ROUNDS);
+/**
+ * @brief Worker thread of iZ_next_prime_batch().
+ * @param arg Shared NEXT_PRIME_BATCH.
+ * @return NULL.
+ */
+static void *next_prime_batch_worker(void *arg)
+{
+    NEXT_PRIME_BATCH *batch = arg;
 
-                    if (found)
-                        break;
-                }
-            }
+    // one window segment per depth class, built on first use and re-targeted at each base
+    VX_SEG *segs[NEXT_PRIME_DEPTH_CLASSES] = {NULL};
 
-            mpz_add_ui(yvx, yvx, vx); // increment yvx by vx for next segment
-        }
-        else // backward search
+    for (;;)
+    {
+        int i = atomic_fetch_add(&batch->next, 1);
+        if (i >= batch->count)
+            break;
+
+        // 64-bit bases are settled without windows
+        VX_SEG *seg = NULL;
+        int bit_size = (int)mpz_sizeinbase(batch->bases[i], 2);
+        if (bit_size > 64)
         {
-            if (i > 0)
-                start_x = vx; // start from the end of the bitmaps
+            int k = next_prime_depth_class(bit_size);
+            if (!segs[k])
+                segs[k] = next_prime_seg(bit_size);
+            seg = segs[k];
+        }
 
-            // check iZ+ first if backward
-            for (int x = start_x; x >= end_x; x--)
-            {
-                // check if x7[x] is set
-                if (bitmap_get_bit(iZmX->base_x7, x))
-                {
-                    mpz_add_ui(x_p, yvx, x); // set x_p = yvx + x
-                    iZ_mpz(z, x_p, 1);       // compute tmp = iZ(x_p, 1)
-                    // check if tmp is prime
-                    found = mpz_probab_prime_p(z, MR_ROUNDS);
+        if (iZ_next_prime_with(batch->out[i], batch->bases[i], batch->forward, seg))
+            atomic_fetch_add(&batch->found, 1);
+    }
 
-                    if (found)
-                        break;
-                }
+    for (int k = 0; k < NEXT_PRIME_DEPTH_CLASSES; k++)
+        vx_free(&segs[k]);
+    return NULL;
+}
 
-                // check iZ-
-                if (bitmap_get_bit(iZmX->base_x5, x))
-                {
-                    mpz_add_ui(x_p, yvx, x); // set x_p = yvx + x
-                    iZ_mpz(z, x_p, -1);      // compute p = iZ(x_p, -1)
-                    // check if tmp is prime
-                    found = mpz_probab_prime_p(z, MR_ROUNDS);
+/**
+ * @ingroup iz_api
+ * @brief Find the next (or previous) prime of every base in a batch.
+ *
+ * Description: Each of the @p threads workers claims bases until the batch is
+ * done, keeping one window segment per sieving depth class it meets, with the
+ * state cloned from the shared cache, so every base is sieved to the depth
+ * of its own size. Per base, only the offset solve of the new window and its
+ * surviving candidates are paid for.
+ *
+ * @param out Array of @p count initialized mpz_t values; out[i] receives the prime of bases[i].
+ * @param bases Array of @p count bases.
+ * @param count Number of bases.
+ * @param forward If true, search for the next primes; if false, for the previous ones.
+ * @param threads The number of worker threads (capped at count).
+ * @return The number of bases resolved (count on success).
+ */
+int iZ_next_prime_batch(mpz_t *out, mpz_t *bases, int count, int forward, int threads)
+{
+    assert(((out && bases) || count <= 0) && "out and bases cannot be NULL in iZ_next_prime_batch.");
 
-                    if (found)
-                        break;
-                }
-            }
+    if (count <= 0)
+        return 0;
 
-            mpz_sub_ui(yvx, yvx, vx); // decrement yvx by vx for next segment
-        }
+    threads = MIN(MAX(threads, 1), count);
 
-        i++; // increment segment counter
-    }
+    // 1. Shared work queue; workers pick each base's window depth themselves
+    NEXT_PRIME_BATCH batch = {.out = out, .bases = bases, .count = count, .forward = forward};
+    atomic_init(&batch.next, 0);
+    atomic_init(&batch.found, 0);
 
-    // 3. Set the found prime
-    if (found)
-        mpz_set(p, z); // set p = tmp
+    // 2. Run the workers; a single worker runs on the calling thread
+    if (threads < 2)
+    {
+        next_prime_batch_worker(&batch);
+    }
     else
-        log_debug("No prime found :/");
+    {
+        // the pool has the requested size, so its handles live on the heap
+        pthread_t *tids = malloc(threads * sizeof(pthread_t));
+        int threads_created = 0;
 
-    // cleanup
-    mpz_clears(y, yvx, x_p, z, NULL);
+        for (int i = 0; tids && i < threads; i++)
+        {
+            if (pthread_create(&tids[threads_created], NULL, next_prime_batch_worker, &batch) != 0)
+            {
+                log_error("Failed to create thread %d in iZ_next_prime_batch", i);
+                continue;
+            }
+            threads_created++;
+        }
 
-    return found;
+        if (threads_created == 0)
+            next_prime_batch_worker(&batch);
+
+        for (int i = 0; i < threads_created; i++)
+            pthread_join(tids[i], NULL);
+        free(tids);
+    }
+
+    return atomic_load(&batch.found);
 }
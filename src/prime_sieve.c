@@ -4,13 +4,15 @@
  *
  * This file contains the implementations of various prime sieving algorithms, including
  * classical algorithms (SoE/SSoE/SoEu/SoS/SoA) as well as SiZ-family algorithms
- * (SiZ/SiZm/SiZm_vy). All functions are single-threaded, take an upper limit `n` and
- * return a pointer to a UI64_ARRAY containing the prime numbers up to `n`.
+ * (SiZ/SiZm/SiZm_vy). All functions take an upper limit `n` and return a pointer to a
+ * UI64_ARRAY containing the prime numbers up to `n`; they are single-threaded except
+ * SiZm_mt, which splits SiZm's segments across pthreads.
  *
  * @ingroup iz_api
  */
 
 #include <iZ_api.h>
+#include <pthread.h>
 
 // ==================================================================
 // * Internal helper macros:
@@ -354,13 +356,11 @@ UI64_ARRAY *SSoS(uint64_t n)
             bitmap_clear_steps_simd(sieve, p, x0, x_limit + 1);
         }
 
-        for (int x = k / 2; x <= x_limit; x++)
+        for (size_t x = bitmap_next_set_bit(sieve, k / 2, x_limit); x != BITMAP_NPOS;
+             x = bitmap_next_set_bit(sieve, x + 1, x_limit))
         {
-            if (bitmap_get_bit(sieve, x))
-            {
-                uint64_t p = 2 * (yvx + x) + 1;
-                ui64_push(primes, p);
-            }
+            uint64_t p = 2 * (yvx + x) + 1;
+            ui64_push(primes, p);
         }
         yvx += vx;
     }
@@ -633,6 +633,146 @@ UI64_ARRAY *SiZ(uint64_t n)
     return primes;
 }
 
+/**
+ * @brief Read-only wheel data shared by every SiZm segment (and every SiZm_mt worker).
+ */
+typedef struct
+{
+    int vx;                        /**< Segment width. */
+    int k;                         /**< Wheel primes (dividing 6 * vx) leading the root list. */
+    const BITMAP *base_x5;         /**< Pre-sieved base segment for 6x-1. */
+    const BITMAP *base_x7;         /**< Pre-sieved base segment for 6x+1. */
+    const BITMAP_PATTERN *pattern; /**< Word masks for the densest root primes past the wheel. */
+    const IZM_ROOTS *roots;        /**< Solver constants of the step-cleared root primes (index-aligned). */
+} SIZM_WHEEL;
+
+/**
+ * @brief Per-thread scratch for sieving SiZm segments.
+ */
+typedef struct
+{
+    BITMAP *x5;                                  /**< Active 6x-1 bitmap. */
+    BITMAP *x7;                                  /**< Active 6x+1 bitmap. */
+    VX_BUCKETS *buckets;                         /**< Bucket ring for root primes > vx, or NULL. */
+    int bucket_idx;                              /**< Next root prime to enter the buckets. */
+    uint64_t x5_starts[BITMAP_PATTERN_MAX_COUNT]; /**< Pattern starts on the 6x-1 line. */
+    uint64_t x7_starts[BITMAP_PATTERN_MAX_COUNT]; /**< Pattern starts on the 6x+1 line. */
+} SIZM_SCRATCH;
+
+/**
+ * @brief Offset of the next hit of root prime @p p on line @p m_id after yvx.
+ *
+ * Hits sit at X = xp' (mod p) and the first useful one is p's square; a prime
+ * entering the buckets past its square (a worker's first segment) starts at
+ * the next X in its class instead.
+ */
+static uint64_t sizm_bucket_hit(int m_id, uint64_t p, uint64_t yvx)
+{
+    uint64_t x_sq = iZm_solve_for_x0(m_id, p, 0, 0);
+    if (x_sq > yvx)
+        return x_sq - yvx;
+
+    uint64_t xp = (p + 1) / 6;
+    int ip = (p % 6 == 1) ? 1 : -1;
+    xp = (m_id == ip) ? xp : p - xp;
+    return p - (yvx - xp) % p;
+}
+
+/**
+ * @brief Number of leading entries of the ascending @p primes that are <= @p limit.
+ */
+static int sizm_count_upto(const UI64_ARRAY *primes, uint64_t limit)
+{
+    int lo = 0, hi = primes->count;
+    while (lo < hi)
+    {
+        int mid = lo + (hi - lo) / 2;
+        if (primes->array[mid] <= limit)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * @brief Sieve SiZm segment y and append its primes to @p out in ascending order.
+ * @param wheel Shared wheel data.
+ * @param scratch Caller's scratch bitmaps, pattern starts and bucket ring.
+ * @param roots Root primes in ascending order, wheel primes first (may alias @p out).
+ * @param y Segment index (>= 1).
+ * @param x_limit Last x of the segment.
+ * @param out Output array.
+ */
+static void sizm_sieve_segment(const SIZM_WHEEL *wheel, SIZM_SCRATCH *scratch, const UI64_ARRAY *roots,
+                               uint64_t y, int x_limit, UI64_ARRAY *out)
+{
+    int vx = wheel->vx;
+    uint64_t yvx = y * vx;
+    BITMAP *x5 = scratch->x5;
+    BITMAP *x7 = scratch->x7;
+    const BITMAP_PATTERN *pattern = wheel->pattern;
+
+    // * a. Reset active bitmaps to base state
+    memcpy(x5->data, wheel->base_x5->data, x5->byte_size);
+    memcpy(x7->data, wheel->base_x7->data, x7->byte_size);
+
+    uint64_t root_limit = sqrt(6 * (yvx + x_limit)) + 1; // local root limit for current segment
+
+    // * b. Mark composites of root primes in current segment,
+    // pattern primes first with whole-word masks, then the rest step by step
+    const IZM_ROOTS *table = wheel->roots;
+    for (int i = 0; i < pattern->count; i++)
+    {
+        uint64_t p = pattern->steps[i];
+        int t = wheel->k + i; // pattern steps follow the wheel primes
+        scratch->x5_starts[i] = (p <= root_limit) ? iZm_roots_solve_for_x0(table, t, -1, y) : UINT64_MAX;
+        scratch->x7_starts[i] = (p <= root_limit) ? iZm_roots_solve_for_x0(table, t, 1, y) : UINT64_MAX;
+    }
+    bitmap_apply_pattern(x5, pattern, scratch->x5_starts, x_limit);
+    bitmap_apply_pattern(x7, pattern, scratch->x7_starts, x_limit);
+
+    for (int i = wheel->k + pattern->count; i < table->count; i++)
+    {
+        uint64_t p = table->p[i];
+        if (p > root_limit || (scratch->buckets && p > (uint64_t)vx))
+            break;
+
+        // mark composites of p in current segment
+        bitmap_clear_steps_simd(x5, p, iZm_roots_solve_for_x0(table, i, -1, y), x_limit);
+        bitmap_clear_steps_simd(x7, p, iZm_roots_solve_for_x0(table, i, 1, y), x_limit);
+    }
+
+    if (scratch->buckets)
+    {
+        // park newly active large primes at their next hit, then sieve this segment's bucket
+        while (scratch->bucket_idx < roots->count && roots->array[scratch->bucket_idx] <= root_limit)
+        {
+            uint64_t p = roots->array[scratch->bucket_idx++];
+            vx_buckets_add(scratch->buckets, p, sizm_bucket_hit(-1, p, yvx), sizm_bucket_hit(1, p, yvx));
+        }
+        vx_buckets_sieve(scratch->buckets, x5, x7, x_limit);
+    }
+
+    // * c. Collect unmarked indices as primes in current segment,
+    // merging both lines by x so that iZ- precedes iZ+ and output stays sorted
+    size_t x5_next = bitmap_next_set_bit(x5, 2, x_limit);
+    size_t x7_next = bitmap_next_set_bit(x7, 2, x_limit);
+    while (x5_next != BITMAP_NPOS || x7_next != BITMAP_NPOS)
+    {
+        if (x5_next <= x7_next) // i.e. iZ- prime
+        {
+            ui64_push(out, iZ(yvx + x5_next, -1));
+            x5_next = bitmap_next_set_bit(x5, x5_next + 1, x_limit);
+        }
+        else // i.e. iZ+ prime
+        {
+            ui64_push(out, iZ(yvx + x7_next, 1));
+            x7_next = bitmap_next_set_bit(x7, x7_next + 1, x_limit);
+        }
+    }
+}
+
 /**
  * @ingroup iz_api
  * @brief Segmented Sieve-iZm algorithm for prime generation up to n.
@@ -707,48 +847,309 @@ UI64_ARRAY *SiZm(uint64_t n)
     }
     process_iZ_bitmaps(primes, x5, x7, vx + 1);
 
+    // word masks for the densest root primes past the wheel, and solver
+    // constants for the root primes cleared step by step (those <= vx)
+    uint64_t root_max = sqrt(n) + 1;
+    BITMAP_PATTERN *pattern = iZm_construct_pattern(primes, k);
+    IZM_ROOTS *roots = iZm_roots_init(primes->array, sizm_count_upto(primes, MIN(root_max + 1, (uint64_t)vx)), vx);
+    if (!pattern || !roots)
+    {
+        ui64_free(&primes);
+        bitmap_pattern_free(&pattern);
+        iZm_roots_free(&roots);
+        bitmap_free(&x5);
+        bitmap_free(&x7);
+        bitmap_free(&base_x5);
+        bitmap_free(&base_x7);
+        return NULL;
+    }
+    SIZM_WHEEL wheel = {vx, k, base_x5, base_x7, pattern, roots};
+    SIZM_SCRATCH scratch = {.x5 = x5, .x7 = x7, .buckets = NULL, .bucket_idx = 0};
+
+    // root primes above vx hit a segment at most once per line, park them in buckets
+    if (root_max > (uint64_t)vx)
+    {
+        scratch.buckets = vx_buckets_init(vx, root_max);
+        if (!scratch.buckets)
+        {
+            ui64_free(&primes);
+            bitmap_pattern_free(&pattern);
+            iZm_roots_free(&roots);
+            bitmap_free(&x5);
+            bitmap_free(&x7);
+            bitmap_free(&base_x5);
+            bitmap_free(&base_x7);
+            return NULL;
+        }
+        // segment 0 already collected every prime up to 6 * vx
+        while (primes->array[scratch.bucket_idx] <= (uint64_t)vx)
+            scratch.bucket_idx++;
+    }
+
     // * 3. Process remaining segments (y >= 1) to collect primes:
+    // primes found so far double as the root primes of later segments
     int y_limit = x_n / vx; // number of full segments to process
-    uint64_t yvx = vx;      // current base value (y * vx)
     for (int y = 1; y <= y_limit; y++)
     {
-        // * a. Reset active bitmaps to base state
-        memcpy(x5->data, base_x5->data, x5->byte_size);
-        memcpy(x7->data, base_x7->data, x7->byte_size);
-
         int x_limit = (y < y_limit) ? vx : (int)(x_n % (uint64_t)vx); // local x limit adjusted for last segment
-        uint64_t root_limit = sqrt(6 * (yvx + x_limit)) + 1;          // local root limit for current segment
+        sizm_sieve_segment(&wheel, &scratch, primes, y, x_limit, primes);
+    }
 
-        // * b. Mark composites of root primes in current segment
-        for (int i = k; i < primes->count; i++)
-        {
-            uint64_t p = primes->array[i];
-            if (p > root_limit)
-                break;
+    // * 4. Clean up and finalize
+    vx_buckets_free(&scratch.buckets);
+    bitmap_pattern_free(&pattern);
+    iZm_roots_free(&roots);
+    bitmap_free(&x5);
+    bitmap_free(&x7);
+    bitmap_free(&base_x5);
+    bitmap_free(&base_x7);
 
-            // mark composites of p in current segment
-            bitmap_clear_steps_simd(x5, p, iZm_solve_for_x0(-1, p, vx, y), x_limit);
-            bitmap_clear_steps_simd(x7, p, iZm_solve_for_x0(1, p, vx, y), x_limit);
+    // Guard against overshoot near the final iZ lane.
+    while (primes->count > 0 && primes->array[primes->count - 1] > n)
+        ui64_pop(primes);
+
+    ui64_resize_to_fit(primes); // Trim excess memory in primes array
+    return primes;
+}
+
+/**
+ * @brief Shared job state for SiZm_mt() workers.
+ */
+typedef struct
+{
+    const SIZM_WHEEL *wheel; /**< Shared read-only wheel data. */
+    const UI64_ARRAY *roots; /**< Root primes up to sqrt(n), wheel primes first. */
+    uint64_t x_n;            /**< Last x of the range. */
+    uint64_t root_max;       /**< sqrt(n) + 1. */
+    int bucket_start;        /**< Index of the first root prime above vx. */
+    int y_limit;             /**< Last segment index. */
+    int block_size;          /**< Segments per block. */
+    int block_count;         /**< Number of blocks. */
+    UI64_ARRAY **blocks;     /**< Per-block outputs, in y order. */
+    int next_block;          /**< Next block to claim (guarded by @ref lock). */
+    int failed;              /**< Non-zero after an allocation failure (guarded by @ref lock). */
+    pthread_mutex_t lock;    /**< Guards block claiming and the failure flag. */
+} SIZM_MT_JOB;
+
+/**
+ * @brief SiZm_mt() worker: claim blocks of consecutive segments until none are left.
+ * @param arg SIZM_MT_JOB shared by all workers.
+ * @return NULL.
+ */
+static void *sizm_mt_worker(void *arg)
+{
+    SIZM_MT_JOB *job = (SIZM_MT_JOB *)arg;
+    const SIZM_WHEEL *wheel = job->wheel;
+    int vx = wheel->vx;
+
+    // private scratch bitmaps, reset from the shared base before every segment
+    SIZM_SCRATCH scratch = {.x5 = bitmap_clone((BITMAP *)wheel->base_x5), .x7 = bitmap_clone((BITMAP *)wheel->base_x7)};
+    int ok = scratch.x5 && scratch.x7;
+
+    while (ok)
+    {
+        pthread_mutex_lock(&job->lock);
+        int b = job->failed ? job->block_count : job->next_block++;
+        pthread_mutex_unlock(&job->lock);
+        if (b >= job->block_count)
+            break;
+
+        int y_start = 1 + b * job->block_size;
+        int y_end = MIN(job->y_limit, y_start + job->block_size - 1);
+
+        // size the block output from the prime density of its range
+        double lo = 6.0 * y_start * vx, hi = 6.0 * (y_end + 1) * vx;
+        UI64_ARRAY *out = ui64_init((int)((hi - lo) / log(lo) * 1.2) + 64);
+
+        // a fresh bucket ring per block; large primes enter at its first segment
+        scratch.buckets = NULL;
+        scratch.bucket_idx = job->bucket_start;
+        if (job->root_max > (uint64_t)vx)
+            scratch.buckets = vx_buckets_init(vx, job->root_max);
+
+        if (!out || (job->root_max > (uint64_t)vx && !scratch.buckets))
+        {
+            ui64_free(&out);
+            vx_buckets_free(&scratch.buckets);
+            ok = 0;
+            break;
         }
 
-        // * c. Collect unmarked indices as primes in current segment
-        for (int x = 2; x <= x_limit; x++)
+        for (int y = y_start; y <= y_end; y++)
         {
-            if (bitmap_get_bit(x5, x)) // i.e. iZ- prime
-                ui64_push(primes, iZ(yvx + x, -1));
+            int x_limit = (y < job->y_limit) ? vx : (int)(job->x_n % (uint64_t)vx);
+            sizm_sieve_segment(wheel, &scratch, job->roots, y, x_limit, out);
+        }
+
+        vx_buckets_free(&scratch.buckets);
+        if (out->count > 0)
+            ui64_resize_to_fit(out); // drop the density over-estimate before the merge
+        job->blocks[b] = out;        // each block has a single writer
+    }
+
+    if (!ok)
+    {
+        log_error("Memory allocation failed in SiZm_mt worker");
+        pthread_mutex_lock(&job->lock);
+        job->failed = 1;
+        pthread_mutex_unlock(&job->lock);
+    }
+
+    bitmap_free(&scratch.x5);
+    bitmap_free(&scratch.x7);
+    return NULL;
+}
+
+/**
+ * @ingroup iz_api
+ * @brief Multi-threaded Sieve-iZm for prime generation up to n.
+ *
+ * Runs SiZm's first segment on the calling thread to collect the root primes,
+ * then splits segments y >= 1 into contiguous blocks that pthread workers
+ * claim dynamically. Each worker owns its x5/x7 scratch bitmaps (reset from
+ * the shared read-only base segment) and its bucket ring, and writes each
+ * block to its own array; blocks are appended in y order and freed as they
+ * are merged, so the output is sorted and identical to SiZm() and peak memory
+ * stays close to one copy of the primes.
+ *
+ * @param n Upper bound (inclusive) for prime generation (n <= 10^12).
+ * @param threads Worker threads (<= 0 uses every online core; 1 runs SiZm()).
+ * @return Pointer to a UI64_ARRAY containing all primes <= n on success,
+ *         or NULL on allocation or initialization failure.
+ */
+UI64_ARRAY *SiZm_mt(uint64_t n, int threads)
+{
+    ASSERT_LIMIT(n); // Validate input limit
+
+    if (threads <= 0)
+        threads = get_cpu_cores_count();
+
+    // small ranges and single threads gain nothing from workers
+    int vx = compute_l2_vx(n);
+    uint64_t x_n = n / 6 + 1;
+    int y_limit = x_n / vx;
+    uint64_t root_max = sqrt(n) + 1;
+    if (n < 10000 || threads == 1 || y_limit < 2 || root_max > 6 * (uint64_t)vx)
+        return SiZm(n);
+
+    // * 1. Initialization, as in SiZm(), but sized for the root primes only:
+    // the workers hold the other primes in their blocks until the merge
+    UI64_ARRAY *primes = ui64_init(Pi(6 * (uint64_t)vx + 7) * 1.4 + 64);
+    assert(primes && "Memory allocation failed for primes array in SiZm_mt.");
+
+    BITMAP *base_x5 = bitmap_init(vx + 8, 1);
+    BITMAP *base_x7 = bitmap_init(vx + 8, 1);
+    BITMAP *x5 = NULL, *x7 = NULL;
+    BITMAP_PATTERN *pattern = NULL;
+    IZM_ROOTS *roots = NULL;
+    UI64_ARRAY **blocks = NULL;
+    pthread_t *workers = NULL;
+    int failed = 1;
+    if (!base_x5 || !base_x7)
+        goto cleanup;
+    iZm_construct_vx_base(vx, base_x5, base_x7);
+
+    int k = 0;
+    while ((6 * vx) % base_primes[k] == 0)
+        ui64_push(primes, base_primes[k++]);
+
+    // * 2. First segment (y = 0) on this thread: its primes are every root prime
+    x5 = bitmap_clone(base_x5);
+    x7 = bitmap_clone(base_x7);
+    if (!x5 || !x7)
+        goto cleanup;
+    process_iZ_bitmaps(primes, x5, x7, vx + 1);
 
-            if (bitmap_get_bit(x7, x)) // i.e. iZ+ prime
-                ui64_push(primes, iZ(yvx + x, 1));
+    pattern = iZm_construct_pattern(primes, k);
+    roots = iZm_roots_init(primes->array, sizm_count_upto(primes, MIN(root_max + 1, (uint64_t)vx)), vx);
+    if (!pattern || !roots)
+        goto cleanup;
+    SIZM_WHEEL wheel = {vx, k, base_x5, base_x7, pattern, roots};
+
+    // * 3. Split segments 1..y_limit into blocks (a few per thread to even out the load)
+    int block_count = MIN(y_limit, 4 * threads);
+    int block_size = (y_limit + block_count - 1) / block_count;
+    block_count = (y_limit + block_size - 1) / block_size;
+    threads = MIN(threads, block_count);
+
+    blocks = calloc(block_count, sizeof(UI64_ARRAY *));
+    workers = malloc(threads * sizeof(pthread_t));
+    if (!blocks || !workers)
+        goto cleanup;
+
+    SIZM_MT_JOB job = {
+        .wheel = &wheel,
+        .roots = primes,
+        .x_n = x_n,
+        .root_max = root_max,
+        .bucket_start = 0,
+        .y_limit = y_limit,
+        .block_size = block_size,
+        .block_count = block_count,
+        .blocks = blocks,
+        .next_block = 0,
+        .failed = 0,
+    };
+    while (primes->array[job.bucket_start] <= (uint64_t)vx)
+        job.bucket_start++;
+    pthread_mutex_init(&job.lock, NULL);
+
+    // * 4. Run workers; the primes array is read-only until they are joined
+    int started = 0;
+    for (; started < threads; started++)
+    {
+        if (pthread_create(&workers[started], NULL, sizm_mt_worker, &job) != 0)
+        {
+            log_error("pthread_create failed in SiZm_mt");
+            pthread_mutex_lock(&job.lock);
+            job.failed = 1;
+            pthread_mutex_unlock(&job.lock);
+            break;
+        }
+    }
+    for (int t = 0; t < started; t++)
+        pthread_join(workers[t], NULL);
+    pthread_mutex_destroy(&job.lock);
+    if (job.failed)
+        goto cleanup;
+
+    // * 5. Concatenate blocks in y order, growing the result and releasing each
+    // block once copied, so the primes are held about once rather than twice
+    for (int b = 0; b < block_count; b++)
+    {
+        int count = primes->count + blocks[b]->count;
+        if (count > primes->capacity)
+        {
+            ui64_resize_to(primes, count);
+            if (count > primes->capacity)
+                goto cleanup;
         }
 
-        yvx += vx; // advance yvx for next segment
+        memcpy(primes->array + primes->count, blocks[b]->array, blocks[b]->count * sizeof(uint64_t));
+        primes->count = count;
+        ui64_free(&blocks[b]);
     }
+    failed = 0;
 
-    // * 4. Clean up and finalize
+cleanup:
+    if (blocks)
+    {
+        for (int b = 0; b < block_count; b++)
+            ui64_free(&blocks[b]);
+        free(blocks);
+    }
+    free(workers);
+    bitmap_pattern_free(&pattern);
+    iZm_roots_free(&roots);
     bitmap_free(&x5);
     bitmap_free(&x7);
     bitmap_free(&base_x5);
     bitmap_free(&base_x7);
+    if (failed)
+    {
+        ui64_free(&primes);
+        return NULL;
+    }
 
     // Guard against overshoot near the final iZ lane.
     while (primes->count > 0 && primes->array[primes->count - 1] > n)
@@ -758,6 +1159,153 @@ UI64_ARRAY *SiZm(uint64_t n)
     return primes;
 }
 
+/**
+ * @brief Shared read-only geometry for SiZm_vy lanes.
+ *
+ * Lane (x, m_id) holds the candidates iZ(y * vx + x, m_id) for y in [0, vy].
+ */
+typedef struct
+{
+    const UI64_ARRAY *roots; /**< Root primes up to sqrt(n) + 1, then possibly lane primes. */
+    int root_count;          /**< Number of root primes at the head of @ref roots. */
+    int k;                   /**< Index of the first root prime not dividing vx. */
+    int vx;                  /**< Wheel width (number of lanes per iZ line). */
+    int vy;                  /**< Last (partial) row index. */
+    int tile_rows;           /**< Rows per lane tile (cache-sized). */
+    uint64_t n;              /**< Inclusive upper bound. */
+    IZM_ROOTS *solver;       /**< Solver constants of the sieving roots (roots[k..root_count)). */
+} SIZM_VY_GRID;
+
+/**
+ * @brief Per-thread scratch for tiled SiZm_vy lanes.
+ */
+typedef struct
+{
+    BITMAP *tile;   /**< Lane tile of grid->tile_rows bits. */
+    uint64_t *next; /**< Next row to clear for each sieving root prime (index i - k). */
+} SIZM_VY_LANE;
+
+/**
+ * @brief Allocate lane scratch for @p grid.
+ * @param grid Lane geometry.
+ * @param lane Scratch to fill.
+ * @return 1 on success, 0 on allocation failure (nothing left allocated).
+ */
+static int sizm_vy_lane_init(const SIZM_VY_GRID *grid, SIZM_VY_LANE *lane)
+{
+    lane->tile = bitmap_init(grid->tile_rows + 8, 1);
+    lane->next = malloc(MAX(grid->root_count - grid->k, 1) * sizeof(uint64_t));
+    if (lane->tile && lane->next)
+        return 1;
+
+    bitmap_free(&lane->tile);
+    free(lane->next);
+    lane->next = NULL;
+    return 0;
+}
+
+/** @brief Free lane scratch allocated by sizm_vy_lane_init(). */
+static void sizm_vy_lane_free(SIZM_VY_LANE *lane)
+{
+    bitmap_free(&lane->tile);
+    free(lane->next);
+    lane->next = NULL;
+}
+
+/**
+ * @brief Sieve one vertical lane tile by tile and append its primes to @p out.
+ *
+ * The lane is cut into tiles of grid->tile_rows rows; each tile is fully
+ * sieved by every root prime before moving on, with each prime's next row
+ * carried across tiles, so the working set stays cache-resident however
+ * long the lane is.
+ *
+ * @param grid Lane geometry and root primes.
+ * @param lane Lane scratch (tile bitmap and carried offsets).
+ * @param m_id Matrix id (-1 for iZ-, +1 for iZ+).
+ * @param x Lane column in [1, vx].
+ * @param out Output array.
+ */
+static void sizm_vy_sieve_lane(const SIZM_VY_GRID *grid, SIZM_VY_LANE *lane, int m_id, int x, UI64_ARRAY *out)
+{
+    const IZM_ROOTS *solver = grid->solver;
+    const uint32_t *roots = solver->p;
+    int r_count = solver->count;
+    uint64_t vx = grid->vx;
+    uint64_t vy = grid->vy;
+
+    // first hit of each root prime in the lane; p hits every p-th row from there
+    for (int i = 0; i < r_count; i++)
+        lane->next[i] = iZm_roots_solve_for_y0(solver, i, m_id, x);
+
+    for (uint64_t t0 = 0; t0 <= vy; t0 += grid->tile_rows)
+    {
+        uint64_t last = MIN((uint64_t)grid->tile_rows, vy + 1 - t0) - 1; // last tile bit
+
+        // * a. reset and sieve the tile
+        bitmap_set_all(lane->tile);
+        for (int i = 0; i < r_count; i++)
+        {
+            uint64_t p = roots[i];
+            uint64_t y = lane->next[i];
+            if (y <= t0 + last)
+            {
+                bitmap_clear_steps_simd(lane->tile, p, y - t0, last);
+                y += (t0 + last - y) / p * p + p; // first hit past the tile
+                lane->next[i] = y;
+            }
+        }
+
+        // * b. collect primes; values grow with y, and only the last rows can pass n
+        for (size_t i = bitmap_next_set_bit(lane->tile, 0, last); i != BITMAP_NPOS;
+             i = bitmap_next_set_bit(lane->tile, i + 1, last))
+        {
+            uint64_t p = iZ((t0 + i) * vx + x, m_id);
+            if (p > grid->n)
+                return;
+            ui64_push(out, p);
+        }
+    }
+}
+
+/**
+ * @brief Build the SiZm_vy geometry for @p n and push the root primes into @p primes.
+ * @param n Inclusive upper bound (>= 10000).
+ * @param primes Output array; receives the root primes up to sqrt(n) + 1.
+ * @return Lane geometry referencing @p primes as roots; release its solver
+ *         with iZm_roots_free() (NULL on allocation failure).
+ */
+static SIZM_VY_GRID sizm_vy_grid_init(uint64_t n, UI64_ARRAY *primes)
+{
+    uint64_t x_n = n / 6 + 1; // iZ limit for n
+    uint64_t root_limit = sqrt(n) + 1;
+
+    get_root_primes(primes, root_limit);
+
+    int k = 4; // pointing at 11 in root_primes
+    int vx = 35;
+    if (n >= pow(10, 9))
+    {
+        vx *= 11;
+        k++;
+    }
+    if (n >= pow(10, 11))
+    {
+        vx *= 13;
+        k++;
+    }
+
+    // lane tiles of an eighth of the L2 cache (best measured trade-off between
+    // cache misses and per-tile root prime overhead), in whole words
+    int vy = x_n / vx;
+    int tile_rows = MIN(vy + 1, MAX(get_cpu_L2_cache_size_bits() / 8, 4096));
+    tile_rows = (tile_rows + 63) & ~63;
+
+    IZM_ROOTS *solver = iZm_roots_init(primes->array + k, primes->count - k, vx);
+    SIZM_VY_GRID grid = {primes, primes->count, k, vx, vy, tile_rows, n, solver};
+    return grid;
+}
+
 /**
  * @ingroup iz_api
  * @brief Segmented Sieve-iZm with vertical (vy) traversal order.
@@ -783,91 +1331,358 @@ UI64_ARRAY *SiZm_vy(uint64_t n)
     UI64_ARRAY *primes = ui64_init(Pi(n) * 1.4);
     assert(primes && "Memory allocation failed for primes array in SiZm.");
 
-    uint64_t x_n = n / 6 + 1; // iZ limit for n
-    uint64_t root_limit = sqrt(n) + 1;
+    // root primes stay at the head of primes; lane primes are appended after them
+    SIZM_VY_GRID grid = sizm_vy_grid_init(n, primes);
+    SIZM_VY_LANE lane;
+    if (!grid.solver || !sizm_vy_lane_init(&grid, &lane))
+    {
+        log_error("Memory allocation failed in SiZm_vy");
+        iZm_roots_free(&grid.solver);
+        ui64_free(&primes);
+        return NULL;
+    }
 
-    get_root_primes(primes, root_limit);
-    int root_count = primes->count;
+    // * 2. Sieve logic: Process iZm's columns as segments
+    for (int x = 2; x <= grid.vx; x++)
+    {
+        // crucial, ensure iZ(x, m_id) is coprime to vx before sieving
+        for (int m_id = -1; m_id <= 1; m_id += 2)
+        {
+            if (gcd(iZ(x, m_id), grid.vx) != 1)
+                continue;
 
-    int k = 4; // pointing at 11 in root_primes
-    int vx = 35;
-    if (n >= pow(10, 9))
+            sizm_vy_sieve_lane(&grid, &lane, m_id, x, primes);
+        }
+    }
+
+    // * 3. Clean up and finalize
+    sizm_vy_lane_free(&lane);
+    iZm_roots_free(&grid.solver);
+    ui64_resize_to_fit(primes); // Trim excess memory in primes array
+
+    primes->ordered = 0; // Mark the array as unordered
+    return primes;
+}
+
+/**
+ * @brief Shared job state for SiZm_vy_mt() workers.
+ */
+typedef struct
+{
+    const SIZM_VY_GRID *grid; /**< Shared read-only lane geometry. */
+    UI64_ARRAY **outputs;     /**< Per-thread prime buffers. */
+    int next_x;               /**< Next column to claim (guarded by @ref lock). */
+    int failed;               /**< Non-zero after an allocation failure (guarded by @ref lock). */
+    pthread_mutex_t lock;     /**< Guards column claiming and the failure flag. */
+} SIZM_VY_MT_JOB;
+
+/** @brief Per-thread argument for sizm_vy_mt_worker(). */
+typedef struct
+{
+    SIZM_VY_MT_JOB *job; /**< Shared job state. */
+    int id;              /**< Thread index into @ref SIZM_VY_MT_JOB::outputs. */
+} SIZM_VY_MT_ARG;
+
+/**
+ * @brief SiZm_vy_mt() worker: claim columns until none are left.
+ * @param arg SIZM_VY_MT_ARG for this thread.
+ * @return NULL.
+ */
+static void *sizm_vy_mt_worker(void *arg)
+{
+    SIZM_VY_MT_JOB *job = ((SIZM_VY_MT_ARG *)arg)->job;
+    const SIZM_VY_GRID *grid = job->grid;
+    UI64_ARRAY *out = job->outputs[((SIZM_VY_MT_ARG *)arg)->id];
+
+    SIZM_VY_LANE lane; // private lane tile and offsets
+    if (!sizm_vy_lane_init(grid, &lane))
     {
-        vx *= 11;
-        k++;
+        log_error("Memory allocation failed in SiZm_vy_mt worker");
+        pthread_mutex_lock(&job->lock);
+        job->failed = 1;
+        pthread_mutex_unlock(&job->lock);
+        return NULL;
     }
-    if (n >= pow(10, 11))
+
+    while (1)
     {
-        vx *= 13;
-        k++;
+        pthread_mutex_lock(&job->lock);
+        int x = job->failed ? grid->vx + 1 : job->next_x++;
+        pthread_mutex_unlock(&job->lock);
+        if (x > grid->vx)
+            break;
+
+        for (int m_id = -1; m_id <= 1; m_id += 2)
+        {
+            if (gcd(iZ(x, m_id), grid->vx) != 1)
+                continue;
+
+            sizm_vy_sieve_lane(grid, &lane, m_id, x, out);
+        }
     }
 
-    int vy = x_n / vx;
+    sizm_vy_lane_free(&lane);
+    return NULL;
+}
+
+/**
+ * @ingroup iz_api
+ * @brief Multi-threaded Sieve-iZm with vertical (vy) traversal order.
+ *
+ * Same lanes as SiZm_vy(), but pthread workers claim columns dynamically, sieve
+ * them in private lane bitmaps and append into per-thread prime buffers that
+ * are concatenated at the end. Output is unordered, as with SiZm_vy().
+ *
+ * @param n Inclusive upper bound for prime generation.
+ * @param threads Worker threads (<= 0 uses every online core; 1 runs SiZm_vy()).
+ * @return Heap-allocated list of primes <= @p n, or NULL on failure.
+ */
+UI64_ARRAY *SiZm_vy_mt(uint64_t n, int threads)
+{
+    ASSERT_LIMIT(n); // Validate input limit
 
-    BITMAP *sieve = bitmap_init(vy + 8, 1);
+    if (threads <= 0)
+        threads = get_cpu_cores_count();
+    if (n < 10000 || threads == 1)
+        return SiZm_vy(n);
 
-    // * 2. Sieve logic: Process iZm's columns as segments
-    for (int x = 2; x <= vx; x++)
+    // * 1. Initialization:
+    UI64_ARRAY *primes = ui64_init(Pi(n) * 1.4);
+    assert(primes && "Memory allocation failed for primes array in SiZm_vy_mt.");
+
+    // root primes are read-only while workers run
+    SIZM_VY_GRID grid = sizm_vy_grid_init(n, primes);
+    threads = MIN(threads, grid.vx - 1);
+
+    SIZM_VY_MT_JOB job = {.grid = &grid, .next_x = 2, .failed = 0};
+    job.outputs = calloc(threads, sizeof(UI64_ARRAY *));
+    SIZM_VY_MT_ARG *args = malloc(threads * sizeof(SIZM_VY_MT_ARG));
+    pthread_t *workers = malloc(threads * sizeof(pthread_t));
+    int failed = !grid.solver || !job.outputs || !args || !workers;
+
+    for (int t = 0; !failed && t < threads; t++)
     {
-        // Handle iZ- case:
-        // crucial, ensure iZ(x, -1) is coprime to vx before sieving
-        if (gcd(iZ(x, -1), vx) == 1)
+        job.outputs[t] = ui64_init(Pi(n) * 1.4 / threads + 64);
+        args[t] = (SIZM_VY_MT_ARG){&job, t};
+        failed = !job.outputs[t];
+    }
+    if (failed)
+        goto cleanup;
+
+    // * 2. Run workers over the columns
+    pthread_mutex_init(&job.lock, NULL);
+    int started = 0;
+    for (; started < threads; started++)
+    {
+        if (pthread_create(&workers[started], NULL, sizm_vy_mt_worker, &args[started]) != 0)
         {
-            // * a. reset sieve bitmap for new segment
-            bitmap_set_all(sieve); // set all bits
+            log_error("pthread_create failed in SiZm_vy_mt");
+            pthread_mutex_lock(&job.lock);
+            job.failed = 1;
+            pthread_mutex_unlock(&job.lock);
+            break;
+        }
+    }
+    for (int t = 0; t < started; t++)
+        pthread_join(workers[t], NULL);
+    pthread_mutex_destroy(&job.lock);
+    failed = job.failed;
+    if (failed)
+        goto cleanup;
+
+    // * 3. Join per-thread buffers
+    int total = primes->count;
+    for (int t = 0; t < threads; t++)
+        total += job.outputs[t]->count;
+    if (total > primes->capacity)
+        ui64_resize_to(primes, total);
+
+    for (int t = 0; t < threads; t++)
+    {
+        memcpy(primes->array + primes->count, job.outputs[t]->array, job.outputs[t]->count * sizeof(uint64_t));
+        primes->count += job.outputs[t]->count;
+    }
 
-            // * b. mark composites of root primes in sieve
-            for (int i = k; i < root_count; i++)
-            {
-                uint64_t p = primes->array[i];
-                int64_t y_0 = iZm_solve_for_y0(-1, p, vx, x);
-                bitmap_clear_steps_simd(sieve, p, y_0, vy);
-            }
+cleanup:
+    if (job.outputs)
+    {
+        for (int t = 0; t < threads; t++)
+            ui64_free(&job.outputs[t]);
+        free(job.outputs);
+    }
+    free(args);
+    free(workers);
+    iZm_roots_free(&grid.solver);
+    if (failed)
+    {
+        ui64_free(&primes);
+        return NULL;
+    }
+
+    ui64_resize_to_fit(primes); // Trim excess memory in primes array
+    primes->ordered = 0;        // Mark the array as unordered
+    return primes;
+}
+
+/**
+ * @brief Transpose a 64x64 bit matrix in place.
+ *
+ * On return, bit c of a[r] holds what was bit r of a[c].
+ *
+ * @param a Matrix rows (64 words).
+ */
+static void transpose_64x64(uint64_t a[64])
+{
+    uint64_t m = 0x00000000FFFFFFFFULL;
+    for (int j = 32; j != 0; j >>= 1, m ^= (m << j))
+    {
+        for (int k = 0; k < 64; k = ((k | j) + 1) & ~j)
+        {
+            uint64_t t = ((a[k] >> j) ^ a[k | j]) & m;
+            a[k] ^= t << j;
+            a[k | j] ^= t;
+        }
+    }
+}
+
+/**
+ * @ingroup iz_api
+ * @brief Sieve-iZm with vertical lanes and ascending (row-major) output.
+ *
+ * Sieves a block of rows for every coprime column at once, carrying each root
+ * prime's next row per column across blocks, then emits the block row by row:
+ * groups of 64 column words are bit-transposed so each row becomes a few
+ * words scanned in column (= value) order. Root primes come first and every
+ * lane prime exceeds them, so the result is sorted without a global sort.
+ *
+ * @param n Inclusive upper bound for prime generation.
+ * @return Heap-allocated sorted list of primes <= @p n, or NULL on failure.
+ */
+UI64_ARRAY *SiZm_vy_ordered(uint64_t n)
+{
+    ASSERT_LIMIT(n); // Validate input limit
+
+    if (n < 10000)
+        return SiZ(n);
 
-            // * c. collect primes from sieve up to y = vy-1
-            for (int y = 0; y < vy; y++)
+    // * 1. Initialization:
+    UI64_ARRAY *primes = ui64_init(Pi(n) * 1.4);
+    assert(primes && "Memory allocation failed for primes array in SiZm_vy_ordered.");
+
+    SIZM_VY_GRID grid = sizm_vy_grid_init(n, primes);
+    int vx = grid.vx;
+    int vy = grid.vy;
+    int r_count = grid.root_count - grid.k; // sieving primes per column
+
+    // columns in value order: x ascending, iZ- before iZ+
+    int *col_x = malloc(2 * vx * sizeof(int));
+    int *col_m = malloc(2 * vx * sizeof(int));
+    int cols = 0;
+    for (int x = 2; col_x && col_m && x <= vx; x++)
+        for (int m_id = -1; m_id <= 1; m_id += 2)
+            if (gcd(iZ(x, m_id), vx) == 1)
             {
-                if (bitmap_get_bit(sieve, y))
-                    ui64_push(primes, iZ(y * vx + x, -1));
+                col_x[cols] = x;
+                col_m[cols++] = m_id;
             }
-            // handle partial last row where y = vy (check if p < n before pushing)
-            if (bitmap_get_bit(sieve, vy))
+    int chunks = (cols + 63) / 64; // 64-column groups for the transpose
+
+    // block height: all column tiles together fit in L2, in whole words
+    int words = MAX(1, get_cpu_L2_cache_size_bits() / (64 * MAX(cols, 1)));
+    words = MIN(words, vy / 64 + 1);
+    int block_rows = 64 * words;
+
+    // next row to clear for every (column, root prime) pair
+    uint32_t *next = malloc((size_t)cols * r_count * sizeof(uint32_t));
+    uint64_t *tile = malloc((size_t)chunks * 64 * words * sizeof(uint64_t));
+    uint64_t *rows = malloc((size_t)chunks * 64 * sizeof(uint64_t));
+    if (!grid.solver || !col_x || !col_m || !next || !tile || !rows)
+    {
+        log_error("Memory allocation failed in SiZm_vy_ordered");
+        iZm_roots_free(&grid.solver);
+        free(col_x);
+        free(col_m);
+        free(next);
+        free(tile);
+        free(rows);
+        ui64_free(&primes);
+        return NULL;
+    }
+
+    for (int c = 0; c < cols; c++)
+        for (int i = 0; i < r_count; i++)
+            next[(size_t)c * r_count + i] = iZm_roots_solve_for_y0(grid.solver, i, col_m[c], col_x[c]);
+
+    // pad columns of the last chunk stay empty
+    memset(tile, 0, (size_t)chunks * 64 * words * sizeof(uint64_t));
+
+    // * 2. Sieve row blocks for all columns, then emit them row-major
+    int done = 0;
+    for (uint64_t y0 = 0; !done && y0 <= (uint64_t)vy; y0 += block_rows)
+    {
+        uint64_t end = MIN(y0 + block_rows, (uint64_t)vy + 1); // exclusive
+        int block_words = (end - y0 + 63) / 64;
+
+        for (int c = 0; c < cols; c++)
+        {
+            uint64_t *col = tile + (size_t)c * words;
+            memset(col, 0xFF, block_words * sizeof(uint64_t));
+            if ((end - y0) % 64)
+                col[block_words - 1] = (1ULL << ((end - y0) % 64)) - 1;
+
+            uint32_t *col_next = next + (size_t)c * r_count;
+            for (int i = 0; i < r_count; i++)
             {
-                uint64_t p = iZ(vy * vx + x, -1);
-                if (p < n)
-                    ui64_push(primes, p);
+                uint64_t p = grid.solver->p[i];
+                uint64_t y = col_next[i];
+                for (; y < end; y += p)
+                    col[(y - y0) >> 6] &= ~(1ULL << ((y - y0) & 63));
+                col_next[i] = y;
             }
         }
 
-        // Handle iZ+ case similarly:
-        if (gcd(iZ(x, 1), vx) == 1)
+        for (int w = 0; !done && w < block_words; w++)
         {
-            bitmap_set_all(sieve); // reset sieve bitmap for new segment
-            for (int i = k; i < root_count; i++)
+            for (int q = 0; q < chunks; q++)
             {
-                uint64_t p = primes->array[i];
-                int64_t y_0 = iZm_solve_for_y0(1, p, vx, x);
-                bitmap_clear_steps_simd(sieve, p, y_0, vy);
+                uint64_t *group = rows + (size_t)q * 64;
+                for (int j = 0; j < 64; j++)
+                    group[j] = tile[(size_t)(q * 64 + j) * words + w];
+                transpose_64x64(group);
             }
 
-            for (int y = 0; y < vy; y++)
+            for (int r = 0; !done && r < 64; r++)
             {
-                if (bitmap_get_bit(sieve, y))
-                    ui64_push(primes, iZ(y * vx + x, 1));
-            }
-            if (bitmap_get_bit(sieve, vy))
-            {
-                uint64_t p = iZ(vy * vx + x, 1);
-                if (p < n)
-                    ui64_push(primes, p);
+                uint64_t y = y0 + 64 * w + r;
+                for (int q = 0; q < chunks; q++)
+                {
+                    uint64_t bits = rows[(size_t)q * 64 + r];
+                    while (bits)
+                    {
+                        int c = q * 64 + __builtin_ctzll(bits);
+                        bits &= bits - 1;
+                        uint64_t p = iZ(y * vx + col_x[c], col_m[c]);
+                        if (p > n)
+                        {
+                            done = 1; // ascending order: everything after is > n too
+                            break;
+                        }
+                        ui64_push(primes, p);
+                    }
+                    if (done)
+                        break;
+                }
             }
         }
     }
 
     // * 3. Clean up and finalize
-    bitmap_free(&sieve);
+    iZm_roots_free(&grid.solver);
+    free(col_x);
+    free(col_m);
+    free(next);
+    free(tile);
+    free(rows);
     ui64_resize_to_fit(primes); // Trim excess memory in primes array
-
-    primes->ordered = 0; // Mark the array as unordered
     return primes;
 }
@@ -182,6 +182,69 @@ void bitmap_clear_all(BITMAP *bitmap)
     memset(bitmap->data, 0x00, (bitmap->size + 7) / 8);
 }
 
+// =========================================================
+// * Word access helpers
+// =========================================================
+
+/**
+ * @brief Load the @p word_idx-th 64-bit word of the bitmap payload.
+ *
+ * Bits are LSB-first per byte, so the word is assembled in little-endian
+ * order; this makes bit i of the word equal to bitmap bit (64 * word_idx + i).
+ * Bytes past @ref BITMAP::byte_size read as zero.
+ *
+ * @param bitmap Bitmap to read.
+ * @param word_idx Zero-based word index.
+ * @return The word value.
+ */
+static inline uint64_t bitmap_load_word(const BITMAP *bitmap, size_t word_idx)
+{
+    size_t byte_idx = word_idx * 8;
+    uint64_t word = 0;
+
+    if (byte_idx + 8 <= bitmap->byte_size)
+    {
+        memcpy(&word, bitmap->data + byte_idx, sizeof(word));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        word = __builtin_bswap64(word);
+#endif
+        return word;
+    }
+
+    // partial tail word
+    for (size_t i = 0; byte_idx + i < bitmap->byte_size; i++)
+        word |= (uint64_t)bitmap->data[byte_idx + i] << (8 * i);
+
+    return word;
+}
+
+/**
+ * @brief Store @p word as the @p word_idx-th 64-bit word of the bitmap payload.
+ *
+ * Inverse of bitmap_load_word(); bytes past @ref BITMAP::byte_size are dropped.
+ *
+ * @param bitmap Bitmap to modify.
+ * @param word_idx Zero-based word index.
+ * @param word Word value to store.
+ */
+static inline void bitmap_store_word(BITMAP *bitmap, size_t word_idx, uint64_t word)
+{
+    size_t byte_idx = word_idx * 8;
+
+    if (byte_idx + 8 <= bitmap->byte_size)
+    {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        word = __builtin_bswap64(word);
+#endif
+        memcpy(bitmap->data + byte_idx, &word, sizeof(word));
+        return;
+    }
+
+    // partial tail word
+    for (size_t i = 0; byte_idx + i < bitmap->byte_size; i++)
+        bitmap->data[byte_idx + i] = (unsigned char)(word >> (8 * i));
+}
+
 /**
  * @brief Clears bits at regular intervals, typically used in sieve algorithms.
  *
@@ -222,11 +285,88 @@ void bitmap_clear_steps(BITMAP *bitmap, uint64_t step, uint64_t start_idx, uint6
 }
 
 /**
- * @brief SIMD-optimized version of bitmap_clear_steps.
+ * @brief Small-step kernel: one AND per 64-bit word.
  *
- * This function uses SIMD instructions (AVX2, SSE2, or NEON) to clear bits
- * at regular intervals in the bitmap. It processes multiple bits in parallel
- * for improved performance on large bitmaps.
+ * For step < 8 every word holds at least 8 hits. Since 64 * step is a
+ * multiple of step, the word masks repeat every @p step words, so at most
+ * 7 masks are built up front and the loop is a plain load/AND/store per word.
+ */
+static void bitmap_clear_steps_small(BITMAP *bitmap, uint64_t step, uint64_t idx, uint64_t limit)
+{
+    size_t first_word = idx / 64;
+    size_t last_word = limit / 64;
+    uint64_t head_keep = (1ULL << (idx % 64)) - 1;
+    uint64_t tail_keep = (limit % 64 == 63) ? 0 : ~0ULL << (limit % 64 + 1);
+
+    uint64_t masks[8];
+    for (uint64_t j = 0; j < step; j++)
+    {
+        uint64_t base = (first_word + j) * 64;
+        masks[j] = ~0ULL;
+        // first bit in word first_word + j congruent to idx mod step
+        for (uint64_t b = (idx % step + step - base % step) % step; b < 64; b += step)
+            masks[j] &= ~(1ULL << b);
+    }
+
+    uint64_t j = 0;
+    for (size_t w = first_word; w <= last_word; w++)
+    {
+        uint64_t mask = masks[j] | (w == first_word ? head_keep : 0) | (w == last_word ? tail_keep : 0);
+        bitmap_store_word(bitmap, w, bitmap_load_word(bitmap, w) & mask);
+        j = (j + 1 == step) ? 0 : j + 1;
+    }
+}
+
+/**
+ * @brief Medium-step kernel: unrolled 8-hit byte-mask wheel.
+ *
+ * Bit positions idx + k*step (k = 0..7) map to fixed (byte offset, bit mask)
+ * pairs relative to byte idx/8, and after 8 hits the pattern repeats exactly
+ * @p step bytes further (8 * step bits). The pairs are computed once, so the
+ * hot loop is 8 byte stores and one pointer bump, without division or shifts.
+ */
+static void bitmap_clear_steps_wheel(BITMAP *bitmap, uint64_t step, uint64_t idx, uint64_t limit)
+{
+    uint64_t rounds = ((limit - idx) / step + 1) / 8;
+    unsigned char *ptr = bitmap->data + idx / 8;
+    uint64_t bit = idx % 8;
+
+    uint64_t o0 = (bit + 0 * step) / 8, o1 = (bit + 1 * step) / 8;
+    uint64_t o2 = (bit + 2 * step) / 8, o3 = (bit + 3 * step) / 8;
+    uint64_t o4 = (bit + 4 * step) / 8, o5 = (bit + 5 * step) / 8;
+    uint64_t o6 = (bit + 6 * step) / 8, o7 = (bit + 7 * step) / 8;
+    unsigned char m0 = ~(1 << ((bit + 0 * step) % 8)), m1 = ~(1 << ((bit + 1 * step) % 8));
+    unsigned char m2 = ~(1 << ((bit + 2 * step) % 8)), m3 = ~(1 << ((bit + 3 * step) % 8));
+    unsigned char m4 = ~(1 << ((bit + 4 * step) % 8)), m5 = ~(1 << ((bit + 5 * step) % 8));
+    unsigned char m6 = ~(1 << ((bit + 6 * step) % 8)), m7 = ~(1 << ((bit + 7 * step) % 8));
+
+    for (uint64_t r = 0; r < rounds; r++)
+    {
+        ptr[o0] &= m0;
+        ptr[o1] &= m1;
+        ptr[o2] &= m2;
+        ptr[o3] &= m3;
+        ptr[o4] &= m4;
+        ptr[o5] &= m5;
+        ptr[o6] &= m6;
+        ptr[o7] &= m7;
+        ptr += step;
+    }
+
+    // Handle remaining (< 8) hits
+    for (idx += rounds * 8 * step; idx <= limit; idx += step)
+        bitmap->data[idx / 8] &= ~(1 << (idx % 8));
+}
+
+/**
+ * @brief Fast dispatching version of bitmap_clear_steps.
+ *
+ * Picks a kernel by step size and hit count:
+ * - step < 8: periodic word-mask kernel, one AND per 64-bit word
+ * - at least 8 hits: unrolled byte-mask wheel (see bitmap_clear_steps_wheel)
+ * - fewer hits (large steps): plain scalar loop, no setup cost
+ *
+ * The result is identical to bitmap_clear_steps().
  *
  * @param bitmap Pointer to the bitmap to modify
  * @param step Interval between bits to clear (must be > 0)
@@ -240,132 +380,337 @@ void bitmap_clear_steps_simd(BITMAP *bitmap, uint64_t step, uint64_t start_idx,
     if (start_idx > limit)
         return;
 
-#ifdef __aarch64__
-    // NEON implementation for ARM64
-    uint64_t idx = start_idx;
+    if (step < 8)
+    {
+        bitmap_clear_steps_small(bitmap, step, start_idx, limit);
+    }
+    else if ((limit - start_idx) / step >= 7) // at least one full 8-hit round
+    {
+        bitmap_clear_steps_wheel(bitmap, step, start_idx, limit);
+    }
+    else
+    {
+        for (uint64_t idx = start_idx; idx <= limit; idx += step)
+            bitmap->data[idx / 8] &= ~(1 << (idx % 8));
+    }
+}
 
-    // Process 4 steps at a time
-    // Condition: idx + 3*step <= limit
+// =========================================================
+// * Word-level scans
+// =========================================================
 
-    if (limit >= 3 * step && idx <= limit - 3 * step)
-    {
-        uint64x2_t v_step2 = vdupq_n_u64(2 * step);
-        uint64x2_t v_step4 = vdupq_n_u64(4 * step);
+/**
+ * @brief Counts set bits in an inclusive index range.
+ *
+ * The range is split into a masked head word, full middle words and a masked
+ * tail word; each word costs a single popcount.
+ *
+ * @param bitmap Bitmap to inspect
+ * @param start_idx First index to count
+ * @param end_idx Inclusive upper bound (auto-capped to size-1)
+ * @return Number of set bits in [start_idx, end_idx]
+ */
+size_t bitmap_count_range(BITMAP *bitmap, size_t start_idx, size_t end_idx)
+{
+    assert(bitmap && bitmap->data && "Invalid bitmap passed to bitmap_count_range.");
+    end_idx = MIN(end_idx, bitmap->size - 1);
+    if (start_idx > end_idx)
+        return 0;
+
+    size_t first_word = start_idx / 64;
+    size_t last_word = end_idx / 64;
+    uint64_t head_mask = ~0ULL << (start_idx % 64);
+    uint64_t tail_mask = ~0ULL >> (63 - end_idx % 64);
 
-        // Initialize indices: [idx, idx+step] and [idx+2step, idx+3step]
-        uint64x2_t v_idx_01 = vdupq_n_u64(idx);
-        v_idx_01 = vsetq_lane_u64(idx + step, v_idx_01, 1);
+    if (first_word == last_word)
+        return (size_t)__builtin_popcountll(bitmap_load_word(bitmap, first_word) & head_mask & tail_mask);
 
-        uint64x2_t v_idx_23 = vaddq_u64(v_idx_01, v_step2);
+    size_t count = (size_t)__builtin_popcountll(bitmap_load_word(bitmap, first_word) & head_mask);
+    for (size_t w = first_word + 1; w < last_word; w++)
+        count += (size_t)__builtin_popcountll(bitmap_load_word(bitmap, w));
+    count += (size_t)__builtin_popcountll(bitmap_load_word(bitmap, last_word) & tail_mask);
+
+    return count;
+}
 
-        while (idx <= limit - 3 * step)
+/**
+ * @brief Finds the next set bit at or after @p start_idx using ctz.
+ *
+ * @param bitmap Bitmap to scan
+ * @param start_idx First index to inspect
+ * @param limit Inclusive upper bound (auto-capped to size-1)
+ * @return Index of the first set bit in [start_idx, limit], or BITMAP_NPOS
+ */
+size_t bitmap_next_set_bit(BITMAP *bitmap, size_t start_idx, size_t limit)
+{
+    assert(bitmap && bitmap->data && "Invalid bitmap passed to bitmap_next_set_bit.");
+    limit = MIN(limit, bitmap->size - 1);
+    if (start_idx > limit)
+        return BITMAP_NPOS;
+
+    size_t w = start_idx / 64;
+    size_t last_word = limit / 64;
+    uint64_t word = bitmap_load_word(bitmap, w) & (~0ULL << (start_idx % 64));
+
+    for (;;)
+    {
+        if (word)
         {
-            // Extract indices and perform operations
-            // Note: NEON doesn't have efficient scatter for bytes, so we extract and do scalar stores
+            size_t idx = w * 64 + (size_t)__builtin_ctzll(word);
+            return idx <= limit ? idx : BITMAP_NPOS;
+        }
+        if (++w > last_word)
+            return BITMAP_NPOS;
+        word = bitmap_load_word(bitmap, w);
+    }
+}
 
-            uint64_t i0 = vgetq_lane_u64(v_idx_01, 0);
-            uint64_t i1 = vgetq_lane_u64(v_idx_01, 1);
-            uint64_t i2 = vgetq_lane_u64(v_idx_23, 0);
-            uint64_t i3 = vgetq_lane_u64(v_idx_23, 1);
+/**
+ * @brief Visits every set bit in an inclusive index range in ascending order.
+ *
+ * Each word is drained by repeatedly taking its lowest set bit (ctz) and
+ * clearing it (word &= word - 1), so cost scales with the number of set bits
+ * rather than the range width.
+ *
+ * @param bitmap Bitmap to scan
+ * @param start_idx First index to inspect
+ * @param end_idx Inclusive upper bound (auto-capped to size-1)
+ * @param visitor Callback receiving each set-bit index
+ * @param ctx Opaque pointer forwarded to visitor
+ */
+void bitmap_for_each_set_bit(BITMAP *bitmap, size_t start_idx, size_t end_idx, BITMAP_BIT_VISITOR visitor, void *ctx)
+{
+    assert(bitmap && bitmap->data && "Invalid bitmap passed to bitmap_for_each_set_bit.");
+    assert(visitor && "Visitor callback is NULL in bitmap_for_each_set_bit.");
+    end_idx = MIN(end_idx, bitmap->size - 1);
+    if (start_idx > end_idx)
+        return;
 
-            bitmap->data[i0 / 8] &= ~(1 << (i0 % 8));
-            bitmap->data[i1 / 8] &= ~(1 << (i1 % 8));
-            bitmap->data[i2 / 8] &= ~(1 << (i2 % 8));
-            bitmap->data[i3 / 8] &= ~(1 << (i3 % 8));
+    size_t first_word = start_idx / 64;
+    size_t last_word = end_idx / 64;
 
-            // Advance indices
-            v_idx_01 = vaddq_u64(v_idx_01, v_step4);
-            v_idx_23 = vaddq_u64(v_idx_23, v_step4);
+    for (size_t w = first_word; w <= last_word; w++)
+    {
+        uint64_t word = bitmap_load_word(bitmap, w);
+        if (w == first_word)
+            word &= ~0ULL << (start_idx % 64);
+        if (w == last_word)
+            word &= ~0ULL >> (63 - end_idx % 64);
 
-            idx += 4 * step;
+        while (word)
+        {
+            visitor(w * 64 + (size_t)__builtin_ctzll(word), ctx);
+            word &= word - 1;
         }
     }
+}
+
+// =========================================================
+// * Periodic patterns
+// =========================================================
 
-    // Handle remaining steps
-    for (; idx <= limit; idx += step)
+/**
+ * @brief Builds word-level clearing masks for a list of small odd steps.
+ *
+ * For each step p, the table holds p words where word j has bit b cleared iff
+ * (64 * j + b) % p == 0. Since 64 * p is a multiple of p, the table repeats
+ * every p words, so a progression of any start offset can be cleared by
+ * ANDing consecutive table words into consecutive bitmap words. Each table is
+ * followed by 3 wrap-around words so up to 4 words can be loaded at once.
+ *
+ * @param steps Odd steps >= 5.
+ * @param count Number of steps.
+ * @return Newly allocated pattern object, or NULL on allocation failure.
+ */
+BITMAP_PATTERN *bitmap_pattern_init(const uint64_t *steps, int count)
+{
+    assert(count >= 0 && (steps || count == 0) && "Invalid steps passed to bitmap_pattern_init.");
+
+    BITMAP_PATTERN *pattern = calloc(1, sizeof(BITMAP_PATTERN));
+    if (!pattern)
     {
-        bitmap->data[idx / 8] &= ~(1 << (idx % 8));
+        log_error("Memory allocation failed for bitmap pattern.");
+        return NULL;
     }
 
-#elif defined(__AVX2__)
-    // AVX2 implementation for x86_64
-    uint64_t idx = start_idx;
+    pattern->count = count;
+    if (count == 0)
+        return pattern;
+
+    pattern->steps = malloc(count * sizeof(uint64_t));
+    pattern->inv64 = malloc(count * sizeof(uint64_t));
+    pattern->masks = calloc(count, sizeof(uint64_t *));
+    if (!pattern->steps || !pattern->inv64 || !pattern->masks)
+    {
+        log_error("Memory allocation failed for bitmap pattern tables.");
+        bitmap_pattern_free(&pattern);
+        return NULL;
+    }
 
-    // Process 4 steps at a time
-    if (limit >= 3 * step && idx <= limit - 3 * step)
+    for (int i = 0; i < count; i++)
     {
-        __m256i v_step4 = _mm256_set1_epi64x(4 * step);
+        uint64_t p = steps[i];
+        assert(p >= 5 && (p & 1) && "Pattern steps must be odd and >= 5.");
 
-        // Initialize indices: [idx, idx+step, idx+2step, idx+3step]
-        // Note: _mm256_set_epi64x takes arguments in reverse order (e3, e2, e1, e0)
-        __m256i v_idx = _mm256_set_epi64x(idx + 3 * step, idx + 2 * step, idx + step, idx);
+        pattern->steps[i] = p;
+        pattern->inv64[i] = modular_inverse(64 % p, p);
+        pattern->masks[i] = malloc((p + 3) * sizeof(uint64_t));
+        if (!pattern->masks[i])
+        {
+            log_error("Memory allocation failed for bitmap pattern masks.");
+            bitmap_pattern_free(&pattern);
+            return NULL;
+        }
 
-        while (idx <= limit - 3 * step)
+        for (uint64_t j = 0; j < p + 3; j++)
         {
-            // Extract indices
-            uint64_t i0 = _mm256_extract_epi64(v_idx, 0);
-            uint64_t i1 = _mm256_extract_epi64(v_idx, 1);
-            uint64_t i2 = _mm256_extract_epi64(v_idx, 2);
-            uint64_t i3 = _mm256_extract_epi64(v_idx, 3);
-
-            bitmap->data[i0 / 8] &= ~(1 << (i0 % 8));
-            bitmap->data[i1 / 8] &= ~(1 << (i1 % 8));
-            bitmap->data[i2 / 8] &= ~(1 << (i2 % 8));
-            bitmap->data[i3 / 8] &= ~(1 << (i3 % 8));
-
-            // Advance indices
-            v_idx = _mm256_add_epi64(v_idx, v_step4);
-            idx += 4 * step;
+            uint64_t mask = ~0ULL;
+            // first bit b in word j with (64 * j + b) % p == 0
+            for (uint64_t b = (p - (64 * j) % p) % p; b < 64; b += p)
+                mask &= ~(1ULL << b);
+            pattern->masks[i][j] = mask;
         }
     }
 
-    // Handle remaining steps
-    for (; idx <= limit; idx += step)
+    return pattern;
+}
+
+/**
+ * @brief Frees a pattern object and sets the caller pointer to NULL.
+ * @param pattern Address of a BITMAP_PATTERN pointer
+ */
+void bitmap_pattern_free(BITMAP_PATTERN **pattern)
+{
+    if (pattern == NULL || *pattern == NULL)
+        return;
+
+    if ((*pattern)->masks)
+        for (int i = 0; i < (*pattern)->count; i++)
+            free((*pattern)->masks[i]);
+
+    free((*pattern)->masks);
+    free((*pattern)->inv64);
+    free((*pattern)->steps);
+    free(*pattern);
+    *pattern = NULL;
+}
+
+/**
+ * @brief Clears the progressions of all pattern steps in one pass over the bitmap.
+ *
+ * Words are processed in three phases: per-step head words up to the first
+ * word where every progression is active (masked so bits below each start
+ * survive), a fused middle phase that ANDs all step masks into each word
+ * (4 words per AVX2 op, 2 per NEON op), and a masked tail word.
+ *
+ * Equivalent to calling bitmap_clear_steps(bitmap, steps[i], start_idx[i], limit)
+ * for every step i.
+ *
+ * @param bitmap Bitmap to modify
+ * @param pattern Pattern built by bitmap_pattern_init()
+ * @param start_idx Per-step first index to clear (values > limit skip the step)
+ * @param limit Inclusive upper bound (auto-capped to size-1)
+ */
+void bitmap_apply_pattern(BITMAP *bitmap, const BITMAP_PATTERN *pattern, const uint64_t *start_idx, uint64_t limit)
+{
+    assert(bitmap && bitmap->data && "Invalid bitmap passed to bitmap_apply_pattern.");
+    assert(pattern && "Invalid pattern passed to bitmap_apply_pattern.");
+    assert(pattern->count <= BITMAP_PATTERN_MAX_COUNT && "Too many steps in bitmap pattern.");
+
+    limit = MIN(limit, bitmap->size - 1);
+
+    size_t last_word = limit / 64;
+    uint64_t tail_keep = (limit % 64 == 63) ? 0 : ~0ULL << (limit % 64 + 1);
+
+    // active steps and their current table position
+    const uint64_t *masks[BITMAP_PATTERN_MAX_COUNT];
+    uint64_t steps[BITMAP_PATTERN_MAX_COUNT];
+    uint64_t phase[BITMAP_PATTERN_MAX_COUNT];
+    int active = 0;
+    size_t fused_start = 0;
+
+    // * 1. Head: apply each step from its start word up to the fused region
+    for (int i = 0; i < pattern->count; i++)
     {
-        bitmap->data[idx / 8] &= ~(1 << (idx % 8));
+        if (start_idx[i] > limit)
+            continue;
+        size_t w = start_idx[i] / 64;
+        fused_start = MAX(fused_start, w + 1);
     }
 
-#elif defined(__SSE2__)
-    // SSE2 implementation for x86_64
-    uint64_t idx = start_idx;
-
-    // Process 2 steps at a time
-    if (limit >= step && idx <= limit - step)
+    for (int i = 0; i < pattern->count; i++)
     {
-        __m128i v_step2 = _mm_set1_epi64x(2 * step);
-        // Note: _mm_set_epi64x takes arguments in reverse order (e1, e0)
-        __m128i v_idx = _mm_set_epi64x(idx + step, idx);
+        uint64_t s = start_idx[i];
+        if (s > limit)
+            continue;
+
+        uint64_t p = pattern->steps[i];
+        size_t w = s / 64;
+        // table row j for word w satisfies 64 * j = 64 * w - s (mod p)
+        uint64_t j = (w % p + p - (s % p) * pattern->inv64[i] % p) % p;
+        uint64_t head_keep = (1ULL << (s % 64)) - 1;
 
-        while (idx <= limit - step)
+        for (; w < fused_start && w <= last_word; w++)
         {
-            // Extract indices
-            // _mm_cvtsi128_si64 extracts the lower 64 bits (element 0)
-            uint64_t i0 = _mm_cvtsi128_si64(v_idx);
-            // Unpack high to low to extract element 1
-            uint64_t i1 = _mm_cvtsi128_si64(_mm_unpackhi_epi64(v_idx, v_idx));
-
-            bitmap->data[i0 / 8] &= ~(1 << (i0 % 8));
-            bitmap->data[i1 / 8] &= ~(1 << (i1 % 8));
-
-            // Advance indices
-            v_idx = _mm_add_epi64(v_idx, v_step2);
-            idx += 2 * step;
+            uint64_t mask = pattern->masks[i][j] | (w == s / 64 ? head_keep : 0) | (w == last_word ? tail_keep : 0);
+            bitmap_store_word(bitmap, w, bitmap_load_word(bitmap, w) & mask);
+            j = (j + 1 == p) ? 0 : j + 1;
         }
+
+        masks[active] = pattern->masks[i];
+        steps[active] = p;
+        phase[active] = j;
+        active++;
     }
 
-    // Handle remaining steps
-    for (; idx <= limit; idx += step)
+    if (active == 0 || fused_start > last_word)
+        return;
+
+    // * 2. Fused middle: AND every active mask into each full word
+    size_t w = fused_start;
+#if defined(__AVX2__)
+    for (; w + 4 <= last_word; w += 4)
     {
-        bitmap->data[idx / 8] &= ~(1 << (idx % 8));
+        __m256i acc = _mm256_loadu_si256((const __m256i *)(bitmap->data + w * 8));
+        for (int i = 0; i < active; i++)
+        {
+            acc = _mm256_and_si256(acc, _mm256_loadu_si256((const __m256i *)(masks[i] + phase[i])));
+            phase[i] += 4;
+            if (phase[i] >= steps[i])
+                phase[i] -= steps[i];
+        }
+        _mm256_storeu_si256((__m256i *)(bitmap->data + w * 8), acc);
     }
-
-#else
-    // Fallback to scalar implementation
-    for (uint64_t idx = start_idx; idx <= limit; idx += step)
+#elif defined(__aarch64__) && defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    for (; w + 2 <= last_word; w += 2)
     {
-        bitmap->data[idx / 8] &= ~(1 << (idx % 8));
+        uint64x2_t acc = vreinterpretq_u64_u8(vld1q_u8(bitmap->data + w * 8));
+        for (int i = 0; i < active; i++)
+        {
+            acc = vandq_u64(acc, vld1q_u64(masks[i] + phase[i]));
+            phase[i] += 2;
+            if (phase[i] >= steps[i])
+                phase[i] -= steps[i];
+        }
+        vst1q_u8(bitmap->data + w * 8, vreinterpretq_u8_u64(acc));
     }
 #endif
+    for (; w < last_word; w++)
+    {
+        uint64_t word = bitmap_load_word(bitmap, w);
+        for (int i = 0; i < active; i++)
+        {
+            word &= masks[i][phase[i]];
+            phase[i] = (phase[i] + 1 == steps[i]) ? 0 : phase[i] + 1;
+        }
+        bitmap_store_word(bitmap, w, word);
+    }
+
+    // * 3. Tail: last word, keeping bits beyond limit
+    uint64_t word = bitmap_load_word(bitmap, last_word);
+    for (int i = 0; i < active; i++)
+        word &= masks[i][phase[i]] | tail_keep;
+    bitmap_store_word(bitmap, last_word, word);
 }
 
 /**
@@ -6,6 +6,12 @@
 
 #include <iZ_api.h>
 
+#include <stdatomic.h>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#include <immintrin.h>
+#endif
+
 /** Small primes used to compute and construct wheel structures. */
 static const int s_primes[] = {2, 3, 5, 7, 11, 13, 17, 19, 23, 29, 31, 37, 41,
                                43, 47, 53, 59, 61, 67, 71, 73, 79, 83, 89, 97};
@@ -155,990 +161,4176 @@ void get_root_primes(UI64_ARRAY *primes, uint64_t limit)
     return;
 }
 
+/**
+ * @brief Split a non-negative mpz value below 2^128 into {low, high} 64-bit words.
+ * @param z Input value.
+ * @param words Output words (zeroed high word for single-word values).
+ * @return 1 if @p z fits, 0 otherwise (words untouched).
+ */
+static int mpz_get_u128_words(const mpz_t z, uint64_t words[2])
+{
+    if (mpz_sgn(z) < 0 || mpz_sizeinbase(z, 2) > 128)
+        return 0;
+
+    words[0] = words[1] = 0;
+    mpz_export(words, NULL, -1, sizeof(uint64_t), 0, 0, z);
+    return 1;
+}
+
+/**
+ * @brief Decide primality of values below 2^128 without GMP.
+ * @param n Number to check.
+ * @return 2 if definitely prime, 1 if probably prime, 0 if composite,
+ *         -1 if @p n is negative or needs more than 128 bits.
+ */
+static int test_primality_native(mpz_t n)
+{
+    // 64-bit numbers are settled exactly
+    if (mpz_sgn(n) >= 0 && mpz_sizeinbase(n, 2) <= 64)
+        return test_primality_u64(mpz_get_ui(n)) ? 2 : 0;
+
+    // two-word numbers take the native Baillie-PSW path
+    uint64_t words[2];
+    if (mpz_get_u128_words(n, words))
+        return test_primality_u128(words[1], words[0]);
+
+    return -1;
+}
+
 /**
  * @ingroup iz_toolkit
- * @brief Test the primality of a number using GMP's probabilistic test.
+ * @brief Test the primality of a number.
  * @param n Number to check.
- * @param rounds Number of Miller-Rabin rounds.
+ * @param rounds Number of Miller-Rabin rounds for numbers of 2^128 and above.
  * @return Non-zero if probably prime, 0 if composite.
  *
- * This function serves as a single source of truth for primality testing,
- * wrapping GMP's `mpz_probab_prime_p` function, allowing for changes to
- * the underlying primality testing method in the future without affecting the API.
+ * This function serves as a single source of truth for primality testing in
+ * the search helpers. Numbers below 2^128 take the GMP-free paths of
+ * test_primality_u64() and test_primality_u128(), which do not use
+ * @p rounds; larger numbers go to GMP's `mpz_probab_prime_p`.
  */
 int test_primality(mpz_t n, int rounds)
 {
-    // GMP's mpz_probab_prime_p returns:
-    // 0 if n is composite,
-    // 1 if n is probably prime (without being certain),
-    // 2 if n is definitely prime (only for small n).
-    int is_prime = mpz_probab_prime_p(n, rounds);
-    // ToDo: implement Baillie–PSW primality test for a deterministic alternative to Miller-Rabin, which would return a boolean result instead of a probability.
-
-    return is_prime;
+    int result = test_primality_native(n);
+    return (result >= 0) ? result : mpz_probab_prime_p(n, rounds);
 }
 
-// =========================================================
-// * iZm structure:
-// =========================================================
-
 /**
  * @ingroup iz_toolkit
- * @brief Initialize an iZm structure for a given vx size.
- *
- * @details
- * This function initializes an iZm structure for a specified vx size.
- * It allocates memory for the structure, generates root primes for
- * deterministic sieving, initializes base bitmaps, and constructs
- * pre-sieved base segments for iZm5 and iZm7.
+ * @brief Test the primality of a number with the selected backend.
  *
- * Parameters:
- * @param vx The size of the segment for the iZm structure.
+ * IZ_PRIMALITY_MR always runs GMP's test with the requested @p rounds.
+ * IZ_PRIMALITY_BPSW settles numbers below 2^64 exactly with
+ * test_primality_u64(), numbers below 2^128 with the GMP-free
+ * test_primality_u128(), and larger ones with test_bpsw().
  *
- * @return A pointer to the initialized IZM structure.
+ * @param n Number to check.
+ * @param rounds Number of Miller-Rabin rounds (IZ_PRIMALITY_MR only).
+ * @param backend IZ_PRIMALITY_MR or IZ_PRIMALITY_BPSW.
+ * @return 2 if definitely prime, 1 if probably prime, 0 if composite.
  */
-IZM *iZm_init(size_t vx)
+int test_primality_with(mpz_t n, int rounds, IZ_PRIMALITY_BACKEND backend)
 {
-    // validate vx
-    assert(vx >= 35 && "vx must be at least 35.");
-
-    IZM *iZm = malloc(sizeof(IZM));
-    if (!iZm)
+    if (backend == IZ_PRIMALITY_BPSW)
     {
-        log_error("Memory allocation failed for iZm.");
-        return NULL;
+        int result = test_primality_native(n);
+        return (result >= 0) ? result : test_bpsw(n);
     }
 
-    iZm->vx = vx;
-    // get root primes for deterministic sieving
-    iZm->root_primes = SiZ(vx);
-    // iZm->root_primes = root_limit < pow(10, 7) ? SiZ(root_limit) : SiZm(root_limit);
-    if (!iZm->root_primes)
+    // GMP's mpz_probab_prime_p returns:
+    // 0 if n is composite,
+    // 1 if n is probably prime (without being certain),
+    // 2 if n is definitely prime (only for small n).
+    return mpz_probab_prime_p(n, rounds);
+}
+
+/**
+ * @brief Strong probable-prime test to base 2.
+ * @param n Odd number > 2.
+ * @param d Scratch value (receives the odd part of n-1).
+ * @param t Scratch value.
+ * @param n_1 Scratch value (receives n-1).
+ * @return 1 if n is a strong probable prime to base 2, otherwise 0.
+ */
+static int strong_fermat_base2(mpz_t n, mpz_t d, mpz_t t, mpz_t n_1)
+{
+    mpz_sub_ui(n_1, n, 1);
+    mp_bitcnt_t s = mpz_scan1(n_1, 0);
+    mpz_tdiv_q_2exp(d, n_1, s);
+
+    mpz_set_ui(t, 2);
+    mpz_powm(t, t, d, n);
+    if (mpz_cmp_ui(t, 1) == 0 || mpz_cmp(t, n_1) == 0)
+        return 1;
+
+    for (mp_bitcnt_t r = 1; r < s; r++)
     {
-        log_error("Root primes generation failed for iZm.");
-        free(iZm);
-        return NULL;
+        mpz_powm_ui(t, t, 2, n);
+        if (mpz_cmp(t, n_1) == 0)
+            return 1;
+        if (mpz_cmp_ui(t, 1) == 0)
+            return 0;
     }
+    return 0;
+}
 
-    iZm->k_vx = compute_k_vx(iZm);
+/**
+ * @brief Halve @p x modulo odd @p n in place (x in [0, n)).
+ */
+static inline void mpz_half_mod(mpz_t x, mpz_t n)
+{
+    if (mpz_odd_p(x))
+        mpz_add(x, x, n);
+    mpz_tdiv_q_2exp(x, x, 1);
+}
 
-    // initialize base bitmaps
-    iZm->base_x5 = bitmap_init(vx + 10, 1);
-    iZm->base_x7 = bitmap_init(vx + 10, 1);
-    if (!iZm->base_x5 || !iZm->base_x7)
+/**
+ * @brief Strong Lucas probable-prime test with Selfridge parameters (P = 1, Q = (1 - D) / 4).
+ * @param n Odd number > 2 that is not a perfect square.
+ * @return 1 if n is a strong Lucas probable prime, otherwise 0.
+ */
+static int strong_lucas_selfridge(mpz_t n)
+{
+    // * 1. Find the first D in 5, -7, 9, -11, ... with Jacobi(D/n) = -1
+    long D = 5;
+    mpz_t t;
+    mpz_init(t);
+    for (;;)
     {
-        log_error("Bitmap initialization failed for iZm base segment.");
-        iZm_free(&iZm);
-        ui64_free(&iZm->root_primes);
-        return NULL;
+        mpz_set_si(t, D);
+        int j = mpz_jacobi(t, n);
+        if (j == -1)
+            break;
+        // a shared factor with D proves n composite unless n = |D|
+        if (j == 0 && mpz_cmpabs_ui(n, labs(D)) != 0)
+        {
+            mpz_clear(t);
+            return 0;
+        }
+        D = (D > 0) ? -(D + 2) : -(D - 2);
+    }
+    long Q = (1 - D) / 4;
+
+    // * 2. n + 1 = d * 2^s with d odd
+    mpz_t d, U, V, Qk, mD, mQ, tmp;
+    mpz_inits(d, U, V, Qk, mD, mQ, tmp, NULL);
+    mpz_add_ui(d, n, 1);
+    mp_bitcnt_t s = mpz_scan1(d, 0);
+    mpz_tdiv_q_2exp(d, d, s);
+
+    mpz_set_si(mD, D);
+    mpz_mod(mD, mD, n);
+    mpz_set_si(mQ, Q);
+    mpz_mod(mQ, mQ, n);
+
+    // * 3. Compute U_d, V_d and Q^d mod n by binary expansion of d (P = 1)
+    mpz_set_ui(U, 1);
+    mpz_set_ui(V, 1);
+    mpz_set(Qk, mQ);
+    for (long b = (long)mpz_sizeinbase(d, 2) - 2; b >= 0; b--)
+    {
+        // doubling: U_2k = U_k V_k, V_2k = V_k^2 - 2 Q^k
+        mpz_mul(U, U, V);
+        mpz_mod(U, U, n);
+        mpz_mul(V, V, V);
+        mpz_submul_ui(V, Qk, 2);
+        mpz_mod(V, V, n);
+        mpz_mul(Qk, Qk, Qk);
+        mpz_mod(Qk, Qk, n);
+
+        if (mpz_tstbit(d, b))
+        {
+            // increment: U_k+1 = (U_k + V_k) / 2, V_k+1 = (D U_k + V_k) / 2
+            mpz_mul(tmp, mD, U);
+            mpz_add(U, U, V);
+            mpz_mod(U, U, n);
+            mpz_half_mod(U, n);
+            mpz_add(V, V, tmp);
+            mpz_mod(V, V, n);
+            mpz_half_mod(V, n);
+            mpz_mul(Qk, Qk, mQ);
+            mpz_mod(Qk, Qk, n);
+        }
     }
 
-    // construct pre-sieved base_x5, base_x7 bitmaps
-    iZm_construct_vx_base(vx, iZm->base_x5, iZm->base_x7);
+    // * 4. Strong condition: U_d = 0, or V_(d*2^r) = 0 for some 0 <= r < s
+    int is_prp = mpz_sgn(U) == 0 || mpz_sgn(V) == 0;
+    for (mp_bitcnt_t r = 1; r < s && !is_prp; r++)
+    {
+        mpz_mul(V, V, V);
+        mpz_submul_ui(V, Qk, 2);
+        mpz_mod(V, V, n);
+        mpz_mul(Qk, Qk, Qk);
+        mpz_mod(Qk, Qk, n);
+        is_prp = mpz_sgn(V) == 0;
+    }
 
-    return iZm;
+    mpz_clears(t, d, U, V, Qk, mD, mQ, tmp, NULL);
+    return is_prp;
 }
 
 /**
  * @ingroup iz_toolkit
- * @brief Deep-copy an IZM object for independent worker usage.
- * @param src Source IZM object.
- * @return Cloned IZM object, or NULL on failure.
+ * @brief Baillie-PSW probable-prime test.
+ *
+ * Trial division by the small primes in `s_primes`, a strong Fermat test to
+ * base 2, then a strong Lucas test with Selfridge's parameters. The two tests
+ * fail on largely disjoint sets of composites and no BPSW pseudoprime is known.
+ *
+ * @param n Number to check.
+ * @return 2 if definitely prime (small n), 1 if probably prime, 0 if composite.
  */
-IZM *iZm_clone(IZM *src)
+int test_bpsw(mpz_t n)
 {
-    assert(src && "Invalid source IZM structure for cloning.");
+    if (mpz_cmp_ui(n, 2) < 0)
+        return 0;
 
-    IZM *clone = malloc(sizeof(IZM));
-    assert(clone && "Memory allocation failed for iZm clone.");
+    // * 1. Trial division by small primes; with no factor <= 97, n < 101^2 is prime
+    if (mpz_cmp_ui(n, 101 * 101) < 0)
+    {
+        unsigned long v = mpz_get_ui(n);
+        for (int i = 0; i < s_primes_count; i++)
+        {
+            if (v == (unsigned long)s_primes[i])
+                return 2;
+            if (v % s_primes[i] == 0)
+                return 0;
+        }
+        return 2;
+    }
 
-    clone->vx = src->vx;
-    clone->k_vx = src->k_vx;
-    clone->root_primes = ui64_init(src->root_primes->capacity);
-    if (clone->root_primes == NULL)
+    // larger n: one word-sized reduction per group of small primes
+    for (int i = 0; i < s_primes_count;)
     {
-        log_error("Memory allocation failed for root primes in iZm clone.");
-        iZm_free(&clone);
-        return NULL;
+        int j = i;
+        unsigned long m = 1;
+        while (j < s_primes_count && m <= ULONG_MAX / s_primes[j])
+            m *= s_primes[j++];
+
+        unsigned long r = mpz_fdiv_ui(n, m);
+        for (; i < j; i++)
+            if (r % s_primes[i] == 0)
+                return 0;
     }
-    // copy root primes
-    memcpy(clone->root_primes->array, src->root_primes->array, src->root_primes->count * sizeof(uint64_t));
-    clone->root_primes->count = src->root_primes->count;
 
-    // clone base bitmaps
-    clone->base_x5 = bitmap_clone(src->base_x5);
-    clone->base_x7 = bitmap_clone(src->base_x7);
+    // * 2. Strong probable-prime test to base 2
+    mpz_t d, t, n_1;
+    mpz_inits(d, t, n_1, NULL);
+    int is_prp = strong_fermat_base2(n, d, t, n_1);
+    mpz_clears(d, t, n_1, NULL);
+    if (!is_prp)
+        return 0;
 
-    return clone;
+    // * 3. Strong Lucas test (perfect squares have no D with Jacobi -1)
+    if (mpz_perfect_square_p(n))
+        return 0;
+
+    return strong_lucas_selfridge(n);
 }
 
+#if IZ_PLATFORM_HAS_INT128
 /**
- * @ingroup iz_toolkit
- * @brief Free the memory allocated for an IZM structure.
- *
- * Parameters:
- * @param iZm A pointer to the IZM structure to be freed.
+ * @brief Montgomery product a * b / 2^64 mod n, for a, b < n and odd n.
+ * @param n_inv n^-1 mod 2^64.
  */
-void iZm_free(IZM **iZm)
+static inline uint64_t mont_mul_u64(uint64_t a, uint64_t b, uint64_t n, uint64_t n_inv)
 {
-    if (iZm == NULL || *iZm == NULL)
-        return;
+    iz_uint128_t t = (iz_uint128_t)a * b;
+    uint64_t m = (uint64_t)t * n_inv;
+    uint64_t t_hi = (uint64_t)(t >> 64);
+    uint64_t mn_hi = (uint64_t)(((iz_uint128_t)m * n) >> 64);
 
-    // Free root primes object allocated in iZm_init
-    ui64_free(&(*iZm)->root_primes);
-    bitmap_free(&(*iZm)->base_x5);
-    bitmap_free(&(*iZm)->base_x7);
-    free(*iZm);
-    *iZm = NULL;
+    // the low words of t and m * n are equal, so (t - m * n) / 2^64 = t_hi - mn_hi
+    return t_hi >= mn_hi ? t_hi - mn_hi : t_hi - mn_hi + n;
 }
 
 /**
- * @ingroup iz_toolkit
- * @brief Calculate a VX_{k} as the product of the first k primes > 3.
- *
- * @param k number of consecutive primes (> 3) to include in the product.
- * @return Computed VX_k value.
+ * @brief Strong probable-prime test of odd n to base a, in Montgomery form.
+ * @param n Odd number > 2.
+ * @param n_inv n^-1 mod 2^64.
+ * @param r2 2^128 mod n.
+ * @param one 2^64 mod n (Montgomery 1).
+ * @param d Odd part of n - 1.
+ * @param s Exponent of 2 in n - 1.
+ * @param a Base.
+ * @return 1 if n is a strong probable prime to base a, otherwise 0.
  */
-uint64_t compute_vx_k(int k)
+static int strong_prp_u64(uint64_t n, uint64_t n_inv, uint64_t r2, uint64_t one, uint64_t d, int s, uint64_t a)
 {
-    uint64_t vx = 1;
-    k += 2;    // adjust k to account for skipping 2 and 3
-    int i = 2; // start from prime 5
+    a %= n;
+    if (a == 0)
+        return 1; // base is a multiple of n: no information
 
-    while (i < k && s_primes[i] * vx < UINT64_MAX)
+    uint64_t minus_one = n - one;
+    uint64_t base = mont_mul_u64(a, r2, n, n_inv);
+    uint64_t x = one;
+
+    // x = base^d by left-to-right square-and-multiply
+    for (int bit = 63 - __builtin_clzll(d); bit >= 0; bit--)
     {
-        vx *= s_primes[i++];
+        x = mont_mul_u64(x, x, n, n_inv);
+        if ((d >> bit) & 1)
+            x = mont_mul_u64(x, base, n, n_inv);
     }
 
-    return vx;
+    if (x == one || x == minus_one)
+        return 1;
+
+    for (int r = 1; r < s; r++)
+    {
+        x = mont_mul_u64(x, x, n, n_inv);
+        if (x == minus_one)
+            return 1;
+        if (x == one)
+            return 0;
+    }
+    return 0;
 }
+#endif
 
 /**
  * @ingroup iz_toolkit
- * @brief Choose a cache-aware VX size based on detected L2 capacity.
- * @param n Target numeric sieve bound.
- * @return L2 compatible VX size.
+ * @brief Deterministic primality test for 64-bit integers.
+ *
+ * Trial division by the small primes settles n < 101^2, and the seven-base
+ * strong test {2, 325, 9375, 28178, 450775, 9780504, 1795265022} (J. Sinclair)
+ * has no strong pseudoprime below 2^64. Arithmetic stays in 64-bit Montgomery
+ * form; targets without 128-bit integers fall back to GMP.
+ *
+ * @param n Number to check.
+ * @return 1 if n is prime, 0 otherwise.
  */
-uint64_t compute_l2_vx(uint64_t n)
+int test_primality_u64(uint64_t n)
 {
-    uint64_t l2 = get_cpu_L2_cache_size_bits();
-    uint64_t x_n = n / 6;
-    uint64_t vx = 35; // minimum useful vx size
-    int k = 4;        // pointing to prime 11 in s_primes
+    if (n < 2)
+        return 0;
 
-    // while vx * k-th prime doesn't exceed x_n and l2 cache size
-    while (vx * s_primes[k] < MIN(l2, x_n))
+    // * 1. Trial division by small primes; with no factor <= 97, n < 101^2 is prime
+    for (int i = 0; i < s_primes_count; i++)
     {
-        vx *= s_primes[k];
-        k++;
+        if (n == (uint64_t)s_primes[i])
+            return 1;
+        if (n % s_primes[i] == 0)
+            return 0;
     }
+    if (n < 101 * 101)
+        return 1;
 
-    return vx;
+#if IZ_PLATFORM_HAS_INT128
+    // * 2. Montgomery constants: n^-1 mod 2^64 by Newton iteration, R = 2^64 mod n, R^2 mod n
+    uint64_t n_inv = n; // correct to 3 bits for odd n
+    for (int i = 0; i < 5; i++)
+        n_inv *= 2 - n * n_inv;
+
+    uint64_t one = (0 - n) % n;
+    uint64_t r2 = (uint64_t)(((iz_uint128_t)one * one) % n);
+
+    uint64_t d = n - 1;
+    int s = __builtin_ctzll(d);
+    d >>= s;
+
+    // * 3. Strong tests to the deterministic 64-bit base set
+    static const uint64_t bases[] = {2, 325, 9375, 28178, 450775, 9780504, 1795265022};
+    for (int i = 0; i < (int)(sizeof(bases) / sizeof(bases[0])); i++)
+    {
+        if (!strong_prp_u64(n, n_inv, r2, one, d, s, bases[i]))
+            return 0;
+    }
+    return 1;
+#else
+    mpz_t z;
+    mpz_init(z);
+    mpz_import(z, 1, -1, sizeof(uint64_t), 0, 0, &n);
+    int is_prime = test_bpsw(z) > 0; // BPSW has no pseudoprime below 2^64
+    mpz_clear(z);
+    return is_prime;
+#endif
 }
 
+// =========================================================
+// * Batched 64-bit Miller-Rabin:
+// =========================================================
+
+/** Candidates handled per block by test_primality_u64_batch(). */
+#define IZ_MR_BATCH 256
+
+/** Non-zero keeps test_primality_u64_batch() on the scalar lanes (see test_primality_u64_batch_force_scalar()). */
+static atomic_int s_mr_force_scalar = 0;
+
 /**
  * @ingroup iz_toolkit
- * @brief Compute the maximum vx such that vx < 2^bit_size.
+ * @brief Keep test_primality_u64_batch() on its scalar lanes, even on IFMA CPUs.
+ *
+ * Test hook: lets one host check both lane paths. Set it while no batch runs.
  *
  * Parameters:
- * @param vx      mpz_t variable to store the computed maximum vx value.
- * @param bit_size Integer representing the bit size limit for vx.
+ * @param force Non-zero for the scalar lanes, 0 to follow the CPU again.
  */
-void compute_max_vx(mpz_t vx, int bit_size)
+void test_primality_u64_batch_force_scalar(int force)
 {
-    // get some primes to compute the primorial vx
-    UI64_ARRAY *primes = SiZ(10000);
-    assert(primes && "Failed to generate primes");
-
-    int i = 2;                        // to skip 2, 3
-    mpz_set_ui(vx, primes->array[i]); // set vx = 5
+    atomic_store(&s_mr_force_scalar, force != 0);
+}
 
-    // while vx * primes->array[i] < 2^bit_size
-    while (mpz_sizeinbase(vx, 2) < (size_t)bit_size)
-    {
-        i++;
-        mpz_mul_ui(vx, vx, primes->array[i]);
-    }
+#if IZ_PLATFORM_HAS_INT128
+/** Sinclair bases tested after base 2 (see test_primality_u64()). */
+static const uint64_t s_mr_u64_bases[] = {325, 9375, 28178, 450775, 9780504, 1795265022};
+/** Number of entries in `s_mr_u64_bases`. */
+#define IZ_MR_EXTRA_BASES ((int)(sizeof(s_mr_u64_bases) / sizeof(s_mr_u64_bases[0])))
+
+/** Independent exponentiations per scalar kernel call: interleaved Montgomery chains. */
+#define IZ_MR_LANES 4
+
+#if (defined(__x86_64__) || defined(_M_X64)) && (defined(__GNUC__) || defined(__clang__))
+/** Non-zero when the AVX-512 IFMA lanes are compiled in; they run only if the CPU has them. */
+#define IZ_MR_IFMA 1
+/** Independent exponentiations per IFMA kernel call: 4 vectors of 8 lanes hide the IFMA latency. */
+#define IZ_MR_IFMA_LANES 32
+/** Per-function ISA target of the IFMA kernels, independent of the build flags. */
+#define IZ_MR_IFMA_TARGET __attribute__((target("avx512f,avx512dq,avx512ifma")))
+#else
+#define IZ_MR_IFMA 0
+#define IZ_MR_IFMA_LANES IZ_MR_LANES
+#endif
+
+#if IZ_MR_IFMA
+/** Vectors per IFMA kernel call. */
+#define IZ_MR_VECS (IZ_MR_IFMA_LANES / 8)
 
-    mpz_div_ui(vx, vx, primes->array[i]); // divide by the last prime
+/**
+ * @brief Montgomery product with one 52-bit limb (R = 2^52), for odd n < 2^52 in 8 lanes.
+ * @param n_neg -n^-1 mod 2^52 per lane.
+ */
+IZ_MR_IFMA_TARGET static inline __m512i mont_mul_52x8(__m512i a, __m512i b, __m512i n, __m512i n_neg)
+{
+    const __m512i zero = _mm512_setzero_si512();
+    __m512i lo = _mm512_madd52lo_epu64(zero, a, b);
+    __m512i hi = _mm512_madd52hi_epu64(zero, a, b);
+    __m512i m = _mm512_madd52lo_epu64(zero, lo, n_neg);
+
+    // lo + (m * n mod 2^52) is 0 or 2^52: only its carry survives the division by R
+    __m512i carry = _mm512_srli_epi64(_mm512_madd52lo_epu64(lo, m, n), 52);
+    __m512i r = _mm512_add_epi64(_mm512_madd52hi_epu64(hi, m, n), carry);
+    return _mm512_mask_sub_epi64(r, _mm512_cmpge_epu64_mask(r, n), r, n);
 }
 
 /**
- * @ingroup iz_toolkit
- * @brief Constructs a pre-sieved iZm base segment of size vx.
+ * @brief (a * c) mod n for a * c < 2^83 per lane, with a floating-point quotient estimate.
  *
- * Description:
- * This function constructs a pre-sieved iZm base segment of size vx. It marks
- * all composites of small primes that divide vx in the bitmaps base_x5 (iZ-) and
- * base_x7 (iZ+). This pre-sieved base can then be used as a template for sieving
- * all vx segments.
+ * The estimate is off by at most one, so a single correction in each direction
+ * recovers the exact residue from the low 64 bits.
+ */
+IZ_MR_IFMA_TARGET static inline __m512i mul_mod_fp_x8(__m512i a, __m512i c, __m512i n, __m512d n_pd)
+{
+    const __m512i zero = _mm512_setzero_si512();
+    __m512d q_pd = _mm512_div_pd(_mm512_mul_pd(_mm512_cvtepu64_pd(a), _mm512_cvtepu64_pd(c)), n_pd);
+    __m512i q = _mm512_cvttpd_epu64(_mm512_roundscale_pd(q_pd, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC));
+    __m512i r = _mm512_sub_epi64(_mm512_mullo_epi64(a, c), _mm512_mullo_epi64(q, n));
+    r = _mm512_mask_add_epi64(r, _mm512_cmplt_epi64_mask(r, zero), r, n);
+    return _mm512_mask_sub_epi64(r, _mm512_cmpge_epi64_mask(r, n), r, n);
+}
+
+/**
+ * @brief Lane constants for the two-limb (R = 2^104) IFMA kernel.
+ */
+typedef struct
+{
+    __m512i n;      /**< Modulus. */
+    __m512i n0, n1; /**< 52-bit limbs of n. */
+    __m512i n_neg;  /**< -n^-1 mod 2^52. */
+} MONT_104X8;
+
+/**
+ * @brief Montgomery product a * b / 2^104 mod n with two 52-bit limbs, for 2^52 < n < 2^64.
  *
- * Parameters:
- * @param iZm Pointer to the IZM structure containing the base segment bitmaps.
+ * Limb-serial CIOS; the high limbs stay below 2^13, so the a1 * b1 high half
+ * vanishes and every accumulator fits its 64-bit lane without normalizing
+ * between passes.
  */
-void iZm_construct_vx_base(uint64_t vx, BITMAP *base_x5, BITMAP *base_x7)
+IZ_MR_IFMA_TARGET static inline void mont_mul_104x8(__m512i *r0, __m512i *r1, __m512i a0, __m512i a1,
+                                                    __m512i b0, __m512i b1, const MONT_104X8 *c)
 {
-    assert(base_x5 && base_x7 && "Invalid bitmaps passed to iZm_construct_vx_base.");
+    const __m512i zero = _mm512_setzero_si512();
+
+    // pass 1: t = a * b0, then (t + m * n) / 2^52
+    __m512i t0 = _mm512_madd52lo_epu64(zero, a0, b0);
+    __m512i t1 = _mm512_madd52lo_epu64(_mm512_madd52hi_epu64(zero, a0, b0), a1, b0);
+    __m512i t2 = _mm512_madd52hi_epu64(zero, a1, b0);
+    __m512i m = _mm512_madd52lo_epu64(zero, t0, c->n_neg);
+    t0 = _mm512_madd52lo_epu64(t0, m, c->n0);
+    t1 = _mm512_add_epi64(t1, _mm512_srli_epi64(t0, 52));
+    t1 = _mm512_madd52lo_epu64(_mm512_madd52hi_epu64(t1, m, c->n0), m, c->n1);
+    t2 = _mm512_madd52hi_epu64(t2, m, c->n1);
+
+    // pass 2: t += a * b1, then (t + m * n) / 2^52
+    t0 = _mm512_madd52lo_epu64(t1, a0, b1);
+    t1 = _mm512_madd52lo_epu64(_mm512_madd52hi_epu64(t2, a0, b1), a1, b1);
+    m = _mm512_madd52lo_epu64(zero, t0, c->n_neg);
+    t0 = _mm512_madd52lo_epu64(t0, m, c->n0);
+    t1 = _mm512_add_epi64(t1, _mm512_srli_epi64(t0, 52));
+    t1 = _mm512_madd52lo_epu64(_mm512_madd52hi_epu64(t1, m, c->n0), m, c->n1);
+    t2 = _mm512_madd52hi_epu64(zero, m, c->n1);
+
+    // normalize to limbs, then one conditional subtraction (result < 2n)
+    __m512i x0 = _mm512_and_si512(t1, _mm512_set1_epi64((1LL << 52) - 1));
+    __m512i x1 = _mm512_add_epi64(t2, _mm512_srli_epi64(t1, 52));
+    __m512i d0 = _mm512_sub_epi64(x0, c->n0);
+    __m512i d1 = _mm512_sub_epi64(x1, c->n1);
+    __mmask8 borrow = _mm512_cmplt_epi64_mask(d0, zero);
+    d0 = _mm512_mask_add_epi64(d0, borrow, d0, _mm512_set1_epi64(1LL << 52));
+    d1 = _mm512_mask_sub_epi64(d1, borrow, d1, _mm512_set1_epi64(1));
+    __mmask8 ge = _mm512_cmpge_epi64_mask(d1, zero);
+    *r0 = _mm512_mask_mov_epi64(x0, ge, d0);
+    *r1 = _mm512_mask_mov_epi64(x1, ge, d1);
+}
 
-    bitmap_set_all(base_x5);
-    bitmap_set_all(base_x7);
-    bitmap_clear_bit(base_x5, 0); // clear the 0th bit
-    bitmap_clear_bit(base_x7, 0); // clear the 0th bit
+/** @brief 2x mod n for x < n < 2^64 per lane. */
+IZ_MR_IFMA_TARGET static inline __m512i dbl_mod_x8(__m512i x, __m512i n)
+{
+    __m512i x2 = _mm512_add_epi64(x, x);
+    return _mm512_mask_sub_epi64(x2, _mm512_cmpge_epu64_mask(x, _mm512_sub_epi64(n, x)), x2, n);
+}
 
-    // iterate through small primes that divide vx
-    for (int i = 2; i < s_primes_count; i++)
+/** @brief n^-1 mod 2^64 per lane by Newton iteration (n odd). */
+IZ_MR_IFMA_TARGET static inline __m512i inv_u64_x8(__m512i n)
+{
+    const __m512i two = _mm512_set1_epi64(2);
+    __m512i inv = n;
+    for (int i = 0; i < 5; i++)
+        inv = _mm512_mullo_epi64(inv, _mm512_sub_epi64(two, _mm512_mullo_epi64(n, inv)));
+    return inv;
+}
+
+/**
+ * @brief Strong tests of IZ_MR_IFMA_LANES (n, a) pairs with 2^32 < n < 2^52 (one-limb IFMA).
+ *
+ * Bits of n - 1 are consumed from the top in lock step across lanes. After
+ * bit k, x = a^floor((n-1)/2^k), so a lane meets the strong condition when
+ * x = +-1 at k = s or x = -1 at some 0 < k < s, where 2^s exactly divides n - 1.
+ * With base 2 in every lane the multiply step is a modular doubling.
+ */
+IZ_MR_IFMA_TARGET static void strong_prp_52_lanes(const uint64_t *n_in, const uint64_t *a_in, int base2, uint8_t *pass_out)
+{
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i mask52 = _mm512_set1_epi64((1LL << 52) - 1);
+    __m512i n[IZ_MR_VECS], n_neg[IZ_MR_VECS], one[IZ_MR_VECS], minus_one[IZ_MR_VECS];
+    __m512i base[IZ_MR_VECS], x[IZ_MR_VECS], e[IZ_MR_VECS];
+    __mmask8 pass[IZ_MR_VECS];
+    uint64_t e_bits = 0;
+
+    // * 1. Lane constants: R mod n and a * R mod n from floating-point quotients
+    for (int v = 0; v < IZ_MR_VECS; v++)
     {
-        int p = s_primes[i];
-        if (vx % p != 0)
-            continue;
+        n[v] = _mm512_loadu_si512(n_in + 8 * v);
+        n_neg[v] = _mm512_and_si512(_mm512_sub_epi64(zero, inv_u64_x8(n[v])), mask52);
+        __m512d n_pd = _mm512_cvtepu64_pd(n[v]);
+        one[v] = mul_mod_fp_x8(_mm512_set1_epi64(1LL << 26), _mm512_set1_epi64(1LL << 26), n[v], n_pd);
+        base[v] = mul_mod_fp_x8(_mm512_loadu_si512(a_in + 8 * v), one[v], n[v], n_pd);
+        minus_one[v] = _mm512_sub_epi64(n[v], one[v]);
+        x[v] = one[v];
+        e[v] = _mm512_sub_epi64(n[v], _mm512_set1_epi64(1));
+        e_bits |= (uint64_t)_mm512_reduce_or_epi64(e[v]);
+        pass[v] = 0;
+    }
 
-        int ip = (p % 6 == 1) ? 1 : -1;
-        int xp = (p + 1) / 6;
-        // clear composites in iZ- and iZ+
-        if (ip == -1)
+    // * 2. Lock-step left-to-right exponentiation with the strong condition tracked per lane
+    for (int k = 63 - __builtin_clzll(e_bits); k >= 1; k--)
+    {
+        const __m512i bit = _mm512_set1_epi64(1LL << k);
+        const __m512i low_mask = _mm512_set1_epi64((int64_t)((2ULL << k) - 1));
+        for (int v = 0; v < IZ_MR_VECS; v++)
         {
-            bitmap_clear_bit(base_x5, xp);                        // clear the prime itself
-            bitmap_clear_steps_simd(base_x5, p, p * xp + xp, vx); // mark composites in iZ-
-            bitmap_clear_steps_simd(base_x7, p, p * xp - xp, vx); // mark composites in iZ+
-        }
-        else
-        {
-            bitmap_clear_bit(base_x7, xp);                        // clear the prime itself
-            bitmap_clear_steps_simd(base_x5, p, p * xp - xp, vx); // mark composites in iZ-
-            bitmap_clear_steps_simd(base_x7, p, p * xp + xp, vx); // mark composites in iZ+
+            x[v] = mont_mul_52x8(x[v], x[v], n[v], n_neg[v]);
+            __m512i y = base2 ? dbl_mod_x8(x[v], n[v]) : mont_mul_52x8(x[v], base[v], n[v], n_neg[v]);
+            x[v] = _mm512_mask_mov_epi64(x[v], _mm512_test_epi64_mask(e[v], bit), y);
+
+            __m512i low = _mm512_and_si512(e[v], low_mask);
+            __mmask8 at_s = _mm512_cmpeq_epi64_mask(low, bit);
+            __mmask8 below_s = _mm512_cmpeq_epi64_mask(low, zero);
+            __mmask8 is_one = _mm512_cmpeq_epi64_mask(x[v], one[v]);
+            __mmask8 is_minus_one = _mm512_cmpeq_epi64_mask(x[v], minus_one[v]);
+            pass[v] |= (at_s & (is_one | is_minus_one)) | (below_s & is_minus_one);
         }
     }
+
+    for (int i = 0; i < IZ_MR_IFMA_LANES; i++)
+        pass_out[i] = (pass[i / 8] >> (i % 8)) & 1;
 }
 
 /**
- * @ingroup iz_toolkit
- * @brief Compute the first composite hit of p in the yth vx segment in iZm index space.
- *
- * Description:
- * This function solves for the smallest x that satisfies:
- * (x + vx * y) ≡ x_p (mod p),
- * where x_p is normalized based on the m_id
- * and p to either x_p or p - x_p, then computes x and returns it.
+ * @brief Strong tests of IZ_MR_IFMA_LANES (n, a) pairs with 2^52 < n < 2^64 (two-limb IFMA).
  *
- * Parameters:
- * @param m_id       int matrix identifier (-1 for iZm5, 1 for iZm7).
- * @param p          Unsigned 64-bit integer parameter.
- * @param vx         size_t parameter representing the vx value.
- * @param y          Unsigned 64-bit integer parameter.
+ * Same lock-step scheme as strong_prp_52_lanes(); R mod n and R^2 mod n come
+ * from modular doublings of 2^52 < n.
+ */
+IZ_MR_IFMA_TARGET static void strong_prp_104_lanes(const uint64_t *n_in, const uint64_t *a_in, int base2, uint8_t *pass_out)
+{
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i mask52 = _mm512_set1_epi64((1LL << 52) - 1);
+    MONT_104X8 c[IZ_MR_VECS];
+    __m512i one0[IZ_MR_VECS], one1[IZ_MR_VECS], mo0[IZ_MR_VECS], mo1[IZ_MR_VECS];
+    __m512i b0[IZ_MR_VECS], b1[IZ_MR_VECS], x0[IZ_MR_VECS], x1[IZ_MR_VECS], e[IZ_MR_VECS];
+    __mmask8 pass[IZ_MR_VECS];
+    uint64_t e_bits = 0;
+
+    // * 1. Lane constants: R = 2^104 mod n by doubling, base 2 directly, other bases via R^2
+    for (int v = 0; v < IZ_MR_VECS; v++)
+    {
+        __m512i n = _mm512_loadu_si512(n_in + 8 * v);
+        __m512i a = _mm512_loadu_si512(a_in + 8 * v);
+        c[v].n = n;
+        c[v].n0 = _mm512_and_si512(n, mask52);
+        c[v].n1 = _mm512_srli_epi64(n, 52);
+        c[v].n_neg = _mm512_and_si512(_mm512_sub_epi64(zero, inv_u64_x8(n)), mask52);
+
+        __m512i one = _mm512_set1_epi64(1LL << 52);
+        for (int i = 0; i < 52; i++)
+            one = dbl_mod_x8(one, n);
+
+        __m512i b = dbl_mod_x8(one, n);
+        __mmask8 other = _mm512_cmpneq_epi64_mask(a, _mm512_set1_epi64(2));
+        if (!base2 && other)
+        {
+            __m512i r2 = one;
+            for (int i = 0; i < 104; i++)
+                r2 = dbl_mod_x8(r2, n);
+
+            __m512i ab0, ab1;
+            mont_mul_104x8(&ab0, &ab1, _mm512_and_si512(a, mask52), _mm512_srli_epi64(a, 52),
+                           _mm512_and_si512(r2, mask52), _mm512_srli_epi64(r2, 52), &c[v]);
+            b = _mm512_mask_mov_epi64(b, other, _mm512_or_si512(ab0, _mm512_slli_epi64(ab1, 52)));
+        }
+
+        __m512i mo = _mm512_sub_epi64(n, one);
+        one0[v] = _mm512_and_si512(one, mask52);
+        one1[v] = _mm512_srli_epi64(one, 52);
+        mo0[v] = _mm512_and_si512(mo, mask52);
+        mo1[v] = _mm512_srli_epi64(mo, 52);
+        b0[v] = _mm512_and_si512(b, mask52);
+        b1[v] = _mm512_srli_epi64(b, 52);
+        x0[v] = one0[v];
+        x1[v] = one1[v];
+        e[v] = _mm512_sub_epi64(n, _mm512_set1_epi64(1));
+        e_bits |= (uint64_t)_mm512_reduce_or_epi64(e[v]);
+        pass[v] = 0;
+    }
+
+    // * 2. Lock-step left-to-right exponentiation with the strong condition tracked per lane
+    for (int k = 63 - __builtin_clzll(e_bits); k >= 1; k--)
+    {
+        const __m512i bit = _mm512_set1_epi64((int64_t)(1ULL << k));
+        const __m512i low_mask = _mm512_set1_epi64((int64_t)((2ULL << k) - 1));
+        for (int v = 0; v < IZ_MR_VECS; v++)
+            mont_mul_104x8(&x0[v], &x1[v], x0[v], x1[v], x0[v], x1[v], &c[v]);
+
+        for (int v = 0; v < IZ_MR_VECS; v++)
+        {
+            __m512i y0, y1;
+            if (base2)
+            {
+                __m512i y = dbl_mod_x8(_mm512_or_si512(x0[v], _mm512_slli_epi64(x1[v], 52)), c[v].n);
+                y0 = _mm512_and_si512(y, mask52);
+                y1 = _mm512_srli_epi64(y, 52);
+            }
+            else
+            {
+                mont_mul_104x8(&y0, &y1, x0[v], x1[v], b0[v], b1[v], &c[v]);
+            }
+            __mmask8 set = _mm512_test_epi64_mask(e[v], bit);
+            x0[v] = _mm512_mask_mov_epi64(x0[v], set, y0);
+            x1[v] = _mm512_mask_mov_epi64(x1[v], set, y1);
+        }
+
+        for (int v = 0; v < IZ_MR_VECS; v++)
+        {
+            __m512i low = _mm512_and_si512(e[v], low_mask);
+            __mmask8 at_s = _mm512_cmpeq_epi64_mask(low, bit);
+            __mmask8 below_s = _mm512_cmpeq_epi64_mask(low, zero);
+            __mmask8 is_one = _mm512_cmpeq_epi64_mask(x0[v], one0[v]) & _mm512_cmpeq_epi64_mask(x1[v], one1[v]);
+            __mmask8 is_minus_one = _mm512_cmpeq_epi64_mask(x0[v], mo0[v]) & _mm512_cmpeq_epi64_mask(x1[v], mo1[v]);
+            pass[v] |= (at_s & (is_one | is_minus_one)) | (below_s & is_minus_one);
+        }
+    }
+
+    for (int i = 0; i < IZ_MR_IFMA_LANES; i++)
+        pass_out[i] = (pass[i / 8] >> (i % 8)) & 1;
+}
+#endif
+/**
+ * @brief Strong tests of IZ_MR_LANES (n, a) pairs with 2^32 < n < 2^64 (interleaved scalar).
  *
- * @return The computed x value as a 64-bit unsigned integer.
+ * The lanes run the same lock-step exponentiation as the SIMD kernels, so
+ * their independent multiply chains overlap in the pipeline.
  */
-uint64_t iZm_solve_for_x0(int m_id, uint64_t p, uint64_t vx, uint64_t y)
+static void strong_prp_u64_lanes(const uint64_t *n, const uint64_t *a, int base2, uint8_t *pass)
 {
-    uint64_t xp = (p + 1) / 6;
-    int ip = (p % 6 == 1) ? 1 : -1;
+    uint64_t n_inv[IZ_MR_LANES], one[IZ_MR_LANES], minus_one[IZ_MR_LANES], base[IZ_MR_LANES], x[IZ_MR_LANES];
+    uint64_t e_bits = 0;
 
-    // Optimized start for first segment (y = 0)
-    if (y == 0)
+    for (int l = 0; l < IZ_MR_LANES; l++)
     {
-        return p * xp + m_id * ip * xp;
+        n_inv[l] = n[l];
+        for (int i = 0; i < 5; i++)
+            n_inv[l] *= 2 - n[l] * n_inv[l];
+        one[l] = (0 - n[l]) % n[l];
+        minus_one[l] = n[l] - one[l];
+        base[l] = (uint64_t)(((iz_uint128_t)a[l] * one[l]) % n[l]);
+        x[l] = one[l];
+        pass[l] = 0;
+        e_bits |= n[l] - 1;
     }
 
-    // Normalize x_p to x_p if p_id = m_id, else to p - x_p
-    xp = (m_id == ip) ? xp : p - xp;
-    // Compute the first composite hit of p in the yth vx segment in iZm index space
-    uint64_t x0 = p - (vx * y - xp) % p;
-    // return x0 if it's within the segment, else return 0 for p > vx that doesn't have a hit in the segment
-    return x0 > vx ? 0 : x0;
+    for (int k = 63 - __builtin_clzll(e_bits); k >= 1; k--)
+    {
+        uint64_t bit = 1ULL << k, low_mask = (2ULL << k) - 1;
+        for (int l = 0; l < IZ_MR_LANES; l++)
+        {
+            x[l] = mont_mul_u64(x[l], x[l], n[l], n_inv[l]);
+            uint64_t y = base2 ? (x[l] >= n[l] - x[l] ? x[l] - (n[l] - x[l]) : x[l] + x[l])
+                               : mont_mul_u64(x[l], base[l], n[l], n_inv[l]);
+            uint64_t e = n[l] - 1, low = e & low_mask;
+            x[l] = (e & bit) ? y : x[l];
+            pass[l] |= (low == bit && (x[l] == one[l] || x[l] == minus_one[l])) || (low == 0 && x[l] == minus_one[l]);
+        }
+    }
+}
+
+/**
+ * @brief Run strong tests on @p count (n, a) pairs, a kernel's lane count at a time.
+ *
+ * On CPUs with AVX-512 IFMA, moduli below 2^52 go to the one-limb kernel and
+ * the rest to the two-limb kernel, so each chunk only holds moduli its kernel
+ * supports. Other CPUs run the interleaved scalar kernel.
+ *
+ * @param n Odd moduli, 2^32 < n < 2^64.
+ * @param a Bases, 1 < a < 2^32.
+ * @param count Number of pairs.
+ * @param pass Output: 1 where n is a strong probable prime to base a.
+ */
+static void strong_prp_u64_pairs(const uint64_t *n, const uint64_t *a, int count, uint8_t *pass)
+{
+    uint64_t n_lane[IZ_MR_IFMA_LANES], a_lane[IZ_MR_IFMA_LANES];
+    uint8_t pass_lane[IZ_MR_IFMA_LANES];
+    int lane_idx[IZ_MR_IFMA_LANES];
+
+    // CPU support is queried once; racing threads store the same answer
+    static atomic_int s_ifma = -1;
+    if (s_ifma < 0)
+        s_ifma = IZ_MR_IFMA && iz_platform_cpu_has_avx512ifma();
+    const int ifma = s_ifma && !atomic_load_explicit(&s_mr_force_scalar, memory_order_relaxed);
+    const int chunk = ifma ? IZ_MR_IFMA_LANES : IZ_MR_LANES;
+
+    for (int wide = 0; wide <= ifma; wide++)
+    {
+        int lanes = 0;
+        for (int i = 0; i <= count; i++)
+        {
+            if (i < count && (!ifma || (n[i] >= (1ULL << 52)) == wide))
+                lane_idx[lanes++] = i;
+            if (lanes < chunk && (i < count || lanes == 0))
+                continue;
+
+            // pad a partial chunk with copies of its first pair
+            int base2 = 1;
+            for (int l = 0; l < chunk; l++)
+            {
+                int j = lane_idx[l < lanes ? l : 0];
+                n_lane[l] = n[j];
+                a_lane[l] = a[j];
+                base2 &= a[j] == 2;
+            }
+
+#if IZ_MR_IFMA
+            if (ifma)
+            {
+                if (wide)
+                    strong_prp_104_lanes(n_lane, a_lane, base2, pass_lane);
+                else
+                    strong_prp_52_lanes(n_lane, a_lane, base2, pass_lane);
+            }
+            else
+#endif
+                strong_prp_u64_lanes(n_lane, a_lane, base2, pass_lane);
+            for (int l = 0; l < lanes; l++)
+                pass[lane_idx[l]] = pass_lane[l];
+            lanes = 0;
+        }
+    }
 }
+#endif
 
 /**
  * @ingroup iz_toolkit
- * @brief Solve for x given m_id, p, vx, and y using GMP.
- * Same as above but using GMP. Suitable for arbitrary y values.
+ * @brief Deterministic primality of many 64-bit integers at once.
  *
- * Parameters:
- * @param m_id       int matrix identifier (-1 for iZm5, 1 for iZm7).
- * @param p          Unsigned 64-bit integer parameter.
- * @param vx         Size_t parameter representing the vx value.
- * @param y          mpz_t parameter representing the y value.
+ * Runs the same strong tests as test_primality_u64() but base by base across
+ * the whole batch: every candidate is tested to base 2, then only base-2
+ * survivors take the remaining bases. The exponentiations run in independent
+ * lanes: AVX-512 IFMA vectors when the CPU has them, interleaved scalar
+ * Montgomery chains otherwise. Values up to 2^32 and even values take the
+ * scalar path.
  *
- * @return The computed x value as a 64-bit unsigned integer.
+ * @param n Input values.
+ * @param count Number of values.
+ * @param is_prime Output flags (1 prime, 0 otherwise), one per value.
+ * @return Number of primes in @p n.
  */
-uint64_t iZm_solve_for_x0_mpz(int m_id, uint64_t p, uint64_t vx, mpz_t y)
+int test_primality_u64_batch(const uint64_t *n, int count, uint8_t *is_prime)
 {
-    mpz_t tmp;
-    mpz_init(tmp);
+    assert((n || count == 0) && "n is NULL in test_primality_u64_batch");
+    assert((is_prime || count == 0) && "is_prime is NULL in test_primality_u64_batch");
+
+#if !IZ_PLATFORM_HAS_INT128
+    int primes = 0;
+    for (int i = 0; i < count; i++)
+        primes += is_prime[i] = (uint8_t)test_primality_u64(n[i]);
+    return primes;
+#else
+    uint64_t pair_n[IZ_MR_BATCH * IZ_MR_EXTRA_BASES], pair_a[IZ_MR_BATCH * IZ_MR_EXTRA_BASES];
+    uint8_t pair_pass[IZ_MR_BATCH * IZ_MR_EXTRA_BASES];
+    int idx[IZ_MR_BATCH];
+    int primes = 0;
+
+    for (int start = 0; start < count; start += IZ_MR_BATCH)
+    {
+        int block = MIN(IZ_MR_BATCH, count - start);
+        const uint64_t *nb = n + start;
+        uint8_t *out = is_prime + start;
 
-    // 1. Normalize x_p to x_p if p_id = m_id, else to p - x_p
-    uint64_t xp = (p + 1) / 6;
-    int ip = (p % 6 == 1) ? 1 : -1;
-    xp = (m_id == ip) ? xp : p - xp;
+        // * 1. Small or even values go through the scalar test; the rest take base 2 in lanes
+        int m = 0;
+        for (int i = 0; i < block; i++)
+        {
+            if (nb[i] <= UINT32_MAX || (nb[i] & 1) == 0)
+            {
+                out[i] = (uint8_t)test_primality_u64(nb[i]);
+                continue;
+            }
+            idx[m] = i;
+            pair_n[m] = nb[i];
+            pair_a[m] = 2;
+            m++;
+        }
+        strong_prp_u64_pairs(pair_n, pair_a, m, pair_pass);
 
-    mpz_mul_ui(tmp, y, vx);
-    mpz_sub_ui(tmp, tmp, xp);
-    mpz_mod_ui(tmp, tmp, p);
+        // * 2. Base-2 survivors take the remaining bases, one pair per (value, base)
+        int survivors = 0;
+        for (int j = 0; j < m; j++)
+        {
+            out[idx[j]] = pair_pass[j];
+            if (pair_pass[j])
+                idx[survivors++] = idx[j];
+        }
 
-    uint64_t x = p < vx ? p - mpz_get_ui(tmp) : mpz_get_ui(tmp);
+        int pairs = 0;
+        for (int j = 0; j < survivors; j++)
+        {
+            for (int b = 0; b < IZ_MR_EXTRA_BASES; b++)
+            {
+                pair_n[pairs] = nb[idx[j]];
+                pair_a[pairs] = s_mr_u64_bases[b];
+                pairs++;
+            }
+        }
+        strong_prp_u64_pairs(pair_n, pair_a, pairs, pair_pass);
 
-    mpz_clear(tmp);
-    return x;
+        for (int j = 0; j < survivors; j++)
+        {
+            for (int b = 0; b < IZ_MR_EXTRA_BASES; b++)
+                out[idx[j]] &= pair_pass[j * IZ_MR_EXTRA_BASES + b];
+        }
+
+        for (int i = 0; i < block; i++)
+            primes += out[i];
+    }
+    return primes;
+#endif
 }
 
+#if IZ_PLATFORM_HAS_INT128
 /**
- * @ingroup iz_toolkit
- * @brief Compute the first composite hit of p in the xth vy segment in iZm of width vx.
- *
- * Description:
- * This function solves for the smallest y that satisfies the equation
- * (x + vx * y) ≡ x_p (mod p), where x_p is normalized based on the m_id
- * and p. The function checks if p and vx are co-primes, and if not,
- * it returns -1 indicating no solution can be found. If they are co-primes,
- * it calculates the multiplicative inverse of vx modulo p and computes
- * y using the formula y = (delta * vx_inv) % p, where delta is the
- * difference between x_p and x modulo p.
- *
- * Parameters:
- * @param m_id       int matrix identifier (-1 for iZm5, 1 for iZm7).
- * @param p          Unsigned 64-bit integer parameter.
- * @param vx         Size_t parameter representing the vx value.
- * @param x          Unsigned 64-bit integer parameter.
+ * @brief Montgomery constants for an odd 128-bit modulus (R = 2^128).
+ */
+typedef struct
+{
+    iz_uint128_t n;   /**< Odd modulus. */
+    uint64_t n_neg;   /**< -n^-1 mod 2^64. */
+    iz_uint128_t one; /**< R mod n (Montgomery 1). */
+    iz_uint128_t r2;  /**< R^2 mod n. */
+} MONT_U128;
+
+/** @brief (a + b) mod n for a, b < n, without overflowing 128 bits. */
+static inline iz_uint128_t add_mod_u128(iz_uint128_t a, iz_uint128_t b, iz_uint128_t n)
+{
+    return a >= n - b ? a - (n - b) : a + b;
+}
+
+/** @brief (a - b) mod n for a, b < n. */
+static inline iz_uint128_t sub_mod_u128(iz_uint128_t a, iz_uint128_t b, iz_uint128_t n)
+{
+    return a >= b ? a - b : a + (n - b);
+}
+
+/** @brief x / 2 mod odd n for x < n (linear, so valid in Montgomery form). */
+static inline iz_uint128_t half_mod_u128(iz_uint128_t x, iz_uint128_t n)
+{
+    return (x & 1) ? (x >> 1) + (n >> 1) + 1 : x >> 1;
+}
+
+/**
+ * @brief Montgomery product a * b / 2^128 mod n, for a, b < n.
  *
- * @return The computed y value as a 64-bit unsigned integer.
+ * Two-limb CIOS: each pass multiplies one limb of b in and reduces one limb
+ * out, keeping every partial sum within a 128-bit accumulator.
  */
-int64_t iZm_solve_for_y0(int m_id, uint64_t p, uint64_t vx, uint64_t x)
+static inline iz_uint128_t mont_mul_u128(iz_uint128_t a, iz_uint128_t b, const MONT_U128 *m)
 {
-    // No solution check, if vx and p are not coprime
-    if (gcd(vx, p) != 1)
+    uint64_t a0 = (uint64_t)a, a1 = (uint64_t)(a >> 64);
+    uint64_t b0 = (uint64_t)b, b1 = (uint64_t)(b >> 64);
+    uint64_t n0 = (uint64_t)m->n, n1 = (uint64_t)(m->n >> 64);
+    uint64_t t0, t1, t2, t3, q;
+    iz_uint128_t c;
+
+    // pass 1: t = a * b0, then t = (t + q * n) / 2^64
+    c = (iz_uint128_t)a0 * b0;
+    t0 = (uint64_t)c;
+    c = (iz_uint128_t)a1 * b0 + (c >> 64);
+    t1 = (uint64_t)c;
+    t2 = (uint64_t)(c >> 64);
+
+    q = t0 * m->n_neg;
+    c = (iz_uint128_t)q * n0 + t0;
+    c = (iz_uint128_t)q * n1 + t1 + (c >> 64);
+    t0 = (uint64_t)c;
+    c = (iz_uint128_t)t2 + (c >> 64);
+    t1 = (uint64_t)c;
+    t2 = (uint64_t)(c >> 64);
+
+    // pass 2: t += a * b1, then t = (t + q * n) / 2^64
+    c = (iz_uint128_t)a0 * b1 + t0;
+    t0 = (uint64_t)c;
+    c = (iz_uint128_t)a1 * b1 + t1 + (c >> 64);
+    t1 = (uint64_t)c;
+    c = (iz_uint128_t)t2 + (c >> 64);
+    t2 = (uint64_t)c;
+    t3 = (uint64_t)(c >> 64);
+
+    q = t0 * m->n_neg;
+    c = (iz_uint128_t)q * n0 + t0;
+    c = (iz_uint128_t)q * n1 + t1 + (c >> 64);
+    t0 = (uint64_t)c;
+    c = (iz_uint128_t)t2 + (c >> 64);
+    t1 = (uint64_t)c;
+    t2 = t3 + (uint64_t)(c >> 64);
+
+    // result < 2n: one conditional subtraction (t2 flags a 129th bit)
+    iz_uint128_t r = ((iz_uint128_t)t1 << 64) | t0;
+    return (t2 || r >= m->n) ? r - m->n : r;
+}
+
+/** @brief Prepare Montgomery constants for odd n > 2^64. */
+static void mont_init_u128(MONT_U128 *m, iz_uint128_t n)
+{
+    m->n = n;
+
+    // n^-1 mod 2^64 by Newton iteration on the low limb
+    uint64_t n0 = (uint64_t)n, inv = n0;
+    for (int i = 0; i < 5; i++)
+        inv *= 2 - n0 * inv;
+    m->n_neg = 0 - inv;
+
+    // R mod n = (2^128 - n) mod n; R^2 mod n by 128 modular doublings of R
+    m->one = (0 - n) % n;
+    m->r2 = m->one;
+    for (int i = 0; i < 128; i++)
+        m->r2 = add_mod_u128(m->r2, m->r2, n);
+}
+
+/** @brief Montgomery form of a small non-negative integer. */
+static inline iz_uint128_t mont_from_u64(uint64_t a, const MONT_U128 *m)
+{
+    return mont_mul_u128(a % m->n, m->r2, m);
+}
+
+/** @brief Number of significant bits in @p x (0 for x = 0). */
+static inline int bit_length_u128(iz_uint128_t x)
+{
+    uint64_t hi = (uint64_t)(x >> 64);
+    if (hi)
+        return 128 - __builtin_clzll(hi);
+    return x ? 64 - __builtin_clzll((uint64_t)x) : 0;
+}
+
+/** @brief Jacobi symbol (a/n) for odd n > 0. */
+static int jacobi_u128(iz_uint128_t a, iz_uint128_t n)
+{
+    int j = 1;
+    a %= n;
+    while (a)
     {
-        printf("There's no solution for the given parameters\n");
-        return -1; // No solution can be found
+        while ((a & 1) == 0)
+        {
+            a >>= 1;
+            int r = (int)(n & 7);
+            if (r == 3 || r == 5)
+                j = -j;
+        }
+        iz_uint128_t t = a;
+        a = n;
+        n = t;
+        if ((a & 3) == 3 && (n & 3) == 3)
+            j = -j;
+        a %= n;
     }
+    return n == 1 ? j : 0;
+}
 
-    uint64_t xp = (p + 1) / 6;
-    int ip = (p % 6 == 1) ? 1 : -1;
-    xp = (m_id == ip) ? xp : p - xp;
+/** @brief Return non-zero if @p n is a perfect square. */
+static int is_square_u128(iz_uint128_t n)
+{
+    long double approx = sqrtl((long double)n);
+    uint64_t r = approx >= 18446744073709551615.0L ? UINT64_MAX : (uint64_t)approx;
 
-    // Immediate solution check
-    if (x % p == xp)
-        return 0;
+    // refine to floor(sqrt(n)); long double may carry only 53 bits of precision
+    for (int i = 0; i < 2 && r; i++)
+    {
+        iz_uint128_t next = (r + n / r) >> 1;
+        r = next > UINT64_MAX ? UINT64_MAX : (uint64_t)next;
+    }
+    while ((iz_uint128_t)r * r > n)
+        r--;
+    while (r < UINT64_MAX && (iz_uint128_t)(r + 1) * (r + 1) <= n)
+        r++;
+    return (iz_uint128_t)r * r == n;
+}
 
-    // Compute delta
-    uint64_t x_mod_p = x % p;
-    uint64_t delta = (xp + p - x_mod_p) % p;
+/** @brief Strong probable-prime test of odd n to base 2 in Montgomery form. */
+static int strong_base2_u128(const MONT_U128 *m)
+{
+    iz_uint128_t minus_one = m->n - m->one;
+    iz_uint128_t d = m->n - 1;
+    int s = 0;
+    while ((d & 1) == 0)
+    {
+        d >>= 1;
+        s++;
+    }
 
-    // Find modular inverse
-    uint64_t vx_inv = modular_inverse(vx % p, p);
+    iz_uint128_t base = add_mod_u128(m->one, m->one, m->n);
+    iz_uint128_t x = m->one;
+    for (int bit = bit_length_u128(d) - 1; bit >= 0; bit--)
+    {
+        x = mont_mul_u128(x, x, m);
+        if ((d >> bit) & 1)
+            x = mont_mul_u128(x, base, m);
+    }
 
-    // Compute and return y
-    uint64_t y = (delta * vx_inv) % p;
-    return y;
-}
+    if (x == m->one || x == minus_one)
+        return 1;
 
-// ===================================================
-// * VX_SEG structure:
-// ===================================================
+    for (int r = 1; r < s; r++)
+    {
+        x = mont_mul_u128(x, x, m);
+        if (x == minus_one)
+            return 1;
+        if (x == m->one)
+            return 0;
+    }
+    return 0;
+}
 
 /**
- * @brief Initialize mpz-dependent base fields for a VX segment object.
- * @param vx_obj Segment object to populate.
- * @param y_str Decimal y-coordinate for the segment.
- * @return 1 on success, 0 on parse/initialization failure.
+ * @brief Strong Lucas test with Selfridge parameters, mirroring strong_lucas_selfridge().
+ * @param m Montgomery constants for odd, non-square n.
  */
-static int vx_set_base_values(VX_SEG *vx_obj, char *y_str)
+static int strong_lucas_u128(const MONT_U128 *m)
 {
+    iz_uint128_t n = m->n;
 
-    // assert y_str is numeric
-    mpz_t y_tmp;
-    mpz_init(y_tmp);
-    if (mpz_set_str(y_tmp, y_str, 10) != 0)
+    // * 1. First D in 5, -7, 9, -11, ... with Jacobi(D/n) = -1 (n > 2^64 exceeds every |D|)
+    long D = 5;
+    for (;;)
     {
-        log_error("Invalid numeric string for y in vx_set_base_values\n");
-        mpz_clear(y_tmp);
-        return 0;
+        iz_uint128_t d_mod = D > 0 ? (iz_uint128_t)D : n - (iz_uint128_t)(-D);
+        int j = jacobi_u128(d_mod, n);
+        if (j == -1)
+            break;
+        if (j == 0)
+            return 0;
+        D = (D > 0) ? -(D + 2) : -(D - 2);
     }
+    long Q = (1 - D) / 4;
 
-    mpz_init_set(vx_obj->y, y_tmp);
-    mpz_clear(y_tmp);
+    // * 2. n + 1 = d * 2^s with d odd (n is odd and below 2^128 - 1, so n + 1 fits)
+    iz_uint128_t d = n + 1;
+    int s = 0;
+    while ((d & 1) == 0)
+    {
+        d >>= 1;
+        s++;
+    }
 
-    // Compute yvx = y * vx
-    mpz_init(vx_obj->yvx);
-    mpz_mul_ui(vx_obj->yvx, vx_obj->y, vx_obj->vx);
+    iz_uint128_t mD = D > 0 ? mont_from_u64((uint64_t)D, m) : sub_mod_u128(0, mont_from_u64((uint64_t)(-D), m), n);
+    iz_uint128_t mQ = Q > 0 ? mont_from_u64((uint64_t)Q, m) : sub_mod_u128(0, mont_from_u64((uint64_t)(-Q), m), n);
 
-    // Compute root_limit = sqrt(iZ(vx * (y+1), 1))
-    mpz_init(vx_obj->root_limit);
-    mpz_add_ui(vx_obj->root_limit, vx_obj->yvx, vx_obj->vx);
-    iZ_mpz(vx_obj->root_limit, vx_obj->root_limit, 1);
-    mpz_sqrt(vx_obj->root_limit, vx_obj->root_limit);
+    // * 3. U_d, V_d and Q^d by binary expansion of d (P = 1), all in Montgomery form
+    iz_uint128_t U = m->one, V = m->one, Qk = mQ;
+    for (int b = bit_length_u128(d) - 2; b >= 0; b--)
+    {
+        // doubling: U_2k = U_k V_k, V_2k = V_k^2 - 2 Q^k
+        U = mont_mul_u128(U, V, m);
+        V = sub_mod_u128(mont_mul_u128(V, V, m), add_mod_u128(Qk, Qk, n), n);
+        Qk = mont_mul_u128(Qk, Qk, m);
 
-    // Set is_large_limit to determine if probabilistic primality test is needed
-    // if root_limit > vx
-    vx_obj->is_large_limit = mpz_cmp_ui(vx_obj->root_limit, vx_obj->vx) > 0;
-    return 1;
+        if ((d >> b) & 1)
+        {
+            // increment: U_k+1 = (U_k + V_k) / 2, V_k+1 = (D U_k + V_k) / 2
+            iz_uint128_t DU = mont_mul_u128(mD, U, m);
+            U = half_mod_u128(add_mod_u128(U, V, n), n);
+            V = half_mod_u128(add_mod_u128(V, DU, n), n);
+            Qk = mont_mul_u128(Qk, mQ, m);
+        }
+    }
+
+    // * 4. Strong condition: U_d = 0, or V_(d*2^r) = 0 for some 0 <= r < s
+    int is_prp = U == 0 || V == 0;
+    for (int r = 1; r < s && !is_prp; r++)
+    {
+        V = sub_mod_u128(mont_mul_u128(V, V, m), add_mod_u128(Qk, Qk, n), n);
+        Qk = mont_mul_u128(Qk, Qk, m);
+        is_prp = V == 0;
+    }
+    return is_prp;
 }
 
 /**
- * @brief Deterministic phase: mark composites using root primes.
- * @param iZm Toolkit context containing root-prime table and base bitmaps.
- * @param vx_obj Segment object to update.
+ * @brief Baillie-PSW on a native 128-bit integer; defers to test_primality_u64() below 2^64.
+ * @return 1 if n is a probable prime, 0 otherwise.
  */
-static void vx_det_sieve(IZM *iZm, VX_SEG *vx_obj)
+static int bpsw_u128(iz_uint128_t n)
 {
-    assert(iZm && "iZm is NULL in vx_det_sieve");
-    assert(vx_obj && "vx_obj is NULL in vx_det_sieve");
+    if ((n >> 64) == 0)
+        return test_primality_u64((uint64_t)n);
 
-    int vx = vx_obj->vx; // segment size
+    // * 1. Small-prime trial division, one 128-bit reduction per group of primes
+    for (int i = 0; i < s_primes_count;)
+    {
+        int j = i;
+        uint64_t prod = 1;
+        while (j < s_primes_count && prod <= UINT64_MAX / s_primes[j])
+            prod *= s_primes[j++];
+
+        uint64_t r = (uint64_t)(n % prod);
+        for (; i < j; i++)
+            if (r % s_primes[i] == 0)
+                return 0;
+    }
 
-    // * Deterministic Sieve: Mark composites of primes < vx in x5, x7
-    int start_x = vx_obj->start_x;
-    int end_x = vx_obj->end_x;
-    int k = 2 + iZm->k_vx; // skip 2, 3 and pre-sieved k_vx primes
-    UI64_ARRAY *root_primes = iZm->root_primes;
+    // * 2. Strong base-2 test, then the strong Lucas test (squares have no valid D)
+    MONT_U128 m;
+    mont_init_u128(&m, n);
+    if (!strong_base2_u128(&m))
+        return 0;
+    if (is_square_u128(n))
+        return 0;
+    return strong_lucas_u128(&m);
+}
+#endif
 
-    // if y < 2^64, use iZm_solve_for_x0 version for efficiency
-    if (mpz_sizeinbase(vx_obj->y, 2) <= 64)
-    {
-        uint64_t y = mpz_get_ui(vx_obj->y);
-        uint64_t root_limit = mpz_get_ui(vx_obj->root_limit);
+/**
+ * @ingroup iz_toolkit
+ * @brief Baillie-PSW test for integers below 2^128 given as two machine words.
+ *
+ * Runs in two-limb Montgomery arithmetic without GMP; values below 2^64 are
+ * decided exactly by test_primality_u64(). Targets without 128-bit integers
+ * fall back to test_bpsw().
+ *
+ * @param hi High 64 bits of n.
+ * @param lo Low 64 bits of n.
+ * @return 1 if n is a probable prime (prime when hi is 0), 0 otherwise.
+ */
+int test_primality_u128(uint64_t hi, uint64_t lo)
+{
+    if (hi == 0)
+        return test_primality_u64(lo);
+
+#if IZ_PLATFORM_HAS_INT128
+    return bpsw_u128(((iz_uint128_t)hi << 64) | lo);
+#else
+    mpz_t z;
+    uint64_t words[2] = {lo, hi};
+    mpz_init(z);
+    mpz_import(z, 2, -1, sizeof(uint64_t), 0, 0, words);
+    int is_prime = test_bpsw(z) > 0;
+    mpz_clear(z);
+    return is_prime;
+#endif
+}
+
+// =========================================================
+// * iZm structure:
+// =========================================================
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Initialize an iZm structure for a given vx size.
+ *
+ * @details
+ * This function initializes an iZm structure for a specified vx size.
+ * It allocates memory for the structure, generates root primes for
+ * deterministic sieving, initializes base bitmaps, and constructs
+ * pre-sieved base segments for iZm5 and iZm7.
+ *
+ * Parameters:
+ * @param vx The size of the segment for the iZm structure.
+ *
+ * @return A pointer to the initialized IZM structure.
+ */
+IZM *iZm_init(size_t vx)
+{
+    // validate vx
+    assert(vx >= 35 && "vx must be at least 35.");
+
+    IZM *iZm = malloc(sizeof(IZM));
+    if (!iZm)
+    {
+        log_error("Memory allocation failed for iZm.");
+        return NULL;
+    }
+
+    iZm->vx = vx;
+    // get root primes for deterministic sieving
+    iZm->root_primes = SiZ(vx);
+    // iZm->root_primes = root_limit < pow(10, 7) ? SiZ(root_limit) : SiZm(root_limit);
+    if (!iZm->root_primes)
+    {
+        log_error("Root primes generation failed for iZm.");
+        free(iZm);
+        return NULL;
+    }
+
+    iZm->k_vx = compute_k_vx(iZm);
+
+    // solver constants of the root primes
+    iZm->roots = iZm_roots_init(iZm->root_primes->array, iZm->root_primes->count, vx);
+    if (!iZm->roots)
+    {
+        log_error("Root prime table construction failed for iZm.");
+        ui64_free(&iZm->root_primes);
+        free(iZm);
+        return NULL;
+    }
+
+    // word masks for the small root primes past the wheel
+    iZm->pattern = iZm_construct_pattern(iZm->root_primes, 2 + iZm->k_vx);
+    if (!iZm->pattern)
+    {
+        log_error("Pattern construction failed for iZm.");
+        iZm_roots_free(&iZm->roots);
+        ui64_free(&iZm->root_primes);
+        free(iZm);
+        return NULL;
+    }
+
+    // initialize base bitmaps
+    iZm->base_x5 = bitmap_init(vx + 10, 1);
+    iZm->base_x7 = bitmap_init(vx + 10, 1);
+    if (!iZm->base_x5 || !iZm->base_x7)
+    {
+        log_error("Bitmap initialization failed for iZm base segment.");
+        iZm_free(&iZm);
+        return NULL;
+    }
+
+    // construct pre-sieved base_x5, base_x7 bitmaps
+    iZm_construct_vx_base(vx, iZm->base_x5, iZm->base_x7);
+
+    return iZm;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Deep-copy an IZM object for independent worker usage.
+ * @param src Source IZM object.
+ * @return Cloned IZM object, or NULL on failure.
+ */
+IZM *iZm_clone(IZM *src)
+{
+    assert(src && "Invalid source IZM structure for cloning.");
+
+    IZM *clone = calloc(1, sizeof(IZM)); // zeroed, so iZm_free() is safe on partial clones
+    if (clone == NULL)
+    {
+        log_error("Memory allocation failed for iZm clone.");
+        return NULL;
+    }
+
+    clone->vx = src->vx;
+    clone->k_vx = src->k_vx;
+    clone->root_primes = ui64_init(src->root_primes->capacity);
+    if (clone->root_primes == NULL)
+    {
+        log_error("Memory allocation failed for root primes in iZm clone.");
+        iZm_free(&clone);
+        return NULL;
+    }
+    // copy root primes
+    memcpy(clone->root_primes->array, src->root_primes->array, src->root_primes->count * sizeof(uint64_t));
+    clone->root_primes->count = src->root_primes->count;
+
+    // copy solver constants
+    clone->roots = iZm_roots_clone(src->roots);
+    if (clone->roots == NULL)
+    {
+        log_error("Root prime table copy failed in iZm clone.");
+        iZm_free(&clone);
+        return NULL;
+    }
+
+    // clone base bitmaps
+    clone->base_x5 = bitmap_clone(src->base_x5);
+    clone->base_x7 = bitmap_clone(src->base_x7);
+    if (clone->base_x5 == NULL || clone->base_x7 == NULL)
+    {
+        log_error("Base bitmap copy failed in iZm clone.");
+        iZm_free(&clone);
+        return NULL;
+    }
+
+    // rebuild pattern masks from the same steps
+    clone->pattern = bitmap_pattern_init(src->pattern->steps, src->pattern->count);
+    if (clone->pattern == NULL)
+    {
+        log_error("Pattern construction failed in iZm clone.");
+        iZm_free(&clone);
+        return NULL;
+    }
+
+    return clone;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Free the memory allocated for an IZM structure.
+ *
+ * Parameters:
+ * @param iZm A pointer to the IZM structure to be freed.
+ */
+void iZm_free(IZM **iZm)
+{
+    if (iZm == NULL || *iZm == NULL)
+        return;
+
+    // Free root primes object allocated in iZm_init
+    ui64_free(&(*iZm)->root_primes);
+    iZm_roots_free(&(*iZm)->roots);
+    bitmap_free(&(*iZm)->base_x5);
+    bitmap_free(&(*iZm)->base_x7);
+    bitmap_pattern_free(&(*iZm)->pattern);
+    free(*iZm);
+    *iZm = NULL;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Calculate a VX_{k} as the product of the first k primes > 3.
+ *
+ * @param k number of consecutive primes (> 3) to include in the product.
+ * @return Computed VX_k value.
+ */
+uint64_t compute_vx_k(int k)
+{
+    uint64_t vx = 1;
+    k += 2;    // adjust k to account for skipping 2 and 3
+    int i = 2; // start from prime 5
+
+    while (i < k && s_primes[i] * vx < UINT64_MAX)
+    {
+        vx *= s_primes[i++];
+    }
+
+    return vx;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Choose a cache-aware VX size based on detected L2 capacity.
+ * @param n Target numeric sieve bound.
+ * @return L2 compatible VX size.
+ */
+uint64_t compute_l2_vx(uint64_t n)
+{
+    uint64_t l2 = get_cpu_L2_cache_size_bits();
+    uint64_t x_n = n / 6;
+    uint64_t vx = 35; // minimum useful vx size
+    int k = 4;        // pointing to prime 11 in s_primes
+
+    // while vx * k-th prime doesn't exceed x_n and l2 cache size
+    while (vx * s_primes[k] < MIN(l2, x_n))
+    {
+        vx *= s_primes[k];
+        k++;
+    }
+
+    return vx;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Compute the maximum vx such that vx < 2^bit_size.
+ *
+ * Parameters:
+ * @param vx      mpz_t variable to store the computed maximum vx value.
+ * @param bit_size Integer representing the bit size limit for vx.
+ */
+void compute_max_vx(mpz_t vx, int bit_size)
+{
+    // get some primes to compute the primorial vx
+    UI64_ARRAY *primes = SiZ(10000);
+    assert(primes && "Failed to generate primes");
+
+    int i = 2;                        // to skip 2, 3
+    mpz_set_ui(vx, primes->array[i]); // set vx = 5
+
+    // while vx * primes->array[i] < 2^bit_size
+    while (mpz_sizeinbase(vx, 2) < (size_t)bit_size)
+    {
+        i++;
+        mpz_mul_ui(vx, vx, primes->array[i]);
+    }
+
+    mpz_div_ui(vx, vx, primes->array[i]); // divide by the last prime
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Constructs a pre-sieved iZm base segment of size vx.
+ *
+ * Description:
+ * This function constructs a pre-sieved iZm base segment of size vx. It marks
+ * all composites of small primes that divide vx in the bitmaps base_x5 (iZ-) and
+ * base_x7 (iZ+). This pre-sieved base can then be used as a template for sieving
+ * all vx segments.
+ *
+ * Parameters:
+ * @param iZm Pointer to the IZM structure containing the base segment bitmaps.
+ */
+void iZm_construct_vx_base(uint64_t vx, BITMAP *base_x5, BITMAP *base_x7)
+{
+    assert(base_x5 && base_x7 && "Invalid bitmaps passed to iZm_construct_vx_base.");
+
+    bitmap_set_all(base_x5);
+    bitmap_set_all(base_x7);
+    bitmap_clear_bit(base_x5, 0); // clear the 0th bit
+    bitmap_clear_bit(base_x7, 0); // clear the 0th bit
+
+    // iterate through small primes that divide vx
+    for (int i = 2; i < s_primes_count; i++)
+    {
+        int p = s_primes[i];
+        if (vx % p != 0)
+            continue;
+
+        int ip = (p % 6 == 1) ? 1 : -1;
+        int xp = (p + 1) / 6;
+        // clear composites in iZ- and iZ+
+        if (ip == -1)
+        {
+            bitmap_clear_bit(base_x5, xp);                        // clear the prime itself
+            bitmap_clear_steps_simd(base_x5, p, p * xp + xp, vx); // mark composites in iZ-
+            bitmap_clear_steps_simd(base_x7, p, p * xp - xp, vx); // mark composites in iZ+
+        }
+        else
+        {
+            bitmap_clear_bit(base_x7, xp);                        // clear the prime itself
+            bitmap_clear_steps_simd(base_x5, p, p * xp - xp, vx); // mark composites in iZ-
+            bitmap_clear_steps_simd(base_x7, p, p * xp + xp, vx); // mark composites in iZ+
+        }
+    }
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Builds word-level clearing masks for the densest root primes past the wheel.
+ *
+ * Description:
+ * Primes that do not divide vx must be re-marked in every segment, and the
+ * smallest of them hit several bits per 64-bit word. This function collects
+ * primes[k..] up to IZM_PATTERN_LIMIT into a BITMAP_PATTERN so segment sieves
+ * can clear them with whole-word ANDs (see bitmap_apply_pattern). Since the
+ * masks only depend on p, the same pattern serves both x5 and x7.
+ *
+ * Parameters:
+ * @param primes Ascending prime list (e.g. root primes).
+ * @param k      Index of the first prime not folded into the vx wheel.
+ *
+ * @return Pattern object (possibly empty), or NULL on allocation failure.
+ */
+BITMAP_PATTERN *iZm_construct_pattern(UI64_ARRAY *primes, int k)
+{
+    assert(primes && "Invalid primes array passed to iZm_construct_pattern.");
+
+    int count = 0;
+    while (k + count < primes->count &&
+           count < BITMAP_PATTERN_MAX_COUNT &&
+           primes->array[k + count] <= IZM_PATTERN_LIMIT)
+        count++;
+
+    return bitmap_pattern_init(primes->array + k, count);
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Compute the first composite hit of p in the yth vx segment in iZm index space.
+ *
+ * Description:
+ * This function solves for the smallest x that satisfies:
+ * (x + vx * y) ≡ x_p (mod p),
+ * where x_p is normalized based on the m_id
+ * and p to either x_p or p - x_p, then computes x and returns it.
+ *
+ * Parameters:
+ * @param m_id       int matrix identifier (-1 for iZm5, 1 for iZm7).
+ * @param p          Unsigned 64-bit integer parameter.
+ * @param vx         size_t parameter representing the vx value.
+ * @param y          Unsigned 64-bit integer parameter.
+ *
+ * @return The computed x value as a 64-bit unsigned integer.
+ */
+uint64_t iZm_solve_for_x0(int m_id, uint64_t p, uint64_t vx, uint64_t y)
+{
+    uint64_t xp = (p + 1) / 6;
+    int ip = (p % 6 == 1) ? 1 : -1;
+
+    // Optimized start for first segment (y = 0)
+    if (y == 0)
+    {
+        return p * xp + m_id * ip * xp;
+    }
+
+    // Normalize x_p to x_p if p_id = m_id, else to p - x_p
+    xp = (m_id == ip) ? xp : p - xp;
+    // Compute the first composite hit of p in the yth vx segment in iZm index space
+    uint64_t x0 = p - (vx * y - xp) % p;
+    // return x0 if it's within the segment, else return 0 for p > vx that doesn't have a hit in the segment
+    return x0 > vx ? 0 : x0;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Solve for x given m_id, p, vx, and y using GMP.
+ * Same as above but using GMP. Suitable for arbitrary y values.
+ *
+ * Parameters:
+ * @param m_id       int matrix identifier (-1 for iZm5, 1 for iZm7).
+ * @param p          Unsigned 64-bit integer parameter.
+ * @param vx         Size_t parameter representing the vx value.
+ * @param y          mpz_t parameter representing the y value.
+ *
+ * @return The computed x value as a 64-bit unsigned integer.
+ */
+uint64_t iZm_solve_for_x0_mpz(int m_id, uint64_t p, uint64_t vx, mpz_t y)
+{
+    mpz_t tmp;
+    mpz_init(tmp);
+
+    // 1. Normalize x_p to x_p if p_id = m_id, else to p - x_p
+    uint64_t xp = (p + 1) / 6;
+    int ip = (p % 6 == 1) ? 1 : -1;
+    xp = (m_id == ip) ? xp : p - xp;
+
+    mpz_mul_ui(tmp, y, vx);
+    mpz_sub_ui(tmp, tmp, xp);
+    mpz_mod_ui(tmp, tmp, p);
+
+    uint64_t x = p < vx ? p - mpz_get_ui(tmp) : mpz_get_ui(tmp);
+
+    mpz_clear(tmp);
+    return x;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Compute the first composite hit of p in the xth vy segment in iZm of width vx.
+ *
+ * Description:
+ * This function solves for the smallest y that satisfies the equation
+ * (x + vx * y) ≡ x_p (mod p), where x_p is normalized based on the m_id
+ * and p. The function checks if p and vx are co-primes, and if not,
+ * it returns -1 indicating no solution can be found. If they are co-primes,
+ * it calculates the multiplicative inverse of vx modulo p and computes
+ * y using the formula y = (delta * vx_inv) % p, where delta is the
+ * difference between x_p and x modulo p.
+ *
+ * Parameters:
+ * @param m_id       int matrix identifier (-1 for iZm5, 1 for iZm7).
+ * @param p          Unsigned 64-bit integer parameter.
+ * @param vx         Size_t parameter representing the vx value.
+ * @param x          Unsigned 64-bit integer parameter.
+ *
+ * @return The computed y value as a 64-bit unsigned integer.
+ */
+int64_t iZm_solve_for_y0(int m_id, uint64_t p, uint64_t vx, uint64_t x)
+{
+    // No solution check, if vx and p are not coprime
+    if (gcd(vx, p) != 1)
+        return -1; // No solution can be found
+
+    uint64_t xp = (p + 1) / 6;
+    int ip = (p % 6 == 1) ? 1 : -1;
+    xp = (m_id == ip) ? xp : p - xp;
+
+    // Immediate solution check
+    if (x % p == xp)
+        return 0;
+
+    // Compute delta
+    uint64_t x_mod_p = x % p;
+    uint64_t delta = (xp + p - x_mod_p) % p;
+
+    // Find modular inverse
+    uint64_t vx_inv = modular_inverse(vx % p, p);
+
+    // Compute and return y
+    uint64_t y = (delta * vx_inv) % p;
+    return y;
+}
+
+// ===================================================
+// * Root prime tables:
+// ===================================================
+
+/**
+ * @brief Allocate an IZM_ROOTS table with room for @p count primes.
+ * @param count Number of primes.
+ * @param vx    Segment width.
+ * @return Table with uninitialized entries, or NULL on failure.
+ */
+static IZM_ROOTS *iZm_roots_alloc(int count, uint64_t vx)
+{
+    IZM_ROOTS *roots = calloc(1, sizeof(IZM_ROOTS));
+    if (!roots)
+    {
+        log_error("Memory allocation failed for IZM_ROOTS.");
+        return NULL;
+    }
+
+    roots->count = count;
+    roots->vx = vx;
+
+    size_t n = (size_t)MAX(count, 1);
+    roots->p = malloc(n * sizeof(uint32_t));
+    roots->xp = malloc(n * sizeof(uint32_t));
+    roots->ip = malloc(n * sizeof(int8_t));
+    roots->vx_mod = malloc(n * sizeof(uint32_t));
+    roots->vx_inv = malloc(n * sizeof(uint32_t));
+    roots->p_rcp = malloc(n * sizeof(uint64_t));
+    if (!roots->p || !roots->xp || !roots->ip || !roots->vx_mod || !roots->vx_inv || !roots->p_rcp)
+    {
+        log_error("Memory allocation failed for IZM_ROOTS arrays.");
+        iZm_roots_free(&roots);
+        return NULL;
+    }
+
+    return roots;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Build the solver constants of @p count primes for segment width @p vx.
+ *
+ * Description:
+ * Stores, per prime, x_p, its iZ line, vx mod p, vx^-1 mod p and a 64-bit
+ * reciprocal, so that the hit solvers need no gcd, inversion or division.
+ *
+ * Parameters:
+ * @param primes Primes (< 2^32).
+ * @param count  Number of primes.
+ * @param vx     Segment width.
+ *
+ * @return A pointer to the allocated IZM_ROOTS, or NULL on failure.
+ */
+IZM_ROOTS *iZm_roots_init(const uint64_t *primes, int count, uint64_t vx)
+{
+    assert(count >= 0 && vx > 0 && "Invalid parameters for iZm_roots_init.");
+
+    IZM_ROOTS *roots = iZm_roots_alloc(count, vx);
+    if (!roots)
+        return NULL;
+
+    for (int i = 0; i < count; i++)
+    {
+        uint64_t p = primes[i];
+        assert(p >= 2 && p < (1ULL << 32) && "Root prime out of range in iZm_roots_init.");
+
+        roots->p[i] = (uint32_t)p;
+        roots->xp[i] = (uint32_t)((p + 1) / 6);
+        roots->ip[i] = (p % 6 == 1) ? 1 : -1;
+        roots->vx_mod[i] = (uint32_t)(vx % p);
+        roots->vx_inv[i] = roots->vx_mod[i] ? (uint32_t)modular_inverse(roots->vx_mod[i], p) : 0; // p is prime
+        roots->p_rcp[i] = UINT64_MAX / p;
+    }
+
+    return roots;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Deep-copy an IZM_ROOTS table.
+ * @param src Source table.
+ * @return Copy, or NULL on failure.
+ */
+IZM_ROOTS *iZm_roots_clone(const IZM_ROOTS *src)
+{
+    assert(src && "Invalid source IZM_ROOTS for cloning.");
+
+    IZM_ROOTS *clone = iZm_roots_alloc(src->count, src->vx);
+    if (!clone)
+        return NULL;
+
+    memcpy(clone->p, src->p, src->count * sizeof(uint32_t));
+    memcpy(clone->xp, src->xp, src->count * sizeof(uint32_t));
+    memcpy(clone->ip, src->ip, src->count * sizeof(int8_t));
+    memcpy(clone->vx_mod, src->vx_mod, src->count * sizeof(uint32_t));
+    memcpy(clone->vx_inv, src->vx_inv, src->count * sizeof(uint32_t));
+    memcpy(clone->p_rcp, src->p_rcp, src->count * sizeof(uint64_t));
+    return clone;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Free the memory allocated for an IZM_ROOTS table.
+ * @param roots A pointer to the IZM_ROOTS pointer to be freed.
+ */
+void iZm_roots_free(IZM_ROOTS **roots)
+{
+    if (roots == NULL || *roots == NULL)
+        return;
+
+    free((*roots)->p);
+    free((*roots)->xp);
+    free((*roots)->ip);
+    free((*roots)->vx_mod);
+    free((*roots)->vx_inv);
+    free((*roots)->p_rcp);
+    free(*roots);
+    *roots = NULL;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Reduce a 64-bit value modulo the prime at index i.
+ *
+ * With r = floor((2^64 - 1) / p), the quotient estimate (a * r) >> 64 is at
+ * most 2 below the true quotient, so two conditional subtractions finish.
+ *
+ * @param roots Root prime table.
+ * @param i     Prime index.
+ * @param a     Value to reduce.
+ * @return a mod p.
+ */
+uint64_t iZm_roots_mod(const IZM_ROOTS *roots, int i, uint64_t a)
+{
+    uint64_t p = roots->p[i];
+#if IZ_PLATFORM_HAS_INT128
+    uint64_t q = (uint64_t)(((iz_uint128_t)a * roots->p_rcp[i]) >> 64);
+    uint64_t r = a - q * p;
+    r = (r >= p) ? r - p : r;
+    return (r >= p) ? r - p : r;
+#else
+    return a % p;
+#endif
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Table-driven first x-hit of prime i on line m_id in segment y.
+ *
+ * Same result as iZm_solve_for_x0(m_id, p, vx, y), with (vx * y - x_p') mod p
+ * taken as (vx mod p) * (y mod p) - x_p' from the cached residues.
+ *
+ * @param roots Root prime table.
+ * @param i     Prime index.
+ * @param m_id  Line id (-1 for iZm5, 1 for iZm7).
+ * @param y     Segment index.
+ * @return First x index to clear (0 when p > vx has no hit in segment y).
+ */
+uint64_t iZm_roots_solve_for_x0(const IZM_ROOTS *roots, int i, int m_id, uint64_t y)
+{
+    uint64_t p = roots->p[i];
+    uint64_t xp = roots->xp[i];
+    int ip = roots->ip[i];
+
+    // Optimized start for first segment (y = 0)
+    if (y == 0)
+        return p * xp + m_id * ip * xp;
+
+    // Normalize x_p to x_p if p_id = m_id, else to p - x_p
+    xp = (m_id == ip) ? xp : p - xp;
+
+    uint64_t yvx_mod = iZm_roots_mod(roots, i, (uint64_t)roots->vx_mod[i] * iZm_roots_mod(roots, i, y));
+    uint64_t x0 = p - (yvx_mod >= xp ? yvx_mod - xp : yvx_mod + p - xp);
+    return x0 > roots->vx ? 0 : x0;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Table-driven first y-hit of prime i on line m_id in lane x.
+ *
+ * Same result as iZm_solve_for_y0(m_id, p, vx, x): y = (x_p' - x) * vx^-1 mod p,
+ * using the cached inverse.
+ *
+ * @param roots Root prime table.
+ * @param i     Prime index.
+ * @param m_id  Line id (-1 for iZm5, 1 for iZm7).
+ * @param x     Lane x-coordinate.
+ * @return y index in [0, p), or -1 when p divides vx.
+ */
+int64_t iZm_roots_solve_for_y0(const IZM_ROOTS *roots, int i, int m_id, uint64_t x)
+{
+    uint64_t p = roots->p[i];
+    if (roots->vx_inv[i] == 0)
+        return -1; // No solution can be found
+
+    uint64_t xp = roots->xp[i];
+    xp = (m_id == roots->ip[i]) ? xp : p - xp;
+
+    uint64_t x_mod = iZm_roots_mod(roots, i, x);
+    uint64_t delta = (xp >= x_mod) ? xp - x_mod : xp + p - x_mod;
+    return (int64_t)iZm_roots_mod(roots, i, delta * roots->vx_inv[i]);
+}
+
+// ===================================================
+// * Bucket sieve for large root primes:
+// ===================================================
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Allocate a ring of per-segment buckets for large root primes.
+ *
+ * Description:
+ * The next hit of a prime p is at most p columns ahead, i.e. at most
+ * p / vx + 1 segments ahead, so a ring of max_prime / vx + 2 buckets is
+ * enough to never wrap onto the bucket being processed.
+ *
+ * Parameters:
+ * @param vx        Segment width.
+ * @param max_prime Largest prime that will be added (must be < 2^32).
+ *
+ * @return A pointer to the initialized VX_BUCKETS structure, or NULL on failure.
+ */
+VX_BUCKETS *vx_buckets_init(int vx, uint64_t max_prime)
+{
+    assert(vx > 0 && max_prime < (1ULL << 32) && "Invalid parameters for vx_buckets_init.");
+
+    VX_BUCKETS *buckets = malloc(sizeof(VX_BUCKETS));
+    if (!buckets)
+    {
+        log_error("Memory allocation failed for VX_BUCKETS.");
+        return NULL;
+    }
+
+    buckets->vx = vx;
+    buckets->count = (int)(max_prime / vx) + 2;
+    buckets->current = 0;
+    buckets->x5 = calloc(buckets->count, sizeof(UI64_ARRAY *));
+    buckets->x7 = calloc(buckets->count, sizeof(UI64_ARRAY *));
+    if (!buckets->x5 || !buckets->x7)
+    {
+        log_error("Memory allocation failed for VX_BUCKETS ring.");
+        vx_buckets_free(&buckets);
+        return NULL;
+    }
+
+    for (int i = 0; i < buckets->count; i++)
+    {
+        buckets->x5[i] = ui64_init(64);
+        buckets->x7[i] = ui64_init(64);
+        if (!buckets->x5[i] || !buckets->x7[i])
+        {
+            log_error("Memory allocation failed for VX_BUCKETS bucket.");
+            vx_buckets_free(&buckets);
+            return NULL;
+        }
+    }
+
+    return buckets;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Free the memory allocated for a VX_BUCKETS structure.
+ *
+ * Parameters:
+ * @param buckets A pointer to the VX_BUCKETS structure to be freed.
+ */
+void vx_buckets_free(VX_BUCKETS **buckets)
+{
+    if (buckets == NULL || *buckets == NULL)
+        return;
+
+    for (int i = 0; i < (*buckets)->count; i++)
+    {
+        if ((*buckets)->x5)
+            ui64_free(&(*buckets)->x5[i]);
+        if ((*buckets)->x7)
+            ui64_free(&(*buckets)->x7[i]);
+    }
+    free((*buckets)->x5);
+    free((*buckets)->x7);
+    free(*buckets);
+    *buckets = NULL;
+}
+
+/**
+ * @brief Push a hit into the bucket of the segment it falls in.
+ * @param ring Bucket ring of one line.
+ * @param buckets Owning bucket structure (ring geometry).
+ * @param base Ring index of the segment @p x is relative to.
+ * @param p Prime.
+ * @param x Hit offset relative to segment @p base (1-based).
+ */
+static inline void vx_buckets_push(UI64_ARRAY **ring, VX_BUCKETS *buckets, int base, uint64_t p, uint64_t x)
+{
+    uint64_t ahead = (x - 1) / buckets->vx; // segments ahead of base
+    assert(ahead < (uint64_t)buckets->count && "Bucket hit beyond ring capacity.");
+
+    int slot = (int)((base + ahead) % buckets->count);
+    ui64_push(ring[slot], (p << 32) | (x - ahead * buckets->vx));
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Park a prime in the buckets of its next hits on both lines.
+ *
+ * Parameters:
+ * @param buckets Bucket ring.
+ * @param p       Prime (< 2^32).
+ * @param x5_hit  Next 6x-1 hit, relative to the segment sieved next.
+ * @param x7_hit  Next 6x+1 hit, relative to the segment sieved next.
+ */
+void vx_buckets_add(VX_BUCKETS *buckets, uint64_t p, uint64_t x5_hit, uint64_t x7_hit)
+{
+    assert(buckets && p < (1ULL << 32) && x5_hit > 0 && x7_hit > 0 && "Invalid parameters for vx_buckets_add.");
+
+    vx_buckets_push(buckets->x5, buckets, buckets->current, p, x5_hit);
+    vx_buckets_push(buckets->x7, buckets, buckets->current, p, x7_hit);
+}
+
+/**
+ * @brief Sieve one line's current bucket and move each prime to its next bucket.
+ * @param ring Bucket ring of one line.
+ * @param buckets Owning bucket structure.
+ * @param bitmap Candidate bitmap for the line.
+ * @param end_x Inclusive last x to clear.
+ */
+static void vx_buckets_sieve_line(UI64_ARRAY **ring, VX_BUCKETS *buckets, BITMAP *bitmap, uint64_t end_x)
+{
+    uint64_t vx = buckets->vx;
+    int next = (buckets->current + 1) % buckets->count;
+    UI64_ARRAY *bucket = ring[buckets->current];
+
+    for (int i = 0; i < bucket->count; i++)
+    {
+        uint64_t p = bucket->array[i] >> 32;
+        uint64_t x = bucket->array[i] & 0xFFFFFFFFULL;
+
+        for (; x <= vx; x += p)
+            if (x <= end_x)
+                bitmap->data[x / 8] &= ~(1 << (x % 8));
+
+        // x is now past this segment; re-park it relative to the next one
+        vx_buckets_push(ring, buckets, next, p, x - vx);
+    }
+    bucket->count = 0;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Apply the current segment's bucket hits, then advance the ring.
+ *
+ * Parameters:
+ * @param buckets Bucket ring.
+ * @param x5      Candidate bitmap for 6x-1.
+ * @param x7      Candidate bitmap for 6x+1.
+ * @param end_x   Inclusive last x to clear in this segment.
+ */
+void vx_buckets_sieve(VX_BUCKETS *buckets, BITMAP *x5, BITMAP *x7, int end_x)
+{
+    assert(buckets && x5 && x7 && "Invalid parameters for vx_buckets_sieve.");
+
+    vx_buckets_sieve_line(buckets->x5, buckets, x5, end_x);
+    vx_buckets_sieve_line(buckets->x7, buckets, x7, end_x);
+    buckets->current = (buckets->current + 1) % buckets->count;
+}
+
+// ===================================================
+// * Sieving state across consecutive segments
+// ===================================================
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Allocate a sieving state for the root primes of an IZM context.
+ *
+ * Tracks every root prime past 2, 3 and the pre-sieved wheel primes. Offsets
+ * are left unsolved until the first vx_state_sync() call.
+ *
+ * Parameters:
+ * @param iZm Initialized toolkit context.
+ *
+ * @return A pointer to the allocated VX_SIEVE_STATE, or NULL on failure.
+ */
+VX_SIEVE_STATE *vx_state_init(IZM *iZm)
+{
+    return vx_state_init_depth(iZm, 0);
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Allocate a sieving state for all primes up to a given depth.
+ *
+ * The root primes of @p iZm are followed by the primes in (vx, depth], which
+ * are generated once with SiZm(). Both share the offset arrays: a prime above
+ * vx simply never hits a segment more than once per line.
+ *
+ * Parameters:
+ * @param iZm   Initialized toolkit context.
+ * @param depth Sieving depth (<= IZ_SIEVE_DEPTH_MAX; values <= vx track the root primes only).
+ *
+ * @return A pointer to the allocated VX_SIEVE_STATE, or NULL on failure.
+ */
+VX_SIEVE_STATE *vx_state_init_depth(IZM *iZm, uint64_t depth)
+{
+    assert(iZm && iZm->root_primes && "Invalid IZM passed to vx_state_init_depth.");
+    assert(depth <= IZ_SIEVE_DEPTH_MAX && "Sieving depth out of range in vx_state_init_depth.");
+
+    // * 1. Collect the primes above vx, if sieving deeper than the root primes
+    UI64_ARRAY *deep_primes = NULL;
+    int deep_first = 0;
+    if (depth > (uint64_t)iZm->vx)
+    {
+        deep_primes = SiZm(depth);
+        if (!deep_primes)
+        {
+            log_error("Deep prime generation failed in vx_state_init_depth.");
+            return NULL;
+        }
+
+        while (deep_first < deep_primes->count && deep_primes->array[deep_first] <= (uint64_t)iZm->vx)
+            deep_first++;
+        while (deep_primes->count > deep_first && deep_primes->array[deep_primes->count - 1] > depth)
+            deep_primes->count--;
+    }
+
+    VX_SIEVE_STATE *state = malloc(sizeof(VX_SIEVE_STATE));
+    if (!state)
+    {
+        log_error("Memory allocation failed for VX_SIEVE_STATE.");
+        ui64_free(&deep_primes);
+        return NULL;
+    }
+
+    // * 2. Allocate offsets for root primes followed by deep primes
+    state->vx = iZm->vx;
+    state->k = 2 + iZm->k_vx;
+    state->deep_start = MAX(iZm->root_primes->count - state->k, 0);
+    state->count = state->deep_start + (deep_primes ? deep_primes->count - deep_first : 0);
+    state->depth = MAX(depth, (uint64_t)iZm->vx);
+    state->synced = 0;
+    mpz_init(state->y);
+
+    size_t n = (size_t)MAX(state->count, 1);
+    state->primes = malloc(n * sizeof(uint32_t));
+    state->vx_mod = malloc(n * sizeof(uint32_t));
+    state->y_mod = malloc(n * sizeof(uint32_t));
+    state->x5_next = malloc(n * sizeof(uint32_t));
+    state->x7_next = malloc(n * sizeof(uint32_t));
+    state->group_count = 0;
+    state->moduli = malloc(n * sizeof(unsigned long));
+    state->group_end = malloc(n * sizeof(int));
+    if (!state->primes || !state->vx_mod || !state->y_mod || !state->x5_next || !state->x7_next ||
+        !state->moduli || !state->group_end)
+    {
+        log_error("Memory allocation failed for VX_SIEVE_STATE offsets.");
+        ui64_free(&deep_primes);
+        vx_state_free(&state);
+        return NULL;
+    }
+
+    // * 3. Cache vx mod p and pack the primes into word-sized moduli
+    for (int i = 0; i < state->count; i++)
+    {
+        uint64_t p = (i < state->deep_start) ? iZm->root_primes->array[state->k + i]
+                                              : deep_primes->array[deep_first + i - state->deep_start];
+        assert(p < (1ULL << 32) && state->vx % p != 0 && "Root prime out of range in vx_state_init_depth.");
+
+        state->primes[i] = (uint32_t)p;
+        state->vx_mod[i] = (uint32_t)(state->vx % p);
+
+        // pack consecutive primes into word-sized moduli for multi-word y
+        int g = state->group_count;
+        if (g > 0 && state->moduli[g - 1] <= ULONG_MAX / p)
+        {
+            state->moduli[g - 1] *= p;
+            state->group_end[g - 1] = i + 1;
+        }
+        else
+        {
+            state->moduli[g] = p;
+            state->group_end[g] = i + 1;
+            state->group_count++;
+        }
+    }
+
+    ui64_free(&deep_primes);
+    return state;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Copy a VX_SIEVE_STATE structure.
+ *
+ * Parameters:
+ * @param src Source state.
+ *
+ * @return A pointer to the copy, or NULL on failure.
+ */
+VX_SIEVE_STATE *vx_state_clone(const VX_SIEVE_STATE *src)
+{
+    assert(src && "Invalid source VX_SIEVE_STATE for cloning.");
+
+    VX_SIEVE_STATE *clone = malloc(sizeof(VX_SIEVE_STATE));
+    if (!clone)
+    {
+        log_error("Memory allocation failed for VX_SIEVE_STATE clone.");
+        return NULL;
+    }
+
+    // * 1. Copy the scalars, then give the clone its own y and arrays
+    *clone = *src;
+    mpz_init_set(clone->y, src->y);
+
+    size_t n = (size_t)MAX(src->count, 1);
+    clone->primes = malloc(n * sizeof(uint32_t));
+    clone->vx_mod = malloc(n * sizeof(uint32_t));
+    clone->y_mod = malloc(n * sizeof(uint32_t));
+    clone->x5_next = malloc(n * sizeof(uint32_t));
+    clone->x7_next = malloc(n * sizeof(uint32_t));
+    clone->moduli = malloc(n * sizeof(unsigned long));
+    clone->group_end = malloc(n * sizeof(int));
+    if (!clone->primes || !clone->vx_mod || !clone->y_mod || !clone->x5_next || !clone->x7_next ||
+        !clone->moduli || !clone->group_end)
+    {
+        log_error("Memory allocation failed for VX_SIEVE_STATE clone offsets.");
+        vx_state_free(&clone);
+        return NULL;
+    }
+
+    // * 2. Copy primes, residues, offsets and group moduli
+    size_t count = (size_t)src->count;
+    memcpy(clone->primes, src->primes, count * sizeof(uint32_t));
+    memcpy(clone->vx_mod, src->vx_mod, count * sizeof(uint32_t));
+    memcpy(clone->y_mod, src->y_mod, count * sizeof(uint32_t));
+    memcpy(clone->x5_next, src->x5_next, count * sizeof(uint32_t));
+    memcpy(clone->x7_next, src->x7_next, count * sizeof(uint32_t));
+    memcpy(clone->moduli, src->moduli, (size_t)src->group_count * sizeof(unsigned long));
+    memcpy(clone->group_end, src->group_end, (size_t)src->group_count * sizeof(int));
+
+    return clone;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Free the memory allocated for a VX_SIEVE_STATE structure.
+ *
+ * Parameters:
+ * @param state A pointer to the VX_SIEVE_STATE structure to be freed.
+ */
+void vx_state_free(VX_SIEVE_STATE **state)
+{
+    if (state == NULL || *state == NULL)
+        return;
+
+    free((*state)->primes);
+    free((*state)->vx_mod);
+    free((*state)->y_mod);
+    free((*state)->x5_next);
+    free((*state)->x7_next);
+    free((*state)->moduli);
+    free((*state)->group_end);
+    mpz_clear((*state)->y);
+    free(*state);
+    *state = NULL;
+}
+
+/**
+ * @brief Compute y mod p for every tracked prime into @ref VX_SIEVE_STATE::y_mod.
+ *
+ * Multi-word y is reduced once per word-sized group modulus (a single pass of
+ * mpn-level single-limb division), and each prime's residue is then taken from
+ * the one-word group remainder.
+ *
+ * @param state Sieving state.
+ * @param y Segment index.
+ */
+static void vx_state_residues(VX_SIEVE_STATE *state, mpz_t y)
+{
+    if (mpz_sizeinbase(y, 2) <= 64)
+    {
+        uint64_t y_u64 = mpz_get_ui(y);
+        for (int i = 0; i < state->count; i++)
+            state->y_mod[i] = (uint32_t)(y_u64 % state->primes[i]);
+        return;
+    }
+
+    int i = 0;
+    for (int g = 0; g < state->group_count; g++)
+    {
+        unsigned long r = mpz_fdiv_ui(y, state->moduli[g]);
+        for (; i < state->group_end[g]; i++)
+            state->y_mod[i] = (uint32_t)(r % state->primes[i]);
+    }
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Solve the first hits of all tracked primes in segment y, unless already there.
+ *
+ * A jump costs one batch of y mod p residues (see vx_state_residues()), shared
+ * by both lines; the hit is then x0 = p - (y*vx - x_p) mod p, as in
+ * iZm_solve_for_x0(). Syncing to the segment the state already points at is free.
+ *
+ * Parameters:
+ * @param state Sieving state.
+ * @param y     Segment index (must be > 0).
+ */
+void vx_state_sync(VX_SIEVE_STATE *state, mpz_t y)
+{
+    assert(state && mpz_sgn(y) > 0 && "Invalid parameters for vx_state_sync.");
+
+    if (state->synced && mpz_cmp(state->y, y) == 0)
+        return;
+
+    vx_state_residues(state, y);
+
+    for (int i = 0; i < state->count; i++)
+    {
+        uint64_t p = state->primes[i];
+        uint64_t yvx_mod = ((uint64_t)state->y_mod[i] * state->vx_mod[i]) % p;
+
+        // normalize x_p per line as in iZm_solve_for_x0
+        uint64_t xp = (p + 1) / 6;
+        int ip = (p % 6 == 1) ? 1 : -1;
+        uint64_t xp5 = (ip == -1) ? xp : p - xp;
+        uint64_t xp7 = (ip == 1) ? xp : p - xp;
+
+        state->x5_next[i] = (uint32_t)(p - (yvx_mod + p - xp5) % p);
+        state->x7_next[i] = (uint32_t)(p - (yvx_mod + p - xp7) % p);
+    }
+
+    mpz_set(state->y, y);
+    state->synced = 1;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Advance all offsets to the following segment.
+ *
+ * Every hit of p shifts left by vx between consecutive segments, so each
+ * offset moves by -(vx mod p), wrapped back into [1, p].
+ *
+ * Parameters:
+ * @param state Synced sieving state.
+ */
+void vx_state_advance(VX_SIEVE_STATE *state)
+{
+    assert(state && state->synced && "vx_state_advance requires a synced state.");
+
+    for (int i = 0; i < state->count; i++)
+    {
+        uint32_t p = state->primes[i];
+        uint32_t vx_mod = state->vx_mod[i];
+        uint32_t x5 = state->x5_next[i];
+        uint32_t x7 = state->x7_next[i];
+
+        // x - vx_mod, or x + p - vx_mod when that wraps below 1 (no 32-bit overflow near 2^32)
+        state->x5_next[i] = x5 > vx_mod ? x5 - vx_mod : x5 + (p - vx_mod);
+        state->x7_next[i] = x7 > vx_mod ? x7 - vx_mod : x7 + (p - vx_mod);
+    }
+
+    mpz_add_ui(state->y, state->y, 1);
+}
+
+/** Approximate cost (ns) of one composite Miller-Rabin test on a 64-bit candidate. */
+#define IZ_COST_MR_64_NS 750.0
+/** Approximate cost (ns) of carrying one deep prime across a segment, both lines. */
+#define IZ_COST_SIEVE_NS 4.0
+/** Approximate one-off cost (ns) per deep prime: generation and the first offset solve. */
+#define IZ_COST_SETUP_NS 60.0
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Choose a sieving depth for numbers of a given bit size.
+ *
+ * A prime added at depth B removes about 1.68 N / (B ln B) of the N candidates
+ * a worker tests, and costs one offset update per segment plus its setup.
+ * Equating both sides gives B ln B = 1.68 N c_mr / c_prime, solved here by
+ * fixed-point iteration. The Miller-Rabin cost c_mr grows like bit_size^1.8
+ * in the GMP range of interest.
+ *
+ * Parameters:
+ * @param vx       Segment width.
+ * @param bit_size Bit size of the largest number to sieve.
+ * @param x_span   Number of x columns one worker sieves (0 = one full segment).
+ *
+ * @return The sieving depth, clamped to [vx, IZ_SIEVE_DEPTH_AUTO_MAX] and to the root limit.
+ */
+uint64_t iZ_auto_sieve_depth(int vx, int bit_size, uint64_t x_span)
+{
+    assert(vx > 0 && "Invalid vx passed to iZ_auto_sieve_depth.");
+
+    // * 1. Nothing to gain once the root primes already cover sqrt(n)
+    uint64_t root_limit = (bit_size >= 128) ? UINT64_MAX : (uint64_t)ceil(pow(2.0, bit_size / 2.0));
+    if (root_limit <= (uint64_t)vx)
+        return vx;
+
+    // * 2. Solve B ln B = 1.68 N c_mr / c_prime
+    if (x_span == 0)
+        x_span = vx;
+    double segments = ceil((double)x_span / vx);
+    double candidates = 2.0 * (double)x_span;
+    double mr_ns = IZ_COST_MR_64_NS * pow(MAX(bit_size, 64) / 64.0, 1.8);
+    double prime_ns = segments * IZ_COST_SIEVE_NS + IZ_COST_SETUP_NS;
+    double rhs = 1.68 * candidates * mr_ns / prime_ns;
+
+    double depth = rhs / 20.0;
+    for (int i = 0; i < 8; i++)
+        depth = rhs / log(MAX(depth, 3.0));
+
+    // * 3. Clamp to the useful range
+    if (depth <= vx)
+        return vx;
+
+    uint64_t limit = MIN(root_limit, IZ_SIEVE_DEPTH_AUTO_MAX);
+    return depth >= (double)limit ? limit : (uint64_t)depth;
+}
+
+// ===================================================
+// * VX_SEG structure:
+// ===================================================
+
+/**
+ * @brief Derive root_limit, is_large_limit and the 64/128-bit fast paths from the segment's yvx.
+ * @param vx_obj Segment object with initialized mpz fields and yvx set.
+ */
+static void vx_set_limits(VX_SEG *vx_obj)
+{
+    // Candidates fit 64 bits while iZ(yvx + vx, 1) < 2^64
+    mpz_add_ui(vx_obj->root_limit, vx_obj->yvx, vx_obj->vx);
+    vx_obj->is_u64 = mpz_cmp_ui(vx_obj->root_limit, (UINT64_MAX - 1) / 6) <= 0;
+    vx_obj->yvx_u64 = vx_obj->is_u64 ? mpz_get_ui(vx_obj->yvx) : 0;
+
+    // Compute root_limit = sqrt(iZ(vx * (y+1), 1)); the largest candidate decides the 128-bit path
+    iZ_mpz(vx_obj->root_limit, vx_obj->root_limit, 1);
+    vx_obj->is_u128 = IZ_PLATFORM_HAS_INT128 && mpz_sizeinbase(vx_obj->root_limit, 2) <= 128;
+    vx_obj->yvx_u128[0] = vx_obj->yvx_u128[1] = 0;
+    if (vx_obj->is_u128)
+        mpz_get_u128_words(vx_obj->yvx, vx_obj->yvx_u128);
+    mpz_sqrt(vx_obj->root_limit, vx_obj->root_limit);
+
+    // Set is_large_limit to determine if probabilistic primality test is needed
+    // if root_limit exceeds the sieving depth
+    vx_obj->is_large_limit = mpz_cmp_ui(vx_obj->root_limit, vx_obj->sieve_depth) > 0;
+}
+
+/**
+ * @brief Initialize mpz-dependent base fields for a VX segment object.
+ * @param vx_obj Segment object to populate.
+ * @param y_str Decimal y-coordinate for the segment.
+ * @return 1 on success, 0 on parse/initialization failure.
+ */
+static int vx_set_base_values(VX_SEG *vx_obj, char *y_str)
+{
+
+    // assert y_str is numeric
+    mpz_t y_tmp;
+    mpz_init(y_tmp);
+    if (mpz_set_str(y_tmp, y_str, 10) != 0)
+    {
+        log_error("Invalid numeric string for y in vx_set_base_values\n");
+        mpz_clear(y_tmp);
+        return 0;
+    }
+
+    mpz_init_set(vx_obj->y, y_tmp);
+    mpz_clear(y_tmp);
+
+    // Compute yvx = y * vx
+    mpz_init(vx_obj->yvx);
+    mpz_mul_ui(vx_obj->yvx, vx_obj->y, vx_obj->vx);
+
+    mpz_init(vx_obj->root_limit);
+    vx_set_limits(vx_obj);
+    return 1;
+}
+
+/**
+ * @brief Deterministic phase: mark composites using root primes.
+ * @param iZm Toolkit context containing root-prime table and base bitmaps.
+ * @param vx_obj Segment object to update.
+ * @param state Optional sieving state; when set, root-prime offsets are read from
+ *              it instead of being solved, and it is advanced to the next segment.
+ */
+static void vx_det_sieve(IZM *iZm, VX_SEG *vx_obj, VX_SIEVE_STATE *state)
+{
+    assert(iZm && "iZm is NULL in vx_det_sieve");
+    assert(vx_obj && "vx_obj is NULL in vx_det_sieve");
+
+    int vx = vx_obj->vx; // segment size
+
+    // * Deterministic Sieve: Mark composites of primes < vx in x5, x7
+    int start_x = vx_obj->start_x;
+    int end_x = vx_obj->end_x;
+    int k = 2 + iZm->k_vx; // skip 2, 3 and pre-sieved k_vx primes
+    UI64_ARRAY *root_primes = iZm->root_primes;
+
+    // the first root primes past the wheel are cleared word-wise via iZm->pattern
+    BITMAP_PATTERN *pattern = iZm->pattern;
+    uint64_t x5_starts[BITMAP_PATTERN_MAX_COUNT];
+    uint64_t x7_starts[BITMAP_PATTERN_MAX_COUNT];
+
+    // if y * vx >= 2^64 and no state is given, solve through a state cached on the
+    // segment, which batches the multi-word y mod p reductions
+    if (!state && mpz_sizeinbase(vx_obj->yvx, 2) > 64)
+    {
+        if (!vx_obj->state)
+            vx_obj->state = vx_state_init(iZm);
+        state = vx_obj->state;
+        if (!state)
+            log_error("Sieving state allocation failed in vx_det_sieve; solving root-prime hits one by one");
+    }
+
+    // if a sieving state is given, reuse its carried offsets (the first segment, y = 0, is solved directly)
+    if (state && mpz_sgn(vx_obj->y) > 0)
+    {
+        assert(state->vx == vx && state->k == k && "Sieving state does not match iZm in vx_det_sieve");
+        vx_state_sync(state, vx_obj->y);
+
+        uint64_t root_limit = mpz_sizeinbase(vx_obj->root_limit, 2) <= 64 ? mpz_get_ui(vx_obj->root_limit) : UINT64_MAX;
+
+        for (int i = 0; i < pattern->count; i++)
+        {
+            uint64_t p = pattern->steps[i];
+            int active = p <= root_limit;
+
+            x5_starts[i] = active ? state->x5_next[i] : UINT64_MAX;
+            x7_starts[i] = active ? state->x7_next[i] : UINT64_MAX;
+            vx_obj->bit_ops += active ? (2 * end_x) / p : 0;
+        }
+        bitmap_apply_pattern(vx_obj->x5, pattern, x5_starts, end_x);
+        bitmap_apply_pattern(vx_obj->x7, pattern, x7_starts, end_x);
+
+        for (int i = pattern->count; i < state->deep_start; i++)
+        {
+            uint64_t p = state->primes[i];
+
+            if (p > root_limit)
+                break;
+
+            bitmap_clear_steps_simd(vx_obj->x5, p, state->x5_next[i], end_x);
+            bitmap_clear_steps_simd(vx_obj->x7, p, state->x7_next[i], end_x);
+
+            vx_obj->bit_ops += (2 * end_x) / p;
+        }
+
+        // primes above vx hit each line at most once per segment
+        for (int i = state->deep_start; i < state->count; i++)
+        {
+            uint32_t p = state->primes[i];
+
+            if (p > root_limit)
+                break;
+
+            if (state->x5_next[i] <= (uint32_t)end_x)
+            {
+                bitmap_clear_bit(vx_obj->x5, state->x5_next[i]);
+                vx_obj->bit_ops++;
+            }
+            if (state->x7_next[i] <= (uint32_t)end_x)
+            {
+                bitmap_clear_bit(vx_obj->x7, state->x7_next[i]);
+                vx_obj->bit_ops++;
+            }
+        }
+
+        vx_state_advance(state);
+    }
+    // if y * vx < 2^64, use iZm_solve_for_x0 version for efficiency
+    else if (mpz_sizeinbase(vx_obj->yvx, 2) <= 64)
+    {
+        uint64_t y = mpz_get_ui(vx_obj->y);
+        uint64_t root_limit = mpz_get_ui(vx_obj->root_limit);
+
+        // solve through the cached per-prime constants (index-aligned with root_primes)
+        const IZM_ROOTS *roots = iZm->roots;
+        for (int i = 0; i < pattern->count; i++)
+        {
+            uint64_t p = pattern->steps[i];
+            int active = p <= root_limit;
+
+            x5_starts[i] = active ? iZm_roots_solve_for_x0(roots, k + i, -1, y) : UINT64_MAX;
+            x7_starts[i] = active ? iZm_roots_solve_for_x0(roots, k + i, 1, y) : UINT64_MAX;
+            vx_obj->bit_ops += active ? (2 * end_x) / p : 0;
+        }
+        bitmap_apply_pattern(vx_obj->x5, pattern, x5_starts, end_x);
+        bitmap_apply_pattern(vx_obj->x7, pattern, x7_starts, end_x);
+
+        // Iterate through the remaining root primes
+        for (int i = k + pattern->count; i < root_primes->count; i++)
+        {
+            uint64_t p = root_primes->array[i];
+
+            if (p > root_limit)
+                break;
+
+            // Mark composites of p in x5 and x7
+            bitmap_clear_steps_simd(vx_obj->x5, p, iZm_roots_solve_for_x0(roots, i, -1, y), end_x);
+            bitmap_clear_steps_simd(vx_obj->x7, p, iZm_roots_solve_for_x0(roots, i, 1, y), end_x);
+
+            vx_obj->bit_ops += (2 * end_x) / p; // approximate number of bit operations
+        }
+    }
+    else
+    {
+        // no state could be allocated: the same as above but using iZm_solve_for_x0_mpz version
+        for (int i = 0; i < pattern->count; i++)
+        {
+            uint64_t p = pattern->steps[i];
+
+            x5_starts[i] = iZm_solve_for_x0_mpz(-1, p, vx, vx_obj->y);
+            x7_starts[i] = iZm_solve_for_x0_mpz(1, p, vx, vx_obj->y);
+            vx_obj->bit_ops += (2 * end_x) / p;
+        }
+        bitmap_apply_pattern(vx_obj->x5, pattern, x5_starts, end_x);
+        bitmap_apply_pattern(vx_obj->x7, pattern, x7_starts, end_x);
+
+        for (int i = k + pattern->count; i < root_primes->count; i++)
+        {
+            uint64_t p = root_primes->array[i];
+
+            bitmap_clear_steps_simd(vx_obj->x5, p, iZm_solve_for_x0_mpz(-1, p, vx, vx_obj->y), end_x);
+            bitmap_clear_steps_simd(vx_obj->x7, p, iZm_solve_for_x0_mpz(1, p, vx, vx_obj->y), end_x);
+
+            vx_obj->bit_ops += (2 * end_x) / p;
+        }
+    }
+
+    // if no further probabilistic testing is needed,
+    // count unmarked bits in x5 and x7 as p_count
+    if (!vx_obj->is_large_limit)
+    {
+        vx_obj->p_count = bitmap_count_range(vx_obj->x5, start_x, end_x) +
+                          bitmap_count_range(vx_obj->x7, start_x, end_x);
+    }
+}
+
+/**
+ * @brief Survivors of one 64-bit segment line, gathered for test_primality_u64_batch().
+ */
+typedef struct
+{
+    VX_SEG *vx_obj;                   /**< Segment being settled. */
+    BITMAP *line;                     /**< Scanned line (x5 or x7). */
+    int m_id;                         /**< Line id of @ref line (-1 or 1). */
+    int m;                            /**< Gathered candidates. */
+    uint64_t candidates[IZ_MR_BATCH]; /**< Candidate values iZ(yvx + x, m_id). */
+    int xs[IZ_MR_BATCH];              /**< x of each candidate. */
+} VX_U64_BLOCK;
+
+/**
+ * @brief Settle the gathered candidates of @p block, clearing composites from its line.
+ * @param block Gathered survivors.
+ */
+static void vx_u64_block_flush(VX_U64_BLOCK *block)
+{
+    uint8_t is_prime[IZ_MR_BATCH];
+    VX_SEG *vx_obj = block->vx_obj;
+
+    vx_obj->p_count += test_primality_u64_batch(block->candidates, block->m, is_prime);
+    vx_obj->p_test_ops += block->m;
+    for (int i = 0; i < block->m; i++)
+    {
+        if (!is_prime[i])
+            bitmap_clear_bit(block->line, block->xs[i]);
+    }
+    block->m = 0;
+}
+
+/**
+ * @brief bitmap_for_each_set_bit() visitor of vx_prob_sieve_u64(): gather one survivor.
+ * @param x Survivor column.
+ * @param ctx VX_U64_BLOCK of the scanned line.
+ */
+static void vx_u64_block_add(size_t x, void *ctx)
+{
+    VX_U64_BLOCK *block = ctx;
+
+    block->candidates[block->m] = iZ(block->vx_obj->yvx_u64 + x, block->m_id);
+    block->xs[block->m++] = (int)x;
+    if (block->m == IZ_MR_BATCH)
+        vx_u64_block_flush(block);
+}
+
+/**
+ * @brief GMP-free probabilistic phase for segments whose candidates fit 64 bits.
+ *
+ * Survivors are visited word by word and settled in blocks by
+ * test_primality_u64_batch().
+ *
+ * @param vx_obj Segment object containing deterministic survivors.
+ */
+static void vx_prob_sieve_u64(VX_SEG *vx_obj)
+{
+    int s = vx_obj->start_x <= 1 ? 1 : vx_obj->start_x;
+    VX_U64_BLOCK block = {.vx_obj = vx_obj};
+
+    for (int m_id = -1; m_id <= 1; m_id += 2)
+    {
+        block.line = (m_id == -1) ? vx_obj->x5 : vx_obj->x7;
+        block.m_id = m_id;
+        bitmap_for_each_set_bit(block.line, s, vx_obj->end_x, vx_u64_block_add, &block);
+        if (block.m > 0)
+            vx_u64_block_flush(&block);
+    }
+
+    vx_obj->is_large_limit = 0; // all composites cleared
+}
+
+#if IZ_PLATFORM_HAS_INT128
+/** @brief y*vx of a 128-bit segment as a native integer. */
+static inline iz_uint128_t vx_yvx_u128(const VX_SEG *vx_obj)
+{
+    return ((iz_uint128_t)vx_obj->yvx_u128[1] << 64) | vx_obj->yvx_u128[0];
+}
+
+/** @brief One 128-bit segment line scanned by vx_prob_sieve_u128(). */
+typedef struct
+{
+    VX_SEG *vx_obj;   /**< Segment being settled. */
+    BITMAP *line;     /**< Scanned line (x5 or x7). */
+    int m_id;         /**< Line id of @ref line (-1 or 1). */
+    iz_uint128_t yvx; /**< y*vx of the segment. */
+} VX_U128_SCAN;
+
+/**
+ * @brief bitmap_for_each_set_bit() visitor of vx_prob_sieve_u128(): test one survivor.
+ * @param x Survivor column.
+ * @param ctx VX_U128_SCAN of the scanned line.
+ */
+static void vx_u128_test_bit(size_t x, void *ctx)
+{
+    VX_U128_SCAN *scan = ctx;
+
+    scan->vx_obj->p_test_ops++;
+    if (bpsw_u128(6 * (scan->yvx + x) + scan->m_id))
+        scan->vx_obj->p_count++;
+    else
+        bitmap_clear_bit(scan->line, x); // Clear composite
+}
+
+/**
+ * @brief GMP-free probabilistic phase for segments whose candidates fit 128 bits.
+ * @param vx_obj Segment object containing deterministic survivors.
+ */
+static void vx_prob_sieve_u128(VX_SEG *vx_obj)
+{
+    int s = vx_obj->start_x <= 1 ? 1 : vx_obj->start_x;
+    VX_U128_SCAN scan = {.vx_obj = vx_obj, .yvx = vx_yvx_u128(vx_obj)};
+
+    for (int m_id = -1; m_id <= 1; m_id += 2)
+    {
+        scan.line = (m_id == -1) ? vx_obj->x5 : vx_obj->x7;
+        scan.m_id = m_id;
+        bitmap_for_each_set_bit(scan.line, s, vx_obj->end_x, vx_u128_test_bit, &scan);
+    }
+
+    vx_obj->is_large_limit = 0; // all composites cleared
+}
+#endif
+
+/** @brief One multi-word segment line scanned by vx_prob_sieve(). */
+typedef struct
+{
+    VX_SEG *vx_obj; /**< Segment being settled. */
+    BITMAP *line;   /**< Scanned line (x5 or x7). */
+    int m_id;       /**< Line id of @ref line (-1 or 1). */
+    mpz_t p;        /**< Candidate scratch. */
+    mpz_t x_p;      /**< yvx + x scratch. */
+} VX_MPZ_SCAN;
+
+/**
+ * @brief bitmap_for_each_set_bit() visitor of vx_prob_sieve(): test one survivor.
+ * @param x Survivor column.
+ * @param ctx VX_MPZ_SCAN of the scanned line.
+ */
+static void vx_mpz_test_bit(size_t x, void *ctx)
+{
+    VX_MPZ_SCAN *scan = ctx;
+    VX_SEG *vx_obj = scan->vx_obj;
+
+    // Compute p = iZ(yvx + x, m_id)
+    mpz_add_ui(scan->x_p, vx_obj->yvx, x);
+    iZ_mpz(scan->p, scan->x_p, scan->m_id);
+    vx_obj->p_test_ops++;
+
+    // if p is prime, increment count, else clear the composite from its line
+    if (test_primality_with(scan->p, vx_obj->mr_rounds, vx_obj->primality))
+        vx_obj->p_count++;
+    else
+        bitmap_clear_bit(scan->line, x);
+}
+
+/**
+ * @brief Perform probabilistic sieve cleanup for large numeric ranges.
+ * @param vx_obj Segment object containing deterministic survivors.
+ */
+static void vx_prob_sieve(VX_SEG *vx_obj)
+{
+    // If is_large_limit is false, no need for probabilistic testing
+    if (!vx_obj->is_large_limit)
+    {
+        log_info("vx_obj->is_large_limit is false, no need for probabilistic testing");
+        return;
+    }
+
+    // Candidates below 2^64 are settled exactly without GMP
+    if (vx_obj->is_u64)
+    {
+        vx_prob_sieve_u64(vx_obj);
+        return;
+    }
+
+#if IZ_PLATFORM_HAS_INT128
+    // Two-word candidates take the native Baillie-PSW path
+    if (vx_obj->is_u128)
+    {
+        vx_prob_sieve_u128(vx_obj);
+        return;
+    }
+#endif
+
+    // Initialize GMP reusable variables p, x_p
+    VX_MPZ_SCAN scan = {.vx_obj = vx_obj};
+    mpz_init(scan.p);
+    mpz_init(scan.x_p);
+
+    int s = vx_obj->start_x <= 1 ? 1 : vx_obj->start_x;
+
+    // Visit the survivors of each line, start_x <= x <= end_x
+    for (int m_id = -1; m_id <= 1; m_id += 2)
+    {
+        scan.line = (m_id == -1) ? vx_obj->x5 : vx_obj->x7;
+        scan.m_id = m_id;
+        bitmap_for_each_set_bit(scan.line, s, vx_obj->end_x, vx_mpz_test_bit, &scan);
+    }
+
+    vx_obj->is_large_limit = 0; // all composites cleared
+
+    // Cleanup
+    mpz_clears(scan.p, scan.x_p, NULL);
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Initialize the members of the VX_SEG structure with the given parameters and defaults.
+ *
+ * Description:
+ * This function allocates memory for a VX_SEG structure and initializes its members.
+ * The count is initialized to 0, and the p_gaps array is allocated with
+ * an initial size of (vx/2).
+ *
+ * Parameters:
+ * @param y_str A character pointer representing a numeric string.
+ *
+ * @return VX_SEG* A pointer to the initialized VX_SEG structure.
+ *        NULL if memory allocation fails or y_str is not a numeric string.
+ */
+VX_SEG *vx_init(IZM *iZm, int start_x, int end_x, char *y_str, int mr_rounds)
+{
+    return vx_init_with_state(iZm, NULL, start_x, end_x, y_str, mr_rounds);
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Initialize a VX_SEG, taking root-prime offsets from a sieving state.
+ *
+ * Behaves like vx_init(), except that the deterministic phase syncs @p state to
+ * y (solving offsets only when y is not the segment the state points at) and
+ * advances it to y + 1. Walking consecutive segments with one state therefore
+ * pays the per-prime modular solve only once.
+ *
+ * Parameters:
+ * @param iZm       Initialized toolkit context.
+ * @param state     Sieving state from vx_state_init(iZm), or NULL.
+ * @param start_x   Inclusive x start index.
+ * @param end_x     Inclusive x end index.
+ * @param y_str     Segment index y as a decimal string.
+ * @param mr_rounds Miller-Rabin rounds (0 uses default).
+ *
+ * @return VX_SEG* A pointer to the initialized VX_SEG structure, or NULL on failure.
+ */
+VX_SEG *vx_init_with_state(IZM *iZm, VX_SIEVE_STATE *state, int start_x, int end_x, char *y_str, int mr_rounds)
+{
+    // assert vx > 5 and not a multiple of 2 or 3
+    assert(iZm && "iZm is NULL in vx_init");
+    assert(y_str && "y_str is NULL in vx_init");
+
+    VX_SEG *vx_obj = malloc(sizeof(VX_SEG));
+    if (vx_obj == NULL)
+    {
+        log_error("Memory allocation failed in vx_init\n");
+        return NULL;
+    }
+
+    // Initialize struct members
+    vx_obj->vx = iZm->vx;
+    vx_obj->sieve_depth = state ? state->depth : (uint64_t)iZm->vx;
+
+    // Set base values
+    if (!vx_set_base_values(vx_obj, y_str))
+    {
+        // check logs
+        free(vx_obj);
+        return NULL;
+    }
+
+    vx_obj->mr_rounds = (mr_rounds == 0) ? MR_ROUNDS : mr_rounds; // default 25 rounds
+    vx_obj->primality = IZ_PRIMALITY_MR;                          // default backend, may be switched before sieving
+
+    vx_obj->start_x = MAX(start_x, 1);
+    vx_obj->end_x = MIN(end_x, vx_obj->vx);
+    vx_obj->x5 = bitmap_clone(iZm->base_x5);
+    vx_obj->x7 = bitmap_clone(iZm->base_x7);
+    vx_obj->p_count = 0;
+    vx_obj->p_gaps = NULL;
+    vx_obj->bit_ops = 0;
+    vx_obj->p_test_ops = 0;
+    vx_obj->iZm = NULL;   // one-shot segment: not resettable
+    vx_obj->state = NULL; // the caller keeps ownership of state (multi-word y without one caches its own)
+
+    // perform deterministic sieving to prepare for probabilistic sieving or streaming
+    vx_det_sieve(iZm, vx_obj, state);
+
+    return vx_obj;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Allocate a long-lived VX_SEG to be re-targeted with vx_reset().
+ *
+ * The segment owns its bitmaps and a sieving state, and borrows @p iZm, which
+ * must outlive it. Nothing is sieved until the first vx_reset() call, so one
+ * object can serve every segment of a worker without further allocations.
+ *
+ * Parameters:
+ * @param iZm       Initialized toolkit context.
+ * @param mr_rounds Miller-Rabin rounds (0 uses default).
+ *
+ * @return VX_SEG* A pointer to the allocated VX_SEG structure, or NULL on failure.
+ */
+VX_SEG *vx_create(IZM *iZm, int mr_rounds)
+{
+    assert(iZm && "iZm is NULL in vx_create");
+
+    VX_SEG *vx_obj = malloc(sizeof(VX_SEG));
+    if (vx_obj == NULL)
+    {
+        log_error("Memory allocation failed in vx_create\n");
+        return NULL;
+    }
+
+    vx_obj->vx = iZm->vx;
+    mpz_inits(vx_obj->y, vx_obj->yvx, vx_obj->root_limit, NULL);
+    vx_obj->is_large_limit = 0;
+    vx_obj->is_u64 = 0;
+    vx_obj->yvx_u64 = 0;
+    vx_obj->is_u128 = 0;
+    vx_obj->yvx_u128[0] = vx_obj->yvx_u128[1] = 0;
+    vx_obj->sieve_depth = vx_obj->vx;
+    vx_obj->mr_rounds = (mr_rounds == 0) ? MR_ROUNDS : mr_rounds; // default 25 rounds
+    vx_obj->primality = IZ_PRIMALITY_MR;                          // default backend, may be switched before sieving
+    vx_obj->start_x = 1;
+    vx_obj->end_x = vx_obj->vx;
+    vx_obj->x5 = bitmap_clone(iZm->base_x5);
+    vx_obj->x7 = bitmap_clone(iZm->base_x7);
+    vx_obj->p_count = 0;
+    vx_obj->p_gaps = NULL;
+    vx_obj->bit_ops = 0;
+    vx_obj->p_test_ops = 0;
+    vx_obj->iZm = iZm;
+    vx_obj->state = vx_state_init(iZm);
+
+    if (!vx_obj->x5 || !vx_obj->x7 || !vx_obj->state)
+    {
+        log_error("Memory allocation failed for VX_SEG buffers in vx_create\n");
+        vx_free(&vx_obj);
+        return NULL;
+    }
+
+    return vx_obj;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Set the deterministic sieving depth of a long-lived VX_SEG.
+ *
+ * Replaces the owned sieving state with one tracking every prime up to
+ * @p depth; the next vx_reset() solves its offsets from scratch. On failure
+ * the previous state is kept.
+ *
+ * Memory grows with the depth: ~32 bytes per tracked prime, i.e. ~10 MB at
+ * 2^22, ~125 MB at 2^26 and ~6.5 GB at 2^32, so depths past
+ * IZ_SIEVE_DEPTH_RANGE_MAX only suit a single long-lived segment.
+ *
+ * Parameters:
+ * @param vx_obj Segment created by vx_create().
+ * @param depth  Sieving depth (<= IZ_SIEVE_DEPTH_MAX; values <= vx keep the root primes only).
+ *
+ * @return 1 on success, 0 on invalid depth or allocation failure.
+ */
+int vx_set_sieve_depth(VX_SEG *vx_obj, uint64_t depth)
+{
+    assert(vx_obj && vx_obj->iZm && "vx_set_sieve_depth requires a segment from vx_create");
+
+    if (depth > IZ_SIEVE_DEPTH_MAX)
+    {
+        log_error("Sieving depth above 2^32 passed to vx_set_sieve_depth\n");
+        return 0;
+    }
+
+    if (MAX(depth, (uint64_t)vx_obj->vx) == vx_obj->sieve_depth)
+        return 1;
+
+    VX_SIEVE_STATE *state = vx_state_init_depth(vx_obj->iZm, depth);
+    if (!state)
+        return 0;
+
+    vx_state_free(&vx_obj->state);
+    vx_obj->state = state;
+    vx_obj->sieve_depth = state->depth;
+
+    return 1;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Replace the owned sieving state of a long-lived VX_SEG with a prepared one.
+ *
+ * The next vx_reset() syncs the new state to its segment, solving offsets
+ * only if the state points elsewhere.
+ *
+ * Parameters:
+ * @param vx_obj Segment created by vx_create().
+ * @param state  Sieving state for the segment's IZM; the segment takes ownership.
+ *
+ * @return 1 on success, 0 if @p state does not match the segment.
+ */
+int vx_set_sieve_state(VX_SEG *vx_obj, VX_SIEVE_STATE *state)
+{
+    assert(vx_obj && vx_obj->iZm && "vx_set_sieve_state requires a segment from vx_create");
+
+    if (!state || state->vx != vx_obj->vx || state->k != 2 + vx_obj->iZm->k_vx)
+    {
+        log_error("Sieving state does not match the segment in vx_set_sieve_state\n");
+        return 0;
+    }
+
+    if (state != vx_obj->state)
+        vx_state_free(&vx_obj->state);
+    vx_obj->state = state;
+    vx_obj->sieve_depth = state->depth;
+
+    return 1;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Re-target a long-lived VX_SEG at segment y and sieve it deterministically.
+ *
+ * The base bitmaps are copied into the existing storage and y, yvx and
+ * root_limit are updated in place (y + 1 and yvx + vx when stepping to the
+ * next segment), so no allocation or decimal conversion happens per segment.
+ * Root-prime offsets are carried by the owned sieving state.
+ *
+ * Parameters:
+ * @param vx_obj  Segment created by vx_create().
+ * @param y       Segment index.
+ * @param start_x Inclusive x start index.
+ * @param end_x   Inclusive x end index.
+ *
+ * @return 1 on success, 0 on invalid input.
+ */
+int vx_reset(VX_SEG *vx_obj, mpz_t y, int start_x, int end_x)
+{
+    assert(vx_obj && vx_obj->iZm && "vx_reset requires a segment from vx_create");
+
+    if (mpz_sgn(y) < 0)
+    {
+        log_error("Negative y passed to vx_reset\n");
+        return 0;
+    }
+
+    IZM *iZm = vx_obj->iZm;
+
+    // * 1. Advance y and yvx: a step to the next segment is a pair of additions
+    mpz_add_ui(vx_obj->y, vx_obj->y, 1);
+    if (mpz_cmp(vx_obj->y, y) == 0)
+    {
+        mpz_add_ui(vx_obj->yvx, vx_obj->yvx, vx_obj->vx);
+    }
+    else
+    {
+        mpz_set(vx_obj->y, y);
+        mpz_mul_ui(vx_obj->yvx, vx_obj->y, vx_obj->vx);
+    }
+    vx_set_limits(vx_obj);
+
+    // * 2. Restore the pre-sieved base and per-segment counters
+    memcpy(vx_obj->x5->data, iZm->base_x5->data, iZm->base_x5->byte_size);
+    memcpy(vx_obj->x7->data, iZm->base_x7->data, iZm->base_x7->byte_size);
+    ui16_free(&vx_obj->p_gaps);
+
+    vx_obj->start_x = MAX(start_x, 1);
+    vx_obj->end_x = MIN(end_x, vx_obj->vx);
+    vx_obj->p_count = 0;
+    vx_obj->bit_ops = 0;
+    vx_obj->p_test_ops = 0;
+
+    // * 3. Deterministic sieving with the carried root-prime offsets
+    vx_det_sieve(iZm, vx_obj, vx_obj->state);
+
+    return 1;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Free all memory owned by a VX segment object.
+ * @param vx_obj Address of the VX_SEG pointer to release.
+ */
+void vx_free(VX_SEG **vx_obj)
+{
+    if (vx_obj == NULL || *vx_obj == NULL)
+        return;
+
+    // clear bitmaps
+    bitmap_free(&(*vx_obj)->x5);
+    bitmap_free(&(*vx_obj)->x7);
+
+    // clear p_gaps array
+    ui16_free(&(*vx_obj)->p_gaps);
+
+    // clear the owned sieving state of long-lived segments
+    vx_state_free(&(*vx_obj)->state);
+
+    // clear mpz_t variables
+    mpz_clears((*vx_obj)->y, (*vx_obj)->yvx, (*vx_obj)->root_limit, NULL);
+
+    free(*vx_obj);
+    *vx_obj = NULL;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Convert survivor bits into compact prime-gap encoding.
+ *
+ * This routine must run after deterministic/probabilistic sieving is complete.
+ * It populates @ref VX_SEG::p_gaps for downstream streaming and gap traversal.
+ *
+ * @param vx_obj Segment object with validated prime survivors.
+ */
+void vx_collect_p_gaps(VX_SEG *vx_obj)
+{
+    assert(vx_obj && vx_obj->p_count > 0 && "Invalid vx_obj in vx_collect_p_gaps");
+    assert(mpz_cmp_ui(vx_obj->y, 0) > 0 && "First segment requires special handling in vx_collect_p_gaps");
+    if (vx_obj->is_large_limit)
+    {
+        vx_full_sieve(vx_obj, 0);
+    }
+
+    vx_obj->p_gaps = ui16_init(vx_obj->p_count + 2);
+    assert(vx_obj->p_gaps && "Memory allocation failed for vx_obj->p_gaps in vx_collect_p_gaps");
+
+    // Initialize gap counter
+    int gap = 0;
+
+    // Iterate through x values in the range start_x <= x <= end_x
+    for (int x = vx_obj->start_x; x <= vx_obj->end_x; x++)
+    {
+        // Increment gap by 4 since: iZ(x, -1) - iZ(x-1, 1) = 4
+        gap += 4;
+
+        // Check if iZ(vx * y + x, -1) is prime
+        if (bitmap_get_bit(vx_obj->x5, x))
+        {
+            // Append gap to p_gaps
+            ui16_push(vx_obj->p_gaps, gap);
+            gap = 0; // Reset gap
+        }
+
+        // Increment gap by 2
+        gap += 2;
+
+        // Check if iZ(vx * y + x, 1) is prime
+        if (bitmap_get_bit(vx_obj->x7, x))
+        {
+            // Append gap to p_gaps
+            ui16_push(vx_obj->p_gaps, gap);
+            gap = 0; // Reset gap
+        }
+    }
+
+    // append final gap for backward calculations
+    ui16_push(vx_obj->p_gaps, gap);
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief This function performs the sieve process on a given vx and y defined
+ * in the VX_SEG structure, and stores the primes gaps in the vx_obj->p_gaps array.
+ *
+ * Description: This function combines deterministic sieving and probabilistic
+ * primality tests to identify prime candidates in a standard VX segment of a
+ * specific y in the iZ-Matrix. It could be used to only count primes in the
+ * vx segment, and optionally populates the vx_obj->p_gaps array with prime gaps
+ * between consecutive primes detected in the segment.
+ *
+ * @param vx_obj The VX_SEG to be processed.
+ * @param collect_p_gaps 0 only counts primes and doesn't store prime gaps,
+ * other non-zero int values populates vx_obj->p_gaps with detected prime gaps.
+ */
+void vx_full_sieve(VX_SEG *vx_obj, int collect_p_gaps)
+{
+    assert(vx_obj && "vx_obj is NULL in vx_full_sieve");
+
+    // If is_large_limit is true, perform probabilistic primality tests
+    if (vx_obj->is_large_limit)
+        vx_prob_sieve(vx_obj);
+
+    // If collect_p_gaps is true, populate the p_gaps array
+    if (collect_p_gaps)
+        vx_collect_p_gaps(vx_obj);
+}
+
+/**
+ * @brief Cursor over the survivors of both lines of a segment, in ascending order.
+ *
+ * Each line is scanned word by word with bitmap_next_set_bit(); at equal x
+ * the x5 candidate 6x - 1 comes before the x7 candidate 6x + 1.
+ */
+typedef struct
+{
+    VX_SEG *vx_obj; /**< Scanned segment. */
+    size_t next_x5; /**< Next survivor column of x5 (BITMAP_NPOS when exhausted). */
+    size_t next_x7; /**< Next survivor column of x7 (BITMAP_NPOS when exhausted). */
+} VX_SURVIVORS;
+
+/**
+ * @brief Start a VX_SURVIVORS cursor at the segment's start_x.
+ * @param vx_obj Segment object.
+ * @return Cursor positioned on the first survivor of each line.
+ */
+static VX_SURVIVORS vx_survivors_begin(VX_SEG *vx_obj)
+{
+    VX_SURVIVORS it = {.vx_obj = vx_obj};
+    it.next_x5 = bitmap_next_set_bit(vx_obj->x5, vx_obj->start_x, vx_obj->end_x);
+    it.next_x7 = bitmap_next_set_bit(vx_obj->x7, vx_obj->start_x, vx_obj->end_x);
+    return it;
+}
+
+/**
+ * @brief Take the next survivor of a VX_SURVIVORS cursor.
+ *
+ * The cursor moves past the returned survivor first, so the caller may clear
+ * its bit.
+ *
+ * @param it Cursor.
+ * @param m_id Output: line id of the survivor (-1 for x5, 1 for x7).
+ * @return Survivor column x, or BITMAP_NPOS once both lines are exhausted.
+ */
+static size_t vx_survivors_next(VX_SURVIVORS *it, int *m_id)
+{
+    size_t x;
+    if (it->next_x5 <= it->next_x7)
+    {
+        x = it->next_x5;
+        *m_id = -1;
+        if (x != BITMAP_NPOS)
+            it->next_x5 = bitmap_next_set_bit(it->vx_obj->x5, x + 1, it->vx_obj->end_x);
+    }
+    else
+    {
+        x = it->next_x7;
+        *m_id = 1;
+        it->next_x7 = bitmap_next_set_bit(it->vx_obj->x7, x + 1, it->vx_obj->end_x);
+    }
+    return x;
+}
+
+/**
+ * @brief GMP-free vx_stream() for segments whose candidates fit 64 bits.
+ * @param vx_obj Segment object.
+ * @param output Writable output stream.
+ * @param stream_gaps Non-zero to stream prime gaps instead of absolute primes.
+ */
+static void vx_stream_u64(VX_SEG *vx_obj, FILE *output, int stream_gaps)
+{
+    uint64_t yvx = vx_obj->yvx_u64;
+
+    // Settle the survivors in batches first; composites are cleared and primes counted
+    if (vx_obj->is_large_limit)
+    {
+        vx_prob_sieve_u64(vx_obj);
+    }
+
+    // Prime gaps are reported from this segment base.
+    uint64_t last_p = iZ(yvx, 1);
+    if (stream_gaps)
+    {
+        fprintf(output, "First prime gap computed from: %" PRIu64 "\n", last_p);
+    }
+
+    VX_SURVIVORS it = vx_survivors_begin(vx_obj);
+    int m_id;
+    for (size_t x = vx_survivors_next(&it, &m_id); x != BITMAP_NPOS; x = vx_survivors_next(&it, &m_id))
+    {
+        uint64_t p = iZ(yvx + x, m_id);
+        fprintf(output, "%" PRIu64 " ", stream_gaps ? p - last_p : p);
+        last_p = p;
+    }
+}
+
+#if IZ_PLATFORM_HAS_INT128
+/**
+ * @brief Format a 128-bit value in decimal.
+ * @param v Value to format.
+ * @param buf Output buffer of at least 40 bytes.
+ * @return Pointer to the first digit inside @p buf.
+ */
+static char *u128_to_str(iz_uint128_t v, char buf[40])
+{
+    char *c = buf + 39;
+    *c = '\0';
+    do
+    {
+        *--c = (char)('0' + (int)(v % 10));
+        v /= 10;
+    } while (v);
+    return c;
+}
+
+/**
+ * @brief GMP-free vx_stream() for segments whose candidates fit 128 bits.
+ * @param vx_obj Segment object.
+ * @param output Writable output stream.
+ * @param stream_gaps Non-zero to stream prime gaps instead of absolute primes.
+ */
+static void vx_stream_u128(VX_SEG *vx_obj, FILE *output, int stream_gaps)
+{
+    iz_uint128_t yvx = vx_yvx_u128(vx_obj);
+    char buf[40];
+
+    // Prime gaps are reported from this segment base.
+    iz_uint128_t last_p = 6 * yvx + 1;
+    if (stream_gaps)
+    {
+        fprintf(output, "First prime gap computed from: %s\n", u128_to_str(last_p, buf));
+    }
+
+    VX_SURVIVORS it = vx_survivors_begin(vx_obj);
+    int m_id;
+    for (size_t x = vx_survivors_next(&it, &m_id); x != BITMAP_NPOS; x = vx_survivors_next(&it, &m_id))
+    {
+        iz_uint128_t p = 6 * (yvx + x) + m_id;
+        if (vx_obj->is_large_limit)
+        {
+            vx_obj->p_test_ops++;
+            if (!bpsw_u128(p))
+            {
+                bitmap_clear_bit(m_id == -1 ? vx_obj->x5 : vx_obj->x7, x); // Clear composite
+                continue;
+            }
+            vx_obj->p_count++; // otherwise already counted in det_sieve
+        }
+
+        fprintf(output, "%s ", u128_to_str(stream_gaps ? p - last_p : p, buf));
+        last_p = p;
+    }
+}
+#endif
+
+/**
+ * @ingroup iz_toolkit
+ * @brief Stream segment primes to an output stream in traversal order.
+ * @param vx_obj Segment object.
+ * @param output Destination stream (stdout or file).
+ * @param stream_gaps If non-zero, output prime gaps instead of primes.
+ */
+void vx_stream(VX_SEG *vx_obj, FILE *output, int stream_gaps)
+{
+    assert(vx_obj && "vx_obj is NULL in vx_stream");
+    assert(output && "output stream is NULL in vx_stream");
+
+    // Candidates below 2^64 are built and tested without GMP
+    if (vx_obj->is_u64)
+    {
+        vx_stream_u64(vx_obj, output, stream_gaps);
+        return;
+    }
+
+#if IZ_PLATFORM_HAS_INT128
+    if (vx_obj->is_u128)
+    {
+        vx_stream_u128(vx_obj, output, stream_gaps);
+        return;
+    }
+#endif
+
+    // Initialize GMP reusable variables.
+    mpz_t last_p, gap, p, x_p;
+    mpz_init(last_p);
+    mpz_init(gap);
+    mpz_init(p);
+    mpz_init(x_p);
+
+    // Prime gaps are reported from this segment base.
+    iZ_mpz(last_p, vx_obj->yvx, 1);
+    if (stream_gaps)
+    {
+        gmp_fprintf(output, "First prime gap computed from: %Zd\n", last_p);
+    }
+
+    int r = vx_obj->mr_rounds;
+
+    // Visit the survivors in ascending order, start_x <= x <= end_x
+    VX_SURVIVORS it = vx_survivors_begin(vx_obj);
+    int m_id;
+    for (size_t x = vx_survivors_next(&it, &m_id); x != BITMAP_NPOS; x = vx_survivors_next(&it, &m_id))
+    {
+        // Compute p = iZ(yvx + x, m_id)
+        mpz_add_ui(x_p, vx_obj->yvx, x);
+        iZ_mpz(p, x_p, m_id);
+        int is_prime = 1;
+
+        if (vx_obj->is_large_limit)
+        {
+            vx_obj->p_test_ops++;
+            is_prime = test_primality_with(p, r, vx_obj->primality);
+        }
+
+        if (!is_prime)
+        {
+            bitmap_clear_bit(m_id == -1 ? vx_obj->x5 : vx_obj->x7, x); // Clear composite
+            continue;
+        }
+
+        if (vx_obj->is_large_limit)
+        {
+            vx_obj->p_count++; // otherwise already counted in det_sieve
+        }
+        if (stream_gaps)
+        {
+            mpz_sub(gap, p, last_p);
+            gmp_fprintf(output, "%Zd ", gap);
+            mpz_set(last_p, p);
+        }
+        else
+        {
+            gmp_fprintf(output, "%Zd ", p);
+        }
+    }
+
+    mpz_clears(last_p, gap, p, x_p, NULL);
+}
 
-        // Iterate through root primes, skipping the first k pre-sieved primes
-        for (int i = k; i < root_primes->count; i++)
-        {
-            uint64_t p = root_primes->array[i];
+// ==================================================
+// * IZM_RANGE_INFO structure:
+// ==================================================
 
-            if (p > root_limit)
-                break;
+IZM_RANGE_INFO range_info_init(INPUT_SIEVE_RANGE *input_range, int vx)
+{
+    IZM_RANGE_INFO info = {0};
+    info.vx = vx;
+    info.y_range = -1;
 
-            // Mark composites of p in x5 and x7
-            bitmap_clear_steps_simd(vx_obj->x5, p, iZm_solve_for_x0(-1, p, vx, y), end_x);
-            bitmap_clear_steps_simd(vx_obj->x7, p, iZm_solve_for_x0(1, p, vx, y), end_x);
+    mpz_inits(info.Zs, info.Ze, info.Xs, info.Xe, info.Ys, info.Ye, NULL);
 
-            vx_obj->bit_ops += (2 * end_x) / p; // approximate number of bit operations
-        }
+    if (!input_range || !input_range->start || vx < 35 || mpz_set_str(info.Zs, input_range->start, 10) != 0)
+    {
+        log_error("range_info_init: invalid input.");
+        return info;
+    }
+
+    if (input_range->range == 0)
+    {
+        mpz_set(info.Ze, info.Zs);
     }
     else
     {
-        // the same as above but using iZm_solve_for_x0_mpz version
-        for (int i = k; i < root_primes->count; i++)
-        {
-            int p = root_primes->array[i];
+        // inclusive upper bound for range size semantics: [start, start + range - 1]
+        mpz_add_ui(info.Ze, info.Zs, input_range->range - 1);
+    }
 
-            bitmap_clear_steps_simd(vx_obj->x5, p, iZm_solve_for_x0_mpz(-1, p, vx, vx_obj->y), end_x);
-            bitmap_clear_steps_simd(vx_obj->x7, p, iZm_solve_for_x0_mpz(1, p, vx, vx_obj->y), end_x);
+    mpz_fdiv_q_ui(info.Xs, info.Zs, 6);
+    mpz_fdiv_q_ui(info.Xe, info.Ze, 6);
+    mpz_fdiv_q_ui(info.Ys, info.Xs, vx);
+    mpz_fdiv_q_ui(info.Ye, info.Xe, vx);
 
-            vx_obj->bit_ops += (2 * end_x) / p;
-        }
-    }
+    mpz_t y_delta;
+    mpz_init(y_delta);
+    mpz_sub(y_delta, info.Ye, info.Ys);
 
-    // if no further probabilistic testing is needed,
-    // count unmarked bits in x5 and x7 as p_count
-    if (!vx_obj->is_large_limit)
+    if (mpz_sgn(y_delta) < 0 || !mpz_fits_sint_p(y_delta))
     {
-        vx_obj->p_count = 0;
-        for (int x = start_x; x <= end_x; x++)
-        {
-            if (bitmap_get_bit(vx_obj->x5, x))
-                vx_obj->p_count++;
-            if (bitmap_get_bit(vx_obj->x7, x))
-                vx_obj->p_count++;
-        }
+        log_error("range_info_init: computed y-range is out of supported bounds.");
+        mpz_clear(y_delta);
+        return info;
     }
+
+    info.y_range = (int)mpz_get_si(y_delta);
+    mpz_clear(y_delta);
+
+    return info;
 }
 
-/**
- * @brief Perform probabilistic sieve cleanup for large numeric ranges.
- * @param vx_obj Segment object containing deterministic survivors.
- */
-static void vx_prob_sieve(VX_SEG *vx_obj)
+void range_info_free(IZM_RANGE_INFO *info)
 {
-    // If is_large_limit is false, no need for probabilistic testing
-    if (!vx_obj->is_large_limit)
-    {
-        log_info("vx_obj->is_large_limit is false, no need for probabilistic testing");
+    if (info == NULL)
         return;
-    }
-
-    // Initialize GMP reusable variables p, x_p
-    mpz_t p, x_p;
-    mpz_init(p);
-    mpz_init(x_p);
 
-    int r = vx_obj->mr_rounds;
-    int s = vx_obj->start_x <= 1 ? 1 : vx_obj->start_x;
-
-    // Iterate through x values in the range start_x <= x <= end_x
-    for (int x = s; x <= vx_obj->end_x; x++)
-    {
-        // Check if iZ(vx * y + x, -1) is prime, if not, clear x in x5
-        if (bitmap_get_bit(vx_obj->x5, x))
-        {
-            // Compute x_p = yvx + x
-            mpz_add_ui(x_p, vx_obj->yvx, x);
-            iZ_mpz(p, x_p, -1); // Compute p = iZ(x_p, -1)
-            int is_prime = test_primality(p, r);
-            vx_obj->p_test_ops++;
+    mpz_clears(info->Zs, info->Ze, info->Xs, info->Xe, info->Ys, info->Ye, NULL);
+}
 
-            // if is_prime, increment count, else clear composite from x5
-            if (is_prime)
-            {
-                vx_obj->p_count++;
-            }
-            else
-            {
-                bitmap_clear_bit(vx_obj->x5, x); // Clear composite from x5
-            }
-        }
+// ==================================================
+// * iZm Search primes routines:
+// ==================================================
 
-        // same for the 6x+1 candidate
-        if (bitmap_get_bit(vx_obj->x7, x))
-        {
-            mpz_add_ui(x_p, vx_obj->yvx, x);
-            iZ_mpz(p, x_p, 1); // Compute p = iZ(x_p, 1)
-            int is_prime = test_primality(p, r);
-            vx_obj->p_test_ops++;
+/**
+ * @brief Reusable state for repeated vx_search_prime() calls with one vx.
+ */
+struct VX_SEARCH_CTX
+{
+    IZM *iZm;              /**< Toolkit context for vx, read-only during searches. */
+    int owns_iZm;          /**< Non-zero when @ref iZm is freed with the context. */
+    VX_SIEVE_STATE *state; /**< Carried root-prime offsets. */
+    BITMAP *line;          /**< Candidate bitmap of the searched line, reused across segments. */
+    gmp_randstate_t rand;  /**< Random state, seeded once at init. */
+    mpz_t yvx;             /**< y * vx of the current segment. */
+    mpz_t z;               /**< Candidate scratch value. */
+    atomic_int *stop;      /**< Optional cancel flag checked between candidates (NULL when unused). */
+    BITMAP *safe_base;     /**< 6x-1 base with the 2p+1 hits of the wheel primes cleared (built on first safe search). */
+    uint32_t *safe_delta;  /**< Per tracked prime: shift from its p hit to its 2p+1 hit (built on first safe search). */
+};
 
-            if (is_prime)
-            {
-                vx_obj->p_count++;
-            }
-            else
-            {
-                bitmap_clear_bit(vx_obj->x7, x); // Clear composite from x7
-            }
-        }
+/**
+ * @ingroup iz_toolkit
+ * @brief Allocate a reusable context for horizontal random-prime searches.
+ *
+ * Builds the IZM assets for @p vx, a sieving state over its root primes and
+ * one candidate bitmap, and seeds the random state once. Repeated searches
+ * with the same context skip all of this setup.
+ *
+ * Parameters:
+ * @param vx Segment width.
+ *
+ * @return A pointer to the allocated VX_SEARCH_CTX, or NULL on failure.
+ */
+VX_SEARCH_CTX *vx_search_ctx_init(int vx)
+{
+    IZM *iZm = iZm_init(vx);
+    if (!iZm)
+    {
+        log_error("Failed to initialize iZm for VX_SEARCH_CTX with vx = %d.", vx);
+        return NULL;
     }
 
-    vx_obj->is_large_limit = 0; // all composites cleared
+    VX_SEARCH_CTX *ctx = vx_search_ctx_init_with_iZm(iZm);
+    if (!ctx)
+    {
+        iZm_free(&iZm);
+        return NULL;
+    }
 
-    // Cleanup
-    mpz_clears(p, x_p, NULL);
+    ctx->owns_iZm = 1;
+    return ctx;
 }
 
 /**
  * @ingroup iz_toolkit
- * @brief Initialize the members of the VX_SEG structure with the given parameters and defaults.
+ * @brief Allocate a search context that borrows an existing IZM.
  *
- * Description:
- * This function allocates memory for a VX_SEG structure and initializes its members.
- * The count is initialized to 0, and the p_gaps array is allocated with
- * an initial size of (vx/2).
+ * Only the sieving state, the line bitmap and the random state are per
+ * context, so threads searching with the same vx can share one IZM.
  *
  * Parameters:
- * @param y_str A character pointer representing a numeric string.
+ * @param iZm Initialized toolkit context (must outlive the search context).
  *
- * @return VX_SEG* A pointer to the initialized VX_SEG structure.
- *        NULL if memory allocation fails or y_str is not a numeric string.
+ * @return A pointer to the allocated VX_SEARCH_CTX, or NULL on failure.
  */
-VX_SEG *vx_init(IZM *iZm, int start_x, int end_x, char *y_str, int mr_rounds)
+VX_SEARCH_CTX *vx_search_ctx_init_with_iZm(IZM *iZm)
 {
-    // assert vx > 5 and not a multiple of 2 or 3
-    assert(iZm && "iZm is NULL in vx_init");
-    assert(y_str && "y_str is NULL in vx_init");
+    assert(iZm && "Invalid IZM passed to vx_search_ctx_init_with_iZm.");
 
-    VX_SEG *vx_obj = malloc(sizeof(VX_SEG));
-    if (vx_obj == NULL)
+    VX_SEARCH_CTX *ctx = calloc(1, sizeof(VX_SEARCH_CTX));
+    if (!ctx)
     {
-        log_error("Memory allocation failed in vx_init\n");
+        log_error("Memory allocation failed for VX_SEARCH_CTX.");
         return NULL;
     }
 
-    // Initialize struct members
-    vx_obj->vx = iZm->vx;
+    gmp_randinit_default(ctx->rand);
+    gmp_seed_randstate(ctx->rand);
+    mpz_init(ctx->yvx);
+    mpz_init(ctx->z);
 
-    // Set base values
-    if (!vx_set_base_values(vx_obj, y_str))
+    ctx->iZm = iZm;
+    ctx->state = vx_state_init(iZm);
+    ctx->line = bitmap_init(iZm->vx + 10, 0);
+    if (!ctx->state || !ctx->line)
     {
-        // check logs
-        free(vx_obj);
+        log_error("Failed to initialize VX_SEARCH_CTX for vx = %d.", iZm->vx);
+        vx_search_ctx_free(&ctx);
         return NULL;
     }
 
-    vx_obj->mr_rounds = (mr_rounds == 0) ? MR_ROUNDS : mr_rounds; // default 25 rounds
-
-    vx_obj->start_x = MAX(start_x, 1);
-    vx_obj->end_x = MIN(end_x, vx_obj->vx);
-    vx_obj->x5 = bitmap_clone(iZm->base_x5);
-    vx_obj->x7 = bitmap_clone(iZm->base_x7);
-    vx_obj->p_count = 0;
-    vx_obj->p_gaps = NULL;
-    vx_obj->bit_ops = 0;
-    vx_obj->p_test_ops = 0;
+    return ctx;
+}
 
-    // perform deterministic sieving to prepare for probabilistic sieving or streaming
-    vx_det_sieve(iZm, vx_obj);
+/**
+ * @ingroup iz_toolkit
+ * @brief Free the memory allocated for a VX_SEARCH_CTX structure.
+ *
+ * Parameters:
+ * @param ctx A pointer to the VX_SEARCH_CTX structure to be freed.
+ */
+void vx_search_ctx_free(VX_SEARCH_CTX **ctx)
+{
+    if (ctx == NULL || *ctx == NULL)
+        return;
 
-    return vx_obj;
+    bitmap_free(&(*ctx)->line);
+    bitmap_free(&(*ctx)->safe_base);
+    free((*ctx)->safe_delta);
+    vx_state_free(&(*ctx)->state);
+    if ((*ctx)->owns_iZm)
+        iZm_free(&(*ctx)->iZm);
+    mpz_clears((*ctx)->yvx, (*ctx)->z, NULL);
+    gmp_randclear((*ctx)->rand);
+    free(*ctx);
+    *ctx = NULL;
 }
 
 /**
  * @ingroup iz_toolkit
- * @brief Free all memory owned by a VX segment object.
- * @param vx_obj Address of the VX_SEG pointer to release.
+ * @brief Attach a cancel flag to a search context.
+ *
+ * Parameters:
+ * @param ctx  Search context.
+ * @param stop Address of an atomic_int cancel flag, or NULL to search until found.
  */
-void vx_free(VX_SEG **vx_obj)
+void vx_search_ctx_set_stop(VX_SEARCH_CTX *ctx, void *stop)
 {
-    if (vx_obj == NULL || *vx_obj == NULL)
-        return;
+    assert(ctx && "Invalid VX_SEARCH_CTX passed to vx_search_ctx_set_stop.");
+    ctx->stop = stop;
+}
 
-    // clear bitmaps
-    bitmap_free(&(*vx_obj)->x5);
-    bitmap_free(&(*vx_obj)->x7);
+/**
+ * @brief Restore the pre-sieved @p m_id line of @p ctx and clear the carried root-prime hits.
+ * @param ctx Search context synced to the current segment.
+ * @param m_id Line id (-1 or 1).
+ */
+static void vx_search_sieve_line(VX_SEARCH_CTX *ctx, int m_id)
+{
+    IZM *iZm = ctx->iZm;
+    VX_SIEVE_STATE *state = ctx->state;
+    BITMAP *base = (m_id == -1) ? iZm->base_x5 : iZm->base_x7;
+    uint32_t *next = (m_id == -1) ? state->x5_next : state->x7_next;
+    BITMAP_PATTERN *pattern = iZm->pattern;
+    uint64_t starts[BITMAP_PATTERN_MAX_COUNT];
 
-    // clear p_gaps array
-    ui16_free(&(*vx_obj)->p_gaps);
+    memcpy(ctx->line->data, base->data, base->byte_size);
 
-    // clear mpz_t variables
-    mpz_clears((*vx_obj)->y, (*vx_obj)->yvx, (*vx_obj)->root_limit, NULL);
+    for (int i = 0; i < pattern->count; i++)
+        starts[i] = next[i];
+    bitmap_apply_pattern(ctx->line, pattern, starts, iZm->vx);
 
-    free(*vx_obj);
-    *vx_obj = NULL;
+    for (int i = pattern->count; i < state->count; i++)
+        bitmap_clear_steps_simd(ctx->line, state->primes[i], next[i], iZm->vx);
 }
 
 /**
  * @ingroup iz_toolkit
- * @brief Convert survivor bits into compact prime-gap encoding.
+ * @brief horizontal search routine for generating a random prime, reusing a context.
  *
- * This routine must run after deterministic/probabilistic sieving is complete.
- * It populates @ref VX_SEG::p_gaps for downstream streaming and gap traversal.
+ * Description: This function searches for a prime number using the given parameters.
+ * It combines the iZ-Matrix filtering techniques with the Miller-Rabin primality test.
+ * Starting from a random segment y, the searched line is restored from the
+ * pre-sieved base of @p ctx, cleared at the root-prime offsets carried by the
+ * context state, and its survivors p = iZ(x + vx * y) are tested until a prime
+ * is found. The offsets are solved once for the starting segment; each later
+ * segment advances them by vx mod q per root prime q. When a cancel flag is
+ * set with vx_search_ctx_set_stop(), the search gives up as soon as it is raised.
  *
- * @param vx_obj Segment object with validated prime survivors.
+ * @param ctx Search context from vx_search_ctx_init().
+ * @param p The prime number found in the search.
+ * @param m_id The identifier (1 or -1) for the iZ matrix.
+ * @param bit_size The target bit size of the prime.
+ * @return 1 if a prime is found, 0 otherwise.
  */
-void vx_collect_p_gaps(VX_SEG *vx_obj)
+int vx_search_prime_ctx(VX_SEARCH_CTX *ctx, mpz_t p, int m_id, int bit_size)
 {
-    assert(vx_obj && vx_obj->p_count > 0 && "Invalid vx_obj in vx_collect_p_gaps");
-    assert(mpz_cmp_ui(vx_obj->y, 0) > 0 && "First segment requires special handling in vx_collect_p_gaps");
-    if (vx_obj->is_large_limit)
+    assert(ctx && p && "Input parameters cannot be NULL in vx_search_prime_ctx.");
+
+    IZM *iZm = ctx->iZm;
+    VX_SIEVE_STATE *state = ctx->state;
+    BITMAP *line = ctx->line;
+    int vx = iZm->vx;
+
+    bit_size = MAX(bit_size, 10);
+
+    // set m_id randomly if not provided
+    if (m_id != -1 && m_id != 1)
+        m_id = gmp_random_below(ctx->rand, 2) ? 1 : -1;
+
+    // * 1. Pick a random segment y and solve the root-prime offsets once;
+    // segment 0 holds the root primes themselves, so start at y = 1 at least
+    mpz_urandomb(ctx->z, ctx->rand, bit_size);
+    mpz_fdiv_q_ui(ctx->z, ctx->z, 6 * vx);
+    if (mpz_sgn(ctx->z) == 0)
+        mpz_set_ui(ctx->z, 1);
+
+    vx_state_sync(state, ctx->z);
+    mpz_mul_ui(ctx->yvx, state->y, vx);
+
+    int found = 0;
+    while (!found)
     {
-        vx_full_sieve(vx_obj, 0);
+        // * 2. Restore the pre-sieved line and clear the root-prime hits
+        vx_search_sieve_line(ctx, m_id);
+
+        // * 3. Test the survivors from a random x
+        int random_x = gmp_random_below(ctx->rand, MAX(vx / 2, 1)); // random x < vx/2
+        for (int x = random_x; x < vx; x++)
+        {
+            // check if z is prime candidate in bitmap
+            if (bitmap_get_bit(line, x))
+            {
+                // another searcher already finished
+                if (ctx->stop && atomic_load_explicit(ctx->stop, memory_order_relaxed))
+                    return 0;
+
+                // compute z = iZ(vx * y + x, m_id)
+                mpz_add_ui(ctx->z, ctx->yvx, x);
+                iZ_mpz(ctx->z, ctx->z, m_id);
+
+                // if z is prime, set p = z
+                if (test_primality(ctx->z, MR_ROUNDS))
+                {
+                    mpz_set(p, ctx->z);
+                    found = 1;
+                    break;
+                }
+            }
+        }
+
+        // * 4. Move the offsets and yvx to the next vx segment
+        vx_state_advance(state);
+        mpz_add_ui(ctx->yvx, ctx->yvx, vx);
     }
 
-    vx_obj->p_gaps = ui16_init(vx_obj->p_count + 2);
-    assert(vx_obj->p_gaps && "Memory allocation failed for vx_obj->p_gaps in vx_collect_p_gaps");
+    return found;
+}
 
-    // Initialize gap counter
-    int gap = 0;
+/** Most distinct prime factors of a 32-bit exponent (2*3*5*...*29 > 2^32). */
+#define VX_CONS_MAX_FACTORS 10
 
-    // Iterate through x values in the range start_x <= x <= end_x
-    for (int x = vx_obj->start_x; x <= vx_obj->end_x; x++)
+/**
+ * @brief A constrained search line: x-progression to keep and extra progressions to clear.
+ *
+ * Positions are expressed on X = y*vx + x: candidates are kept only when
+ * X = keep_c (mod keep_m), and cleared when X = clear_c[j] (mod clear_r[j]).
+ */
+typedef struct
+{
+    int m_id;                               /**< Line id (-1 or 1). */
+    uint64_t keep_m;                        /**< Period of the kept progression (1 keeps every x). */
+    uint64_t keep_c;                        /**< Kept residue of X modulo keep_m. */
+    int clear_count;                        /**< Number of cleared progressions. */
+    uint64_t clear_r[VX_CONS_MAX_FACTORS];  /**< Primes r | e with r >= 5. */
+    uint64_t clear_c[VX_CONS_MAX_FACTORS];  /**< X residue where p = 1 (mod r). */
+} VX_CONS_LINE;
+
+/**
+ * @brief Fold @p cons into the lines of the vx search that can satisfy it.
+ *
+ * With p = 6X + m_id, p = a (mod m) means 6X = a - m_id (mod m); it is
+ * solvable on a line iff g = gcd(6, m) divides a - m_id, and then fixes X
+ * modulo m / g. For gcd(p - 1, e) = 1 each prime r | e must not divide p - 1:
+ * r = 3 rules out the 6x+1 line, and r >= 5 clears X = (1 - m_id) / 6 (mod r).
+ *
+ * @param cons Constraints.
+ * @param lines Output lines (at most 2).
+ * @return Number of feasible lines (0 when @p cons cannot be met).
+ */
+static int vx_cons_lines(const IZ_PRIME_CONSTRAINTS *cons, VX_CONS_LINE lines[2])
+{
+    uint64_t m = cons->modulus > 1 ? cons->modulus : 1;
+    uint64_t a = cons->residue % m;
+    uint64_t e = cons->e > 1 ? cons->e : 1;
+
+    if (m > UINT32_MAX || e > UINT32_MAX || e % 2 == 0 || gcd(a, m) != 1)
     {
-        // Increment gap by 4 since: iZ(x, -1) - iZ(x-1, 1) = 4
-        gap += 4;
+        log_error("Unsatisfiable or out-of-range constraints (modulus %" PRIu64 ", residue %" PRIu64 ", e %" PRIu64 ").",
+                  cons->modulus, cons->residue, cons->e);
+        return 0;
+    }
 
-        // Check if iZ(vx * y + x, -1) is prime
-        if (bitmap_get_bit(vx_obj->x5, x))
+    // odd prime factors of e by trial division (e < 2^32)
+    uint64_t factors[VX_CONS_MAX_FACTORS];
+    int factor_count = 0;
+    for (uint64_t r = 3, rest = e; rest > 1; r += 2)
+    {
+        if (r * r > rest)
+            r = rest;
+        if (rest % r == 0)
         {
-            // Append gap to p_gaps
-            ui16_push(vx_obj->p_gaps, gap);
-            gap = 0; // Reset gap
+            factors[factor_count++] = r;
+            while (rest % r == 0)
+                rest /= r;
         }
+    }
 
-        // Increment gap by 2
-        gap += 2;
+    int count = 0;
+    for (int m_id = -1; m_id <= 1; m_id += 2)
+    {
+        VX_CONS_LINE line = {.m_id = m_id, .keep_m = 1, .keep_c = 0, .clear_count = 0};
+
+        // residue class: 6X = a - m_id (mod m)
+        uint64_t d = (m_id == -1) ? (a + 1) % m : (a + m - 1) % m;
+        uint64_t g = gcd(6, m);
+        if (d % g != 0)
+            continue;
+        line.keep_m = m / g;
+        if (line.keep_m > 1)
+            line.keep_c = (d / g) % line.keep_m * modular_inverse((6 / g) % line.keep_m, line.keep_m) % line.keep_m;
 
-        // Check if iZ(vx * y + x, 1) is prime
-        if (bitmap_get_bit(vx_obj->x7, x))
+        // exponent: p != 1 (mod r) for every prime r | e
+        int feasible = 1;
+        for (int j = 0; j < factor_count && feasible; j++)
         {
-            // Append gap to p_gaps
-            ui16_push(vx_obj->p_gaps, gap);
-            gap = 0; // Reset gap
+            uint64_t r = factors[j];
+            if (m % r == 0)
+                feasible = a % r != 1; // fixed by the residue class
+            else if (r == 3)
+                feasible = m_id == -1;
+            else
+            {
+                line.clear_r[line.clear_count] = r;
+                line.clear_c[line.clear_count] = (m_id == -1) ? modular_inverse(3, r) : 0;
+                line.clear_count++;
+            }
         }
+
+        if (feasible)
+            lines[count++] = line;
     }
 
-    // append final gap for backward calculations
-    ui16_push(vx_obj->p_gaps, gap);
+    if (count == 0)
+        log_error("No iZ line satisfies the constraints (modulus %" PRIu64 ", residue %" PRIu64 ", e %" PRIu64 ").",
+                  cons->modulus, cons->residue, cons->e);
+    return count;
 }
 
 /**
  * @ingroup iz_toolkit
- * @brief This function performs the sieve process on a given vx and y defined
- * in the VX_SEG structure, and stores the primes gaps in the vx_obj->p_gaps array.
+ * @brief horizontal search routine for a random prime meeting a constraint spec.
  *
- * Description: This function combines deterministic sieving and probabilistic
- * primality tests to identify prime candidates in a standard VX segment of a
- * specific y in the iZ-Matrix. It could be used to only count primes in the
- * vx segment, and optionally populates the vx_obj->p_gaps array with prime gaps
- * between consecutive primes detected in the segment.
+ * Description: The constraints are resolved before any candidate exists:
+ * - the line m_id is drawn among those compatible with the residue class and
+ *   with e (see vx_cons_lines()),
+ * - the residue class becomes a progression of x, which is walked directly
+ *   instead of testing every survivor,
+ * - every prime r >= 5 dividing e clears one extra progression per segment
+ *   (where r | p - 1), with its offset carried like a root prime's,
+ * - the random start is drawn in [L, 2^bit_size) with the top bits of L set,
+ *   and candidates past 2^bit_size are never tested; the search restarts at a
+ *   fresh random point instead.
  *
- * @param vx_obj The VX_SEG to be processed.
- * @param collect_p_gaps 0 only counts primes and doesn't store prime gaps,
- * other non-zero int values populates vx_obj->p_gaps with detected prime gaps.
+ * @param ctx Search context from vx_search_ctx_init().
+ * @param p The prime number found in the search.
+ * @param bit_size The target bit size of the prime.
+ * @param cons Constraints (NULL for none).
+ * @return 1 if a prime is found, 0 otherwise.
  */
-void vx_full_sieve(VX_SEG *vx_obj, int collect_p_gaps)
+int vx_search_prime_constrained(VX_SEARCH_CTX *ctx, mpz_t p, int bit_size, const IZ_PRIME_CONSTRAINTS *cons)
 {
-    assert(vx_obj && "vx_obj is NULL in vx_full_sieve");
+    assert(ctx && p && "Input parameters cannot be NULL in vx_search_prime_constrained.");
 
-    // If is_large_limit is true, perform probabilistic primality tests
-    if (vx_obj->is_large_limit)
-        vx_prob_sieve(vx_obj);
+    IZ_PRIME_CONSTRAINTS none = {0};
+    cons = cons ? cons : &none;
 
-    // If collect_p_gaps is true, populate the p_gaps array
-    if (collect_p_gaps)
-        vx_collect_p_gaps(vx_obj);
-}
+    VX_CONS_LINE lines[2];
+    int line_count = vx_cons_lines(cons, lines);
+    if (line_count == 0)
+        return 0;
 
-/**
- * @ingroup iz_toolkit
- * @brief Stream segment primes to an output stream in traversal order.
- * @param vx_obj Segment object.
- * @param output Destination stream (stdout or file).
- * @param stream_gaps If non-zero, output prime gaps instead of primes.
- */
-void vx_stream(VX_SEG *vx_obj, FILE *output, int stream_gaps)
-{
-    assert(vx_obj && "vx_obj is NULL in vx_stream");
-    assert(output && "output stream is NULL in vx_stream");
+    VX_SIEVE_STATE *state = ctx->state;
+    BITMAP *line = ctx->line;
+    uint64_t vx = ctx->iZm->vx;
 
-    // Initialize GMP reusable variables.
-    mpz_t last_p, gap, p, x_p;
-    mpz_init(last_p);
-    mpz_init(gap);
-    mpz_init(p);
-    mpz_init(x_p);
+    bit_size = MAX(bit_size, 10);
+    int top_bits = MIN(MAX(cons->top_bits, 0), bit_size - 1);
 
-    // Prime gaps are reported from this segment base.
-    iZ_mpz(last_p, vx_obj->yvx, 1);
-    if (stream_gaps)
+    // * 1. Fix the line and the candidate interval [lo, hi]
+    VX_CONS_LINE *cl = &lines[line_count == 2 ? gmp_random_below(ctx->rand, 2) : 0];
+
+    mpz_t lo, hi, x_max, x_room;
+    mpz_inits(lo, hi, x_max, x_room, NULL);
+    mpz_set_ui(lo, 0);
+    if (top_bits > 0)
     {
-        gmp_fprintf(output, "First prime gap computed from: %Zd\n", last_p);
+        mpz_setbit(lo, top_bits);
+        mpz_sub_ui(lo, lo, 1);
+        mpz_mul_2exp(lo, lo, bit_size - top_bits);
     }
+    mpz_setbit(hi, bit_size);
+    mpz_sub_ui(hi, hi, 1);
 
-    int r = vx_obj->mr_rounds;
+    // the interval must span a couple of segments past segment 0 to hold primes of every class
+    mpz_sub(x_room, hi, lo);
+    if (mpz_cmp_ui(x_room, 12 * vx) < 0 || mpz_cmp_ui(hi, 24 * vx) < 0)
+    {
+        log_error("bit_size %d with %d top bits is too narrow for vx = %" PRIu64 " in vx_search_prime_constrained.",
+                  bit_size, top_bits, vx);
+        mpz_clears(lo, hi, x_max, x_room, NULL);
+        return 0;
+    }
 
-    // Iterate through x values in the range start_x <= x <= end_x
-    for (int x = vx_obj->start_x; x <= vx_obj->end_x; x++)
+    // last X with 6X + m_id <= hi
+    mpz_sub_ui(x_max, hi, 1);
+    mpz_fdiv_q_ui(x_max, x_max, 6);
+
+    uint64_t keep_vx = vx % cl->keep_m;
+    uint64_t clear_vx[VX_CONS_MAX_FACTORS];
+    uint64_t clear_yvx[VX_CONS_MAX_FACTORS];
+    for (int j = 0; j < cl->clear_count; j++)
+        clear_vx[j] = vx % cl->clear_r[j];
+
+    int found = 0;
+    int stopped = 0;
+    while (!found && !stopped)
     {
-        // Check if iZ(vx * y + x, -1) is prime, if not, clear x in x5
-        if (bitmap_get_bit(vx_obj->x5, x))
+        // * 2. Draw a random start in [lo, hi] and solve every offset once for its segment
+        mpz_sub(ctx->z, hi, lo);
+        mpz_add_ui(ctx->z, ctx->z, 1);
+        mpz_urandomm(ctx->z, ctx->rand, ctx->z);
+        mpz_add(ctx->z, ctx->z, lo);
+        mpz_fdiv_q_ui(ctx->z, ctx->z, 6);
+
+        uint64_t x_start = mpz_fdiv_q_ui(ctx->z, ctx->z, vx);
+        if (mpz_sgn(ctx->z) == 0)
         {
-            // Compute x_p = yvx + x
-            mpz_add_ui(x_p, vx_obj->yvx, x);
-            iZ_mpz(p, x_p, -1); // Compute p = iZ(x_p, -1)
-            int is_prime = 1;
+            // segment 0 holds the root primes themselves
+            mpz_set_ui(ctx->z, 1);
+            x_start = 1;
+        }
 
-            if (vx_obj->is_large_limit)
-            {
-                vx_obj->p_test_ops++;
-                is_prime = test_primality(p, r);
-            }
+        vx_state_sync(state, ctx->z);
+        mpz_mul_ui(ctx->yvx, state->y, vx);
 
-            if (is_prime)
-            {
-                if (vx_obj->is_large_limit)
-                {
-                    vx_obj->p_count++; // otherwise already counted in det_sieve
-                }
-                if (stream_gaps)
-                {
-                    mpz_sub(gap, p, last_p);
-                    gmp_fprintf(output, "%Zd ", gap);
-                    mpz_set(last_p, p);
-                }
-                else
-                {
-                    gmp_fprintf(output, "%Zd ", p);
-                }
-            }
-            else
-            {
-                bitmap_clear_bit(vx_obj->x5, x); // Clear composite from x5
-            }
-        }
+        uint64_t keep_yvx = mpz_fdiv_ui(ctx->yvx, cl->keep_m);
+        for (int j = 0; j < cl->clear_count; j++)
+            clear_yvx[j] = mpz_fdiv_ui(ctx->yvx, cl->clear_r[j]);
 
-        // test iZ(vx * y + x, 1) for primality
-        if (bitmap_get_bit(vx_obj->x7, x))
+        // * 3. Walk the segments up to hi
+        for (;;)
         {
-            mpz_add_ui(x_p, vx_obj->yvx, x);
-            iZ_mpz(p, x_p, 1); // Compute p = iZ(x_p, 1)
-            int is_prime = 1;
+            // x range of this segment that stays within hi
+            mpz_sub(x_room, x_max, ctx->yvx);
+            if (mpz_sgn(x_room) <= 0)
+                break; // past hi: restart from a fresh random point
+            uint64_t x_end = mpz_cmp_ui(x_room, vx) < 0 ? mpz_get_ui(x_room) : vx;
 
-            if (vx_obj->is_large_limit)
+            vx_search_sieve_line(ctx, cl->m_id);
+
+            // p = 1 (mod r) for r | e: X = clear_c (mod r)
+            for (int j = 0; j < cl->clear_count; j++)
             {
-                vx_obj->p_test_ops++;
-                is_prime = test_primality(p, r);
+                uint64_t r = cl->clear_r[j];
+                uint64_t x = (cl->clear_c[j] + r - clear_yvx[j]) % r;
+                bitmap_clear_steps_simd(line, r, x ? x : r, vx);
             }
 
-            if (is_prime)
+            // walk the kept progression X = keep_c (mod keep_m) from x_start
+            uint64_t x = (cl->keep_c + cl->keep_m - keep_yvx) % cl->keep_m;
+            if (x < x_start)
+                x += (x_start - x + cl->keep_m - 1) / cl->keep_m * cl->keep_m;
+
+            for (; x <= x_end; x += cl->keep_m)
             {
-                if (vx_obj->is_large_limit)
-                {
-                    vx_obj->p_count++;
-                }
-                if (stream_gaps)
+                if (!bitmap_get_bit(line, x))
+                    continue;
+
+                // another searcher already finished
+                if (ctx->stop && atomic_load_explicit(ctx->stop, memory_order_relaxed))
                 {
-                    mpz_sub(gap, p, last_p);
-                    gmp_fprintf(output, "%Zd ", gap);
-                    mpz_set(last_p, p);
+                    stopped = 1;
+                    break;
                 }
-                else
+
+                // z = iZ(vx * y + x, m_id)
+                mpz_add_ui(ctx->z, ctx->yvx, x);
+                iZ_mpz(ctx->z, ctx->z, cl->m_id);
+                if (mpz_cmp(ctx->z, lo) >= 0 && test_primality(ctx->z, MR_ROUNDS))
                 {
-                    gmp_fprintf(output, "%Zd ", p);
+                    mpz_set(p, ctx->z);
+                    found = 1;
+                    break;
                 }
             }
-            else
+
+            if (found || stopped)
+                break;
+
+            // * 4. Move all offsets and residues to the next vx segment
+            vx_state_advance(state);
+            mpz_add_ui(ctx->yvx, ctx->yvx, vx);
+            x_start = 1;
+
+            keep_yvx += keep_vx;
+            if (keep_yvx >= cl->keep_m)
+                keep_yvx -= cl->keep_m;
+            for (int j = 0; j < cl->clear_count; j++)
             {
-                bitmap_clear_bit(vx_obj->x7, x); // Clear composite from x7
+                clear_yvx[j] += clear_vx[j];
+                if (clear_yvx[j] >= cl->clear_r[j])
+                    clear_yvx[j] -= cl->clear_r[j];
             }
         }
     }
 
-    mpz_clears(last_p, gap, p, x_p, NULL);
+    mpz_clears(lo, hi, x_max, x_room, NULL);
+    return found;
 }
 
-// ==================================================
-// * IZM_RANGE_INFO structure:
-// ==================================================
-
-IZM_RANGE_INFO range_info_init(INPUT_SIEVE_RANGE *input_range, int vx)
+/**
+ * @brief Build the 2p+1 sieving data of a search context on first use.
+ *
+ * A Sophie Germain candidate s = 6X - 1 gives 2s + 1 = 12X - 1, which is
+ * divisible by a prime r exactly when X = 12^-1 (mod r). For the wheel primes
+ * (r | vx) that is the same x in every segment, so it is cleared once into
+ * @ref VX_SEARCH_CTX::safe_base. For a tracked prime, the s hit X = 6^-1 and
+ * the 2s + 1 hit differ by the constant 12^-1 - 6^-1 = -12^-1 (mod r), so the
+ * second offset follows the carried first one.
+ *
+ * @param ctx Search context.
+ * @return 1 on success, 0 on allocation failure.
+ */
+static int vx_search_ctx_prepare_safe(VX_SEARCH_CTX *ctx)
 {
-    IZM_RANGE_INFO info = {0};
-    info.vx = vx;
-    info.y_range = -1;
+    if (ctx->safe_base)
+        return 1;
 
-    mpz_inits(info.Zs, info.Ze, info.Xs, info.Xe, info.Ys, info.Ye, NULL);
+    IZM *iZm = ctx->iZm;
+    VX_SIEVE_STATE *state = ctx->state;
 
-    if (!input_range || !input_range->start || vx < 35 || mpz_set_str(info.Zs, input_range->start, 10) != 0)
+    ctx->safe_base = bitmap_clone(iZm->base_x5);
+    ctx->safe_delta = malloc(MAX(state->count, 1) * sizeof(uint32_t));
+    if (!ctx->safe_base || !ctx->safe_delta)
     {
-        log_error("range_info_init: invalid input.");
-        return info;
+        log_error("Memory allocation failed for safe-prime sieving data.");
+        bitmap_free(&ctx->safe_base);
+        free(ctx->safe_delta);
+        ctx->safe_delta = NULL;
+        return 0;
     }
 
-    if (input_range->range == 0)
-    {
-        mpz_set(info.Ze, info.Zs);
-    }
-    else
+    for (int i = 2; i < state->k; i++)
     {
-        // inclusive upper bound for range size semantics: [start, start + range - 1]
-        mpz_add_ui(info.Ze, info.Zs, input_range->range - 1);
+        uint64_t r = iZm->root_primes->array[i];
+        bitmap_clear_steps_simd(ctx->safe_base, r, modular_inverse(12 % r, r), iZm->vx);
     }
 
-    mpz_fdiv_q_ui(info.Xs, info.Zs, 6);
-    mpz_fdiv_q_ui(info.Xe, info.Ze, 6);
-    mpz_fdiv_q_ui(info.Ys, info.Xs, vx);
-    mpz_fdiv_q_ui(info.Ye, info.Xe, vx);
-
-    mpz_t y_delta;
-    mpz_init(y_delta);
-    mpz_sub(y_delta, info.Ye, info.Ys);
-
-    if (mpz_sgn(y_delta) < 0 || !mpz_fits_sint_p(y_delta))
+    for (int i = 0; i < state->count; i++)
     {
-        log_error("range_info_init: computed y-range is out of supported bounds.");
-        mpz_clear(y_delta);
-        return info;
+        uint32_t r = state->primes[i];
+        ctx->safe_delta[i] = r - (uint32_t)modular_inverse(12 % r, r);
     }
 
-    info.y_range = (int)mpz_get_si(y_delta);
-    mpz_clear(y_delta);
-
-    return info;
-}
-
-void range_info_free(IZM_RANGE_INFO *info)
-{
-    if (info == NULL)
-        return;
-
-    mpz_clears(info->Zs, info->Ze, info->Xs, info->Xe, info->Ys, info->Ye, NULL);
+    return 1;
 }
 
-// ==================================================
-// * iZm Search primes routines:
-// ==================================================
-
 /**
  * @ingroup iz_toolkit
- * @brief horizontal search routine for generating a random prime.
+ * @brief horizontal search routine for generating a random safe prime, reusing a context.
  *
- * Description: This function searches for a prime number using the given parameters.
- * It combines the iZ-Matrix filtering techniques with the Miller-Rabin primality test.
- * The search is performed by finding suitable x values that do not correspond to
- * composites of primes that divide vx. Then, it iterates over y values in the
- * equation p = iZ(x + vx * y) until a prime is found.
+ * Description: Searches Sophie Germain candidates s = iZ(x + vx * y, -1) from a
+ * random segment y (2s + 1 is divisible by 3 on the other line). Each segment
+ * is restored from the safe base and cleared in one pass at both the s hits
+ * and the 2s + 1 hits of every root prime, so only pairs with no small factor
+ * survive. Survivors take a base-2 Fermat test on s, then on q = 2s + 1, and
+ * only then the full primality test of s. Given s prime, 2^(q-1) = 1 (mod q)
+ * proves q prime (Pocklington with q - 1 = 2s and gcd(2^2 - 1, q) = 1), so q
+ * needs no further test.
  *
- * @param p The prime number found in the search.
- * @param m_id The identifier (1 or -1) for the iZ matrix.
- * @param vx The horizontal vector of the iZ matrix.
- * @param bit_size The target bit size of the prime.
- * @return 1 if a prime is found, 0 otherwise.
+ * @param ctx Search context from vx_search_ctx_init().
+ * @param p The safe prime found in the search.
+ * @param bit_size The target bit size of the safe prime.
+ * @return 1 if a safe prime is found, 0 otherwise.
  */
-int vx_search_prime(mpz_t p, int m_id, int vx, int bit_size)
+int vx_search_safe_prime_ctx(VX_SEARCH_CTX *ctx, mpz_t p, int bit_size)
 {
-    // assert p is not NULL
-    assert(p && "p cannot be NULL in vx_search_prime.");
+    assert(ctx && p && "Input parameters cannot be NULL in vx_search_safe_prime_ctx.");
 
-    bit_size = MAX(bit_size, 10);
+    if (!vx_search_ctx_prepare_safe(ctx))
+        return 0;
 
-    gmp_randstate_t state;
-    gmp_randinit_default(state);
-    gmp_seed_randstate(state);
+    IZM *iZm = ctx->iZm;
+    VX_SIEVE_STATE *state = ctx->state;
+    BITMAP *line = ctx->line;
+    int vx = iZm->vx;
 
-    // set m_id randomly if not provided
-    if (m_id != -1 && m_id != 1)
-        m_id = gmp_random_below(state, 2) ? 1 : -1;
+    bit_size = MAX(bit_size, 10);
 
-    UI64_ARRAY *root_primes = SiZm(vx);
-    if (!root_primes)
-    {
-        log_error("Failed to initialize root primes in vx_search_prime");
-        gmp_randclear(state);
-        return 0;
-    }
+    uint32_t *next = state->x5_next;
+    uint32_t *delta = ctx->safe_delta;
+    BITMAP_PATTERN *pattern = iZm->pattern;
+    uint64_t starts[BITMAP_PATTERN_MAX_COUNT];
+    uint64_t safe_starts[BITMAP_PATTERN_MAX_COUNT];
 
-    mpz_t z, x_z, y, yvx;
-    mpz_init(z);
-    mpz_init(x_z);
-    mpz_init(y);
-    mpz_init(yvx);
+    // * 1. Pick a random segment y >= 1 for s (one bit below the safe prime) and solve the offsets once
+    mpz_urandomb(ctx->z, ctx->rand, bit_size - 1);
+    mpz_fdiv_q_ui(ctx->z, ctx->z, 6 * vx);
+    if (mpz_sgn(ctx->z) == 0)
+        mpz_set_ui(ctx->z, 1);
+
+    vx_state_sync(state, ctx->z);
+    mpz_mul_ui(ctx->yvx, state->y, vx);
 
-    mpz_urandomb(y, state, bit_size);
-    mpz_fdiv_q_ui(y, y, 6 * vx);
-    mpz_mul_ui(yvx, y, vx); // compute yvx = vx * y
+    mpz_t q, e, t;
+    mpz_inits(q, e, t, NULL);
 
     int found = 0;
-    while (!found)
+    int stopped = 0;
+    while (!found && !stopped)
     {
-        BITMAP *bitmap = bitmap_init(vx + 10, 1);
+        // * 2. Restore the safe base and clear the s and 2s + 1 hits in one pass
+        memcpy(line->data, ctx->safe_base->data, ctx->safe_base->byte_size);
 
-        // sieve the bitmap with root primes skipping 2 and 3
-        for (int i = 2; i < root_primes->count; i++)
+        for (int i = 0; i < pattern->count; i++)
         {
-            uint64_t q = root_primes->array[i];
-            // mark composites of q in the bitmap
-            bitmap_clear_steps(bitmap, q, iZm_solve_for_x0_mpz(m_id, q, vx, y), vx);
+            uint32_t r = state->primes[i];
+            uint32_t x = next[i] + delta[i];
+            starts[i] = next[i];
+            safe_starts[i] = x > r ? x - r : x;
         }
+        bitmap_apply_pattern(line, pattern, starts, vx);
+        bitmap_apply_pattern(line, pattern, safe_starts, vx);
 
-        int random_x = gmp_random_below(state, MAX(vx / 2, 1)); // random x < vx/2
-        for (int x = random_x; x < vx; x++)
+        for (int i = pattern->count; i < state->count; i++)
         {
-            // check if z is prime candidate in bitmap
-            if (bitmap_get_bit(bitmap, x))
+            uint32_t r = state->primes[i];
+            uint32_t x = next[i] + delta[i];
+            bitmap_clear_steps_simd(line, r, next[i], vx);
+            bitmap_clear_steps_simd(line, r, x > r ? x - r : x, vx);
+        }
+
+        // * 3. Test the surviving pairs from a random x, cheapest checks first
+        size_t random_x = gmp_random_below(ctx->rand, MAX(vx / 2, 1)); // random x < vx/2
+        for (size_t x = bitmap_next_set_bit(line, random_x, vx); x != BITMAP_NPOS;
+             x = bitmap_next_set_bit(line, x + 1, vx))
+        {
+            // another searcher already finished
+            if (ctx->stop && atomic_load_explicit(ctx->stop, memory_order_relaxed))
             {
-                // compute x_z = vx * y + x
-                mpz_add_ui(x_z, yvx, x);
-                iZ_mpz(z, x_z, m_id);
-                // check if z is prime
-                found = test_primality(z, MR_ROUNDS);
+                stopped = 1;
+                break;
+            }
 
-                // if z is prime, set p = z
-                if (found)
-                {
-                    mpz_set(p, z);
-                    break;
-                }
+            // s = iZ(vx * y + x, -1), q = 2s + 1
+            mpz_add_ui(ctx->z, ctx->yvx, x);
+            iZ_mpz(ctx->z, ctx->z, -1);
+            mpz_mul_2exp(q, ctx->z, 1);
+            mpz_add_ui(q, q, 1);
+
+            // base-2 Fermat on s, then on q
+            mpz_sub_ui(e, ctx->z, 1);
+            mpz_set_ui(t, 2);
+            mpz_powm(t, t, e, ctx->z);
+            if (mpz_cmp_ui(t, 1) != 0)
+                continue;
+
+            mpz_sub_ui(e, q, 1);
+            mpz_set_ui(t, 2);
+            mpz_powm(t, t, e, q);
+            if (mpz_cmp_ui(t, 1) != 0)
+                continue;
+
+            // confirm s; q then follows from Pocklington
+            if (test_primality(ctx->z, MR_ROUNDS))
+            {
+                mpz_set(p, q);
+                found = 1;
+                break;
             }
         }
 
-        // cleanup
-        bitmap_free(&bitmap);
+        // * 4. Move the offsets and yvx to the next vx segment
+        vx_state_advance(state);
+        mpz_add_ui(ctx->yvx, ctx->yvx, vx);
+    }
+
+    mpz_clears(q, e, t, NULL);
+    return found;
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief horizontal search routine for generating a random prime.
+ *
+ * Description: One-shot wrapper around vx_search_prime_ctx(): it builds a
+ * search context for @p vx, runs a single search and frees the context.
+ * Callers generating many primes should keep a VX_SEARCH_CTX instead.
+ *
+ * @param p The prime number found in the search.
+ * @param m_id The identifier (1 or -1) for the iZ matrix.
+ * @param vx The horizontal vector of the iZ matrix.
+ * @param bit_size The target bit size of the prime.
+ * @return 1 if a prime is found, 0 otherwise.
+ */
+int vx_search_prime(mpz_t p, int m_id, int vx, int bit_size)
+{
+    // assert p is not NULL
+    assert(p && "p cannot be NULL in vx_search_prime.");
 
-        // increment y by 1 for next vx segment
-        mpz_add_ui(y, y, 1);
-        mpz_add_ui(yvx, yvx, vx);
+    VX_SEARCH_CTX *ctx = vx_search_ctx_init(vx);
+    if (!ctx)
+    {
+        log_error("Failed to initialize search context in vx_search_prime");
+        return 0;
     }
 
-    ui64_free(&root_primes);
-    mpz_clears(z, x_z, y, yvx, NULL);
-    gmp_randclear(state);
+    int found = vx_search_prime_ctx(ctx, p, m_id, bit_size);
 
+    vx_search_ctx_free(&ctx);
     return found;
 }
 
+/** Rows of a vy_search_prime() lane sieved per window. */
+#define VY_SEARCH_WINDOW 4096
+/** Sieving depth of vy_search_prime() per bit of the candidates. */
+#define VY_SEARCH_DEPTH_PER_BIT 128
+/** Upper bound on the vy_search_prime() sieving depth. */
+#define VY_SEARCH_DEPTH_MAX (1ULL << 22)
+
 /**
  * @ingroup iz_toolkit
  * @brief vertical search routine for generating a random prime.
@@ -1149,6 +4341,11 @@ int vx_search_prime(mpz_t p, int m_id, int vx, int bit_size)
  * a composite of a prime that divides vx. Then, it iterates over y value in the
  * equation p = iZ(x + vx * y, m_id) until a prime is found.
  *
+ * The lane z + j * 6vx is sieved in windows of VY_SEARCH_WINDOW rows by the
+ * primes up to a bit-size dependent depth that do not divide vx: prime q hits
+ * the rows j = -z * (6vx)^-1 (mod q), so one residue pair per q solves its first
+ * hit, and later windows shift it by the window size. Only survivors are tested.
+ *
  * @param p The prime number found in the search.
  * @param m_id The identifier (1 or -1) for the iZ matrix.
  * @param vx The horizontal vector of the iZ matrix.
@@ -1156,6 +4353,26 @@ int vx_search_prime(mpz_t p, int m_id, int vx, int bit_size)
  */
 int vy_search_prime(mpz_t p, int m_id, mpz_t vx)
 {
+    return vy_search_prime_until(p, m_id, vx, NULL);
+}
+
+/**
+ * @ingroup iz_toolkit
+ * @brief vertical search routine for generating a random prime, with cancellation.
+ *
+ * Description: Same search as vy_search_prime(), but @p stop_flag (when not NULL)
+ * is read before every primality test, so parallel searchers can give up as
+ * soon as one of them raises it.
+ *
+ * @param p The prime number found in the search.
+ * @param m_id The identifier (1 or -1) for the iZ matrix.
+ * @param vx The horizontal vector of the iZ matrix.
+ * @param stop_flag Optional cancel flag (address of an atomic_int).
+ * @return 1 if a prime is found, 0 otherwise (including cancellation).
+ */
+int vy_search_prime_until(mpz_t p, int m_id, mpz_t vx, void *stop_flag)
+{
+    atomic_int *stop = stop_flag;
     assert(p && vx && "Input parameters cannot be NULL");
 
     int found = 0; // flag to indicate if a prime was found
@@ -1198,22 +4415,96 @@ int vy_search_prime(mpz_t p, int m_id, mpz_t vx)
     int rand_steps = gmp_random_below(state, 100);
     mpz_addmul_ui(z, g, rand_steps);
 
-    while (!found)
+    // advance y by 1: z is now row 0 of the first window
+    mpz_add(z, z, g);
+
+    // sieving primes past 2, 3 (those dividing vx never hit the lane);
+    // small candidates are cheap to test directly
+    size_t bits = mpz_sizeinbase(z, 2);
+    uint64_t depth = (bits < 64) ? 0 : MIN((uint64_t)bits * VY_SEARCH_DEPTH_PER_BIT, VY_SEARCH_DEPTH_MAX);
+    UI64_ARRAY *sieve_primes = depth ? SiZm(depth) : NULL;
+    int q_count = sieve_primes ? sieve_primes->count : 0;
+
+    uint32_t *next = malloc(MAX(q_count, 1) * sizeof(uint32_t)); // next row hit per sieving prime
+    BITMAP *window = bitmap_init(VY_SEARCH_WINDOW + 8, 1);
+    if (!next || !window)
+    {
+        log_error("Memory allocation failed in vy_search_prime; testing every lane candidate");
+        q_count = 0;
+    }
+
+    for (int i = 2; i < q_count; i++)
+    {
+        uint64_t q = sieve_primes->array[i];
+        uint64_t g_mod = mpz_fdiv_ui(g, q);
+        if (g_mod == 0)
+        {
+            next[i] = UINT32_MAX; // q divides vx
+            continue;
+        }
+        uint64_t z_mod = mpz_fdiv_ui(z, q);
+        next[i] = (uint32_t)(((q - z_mod) % q) * modular_inverse(g_mod, q) % q);
+    }
+
+    mpz_t candidate;
+    mpz_init(candidate);
+    while (!found && !(stop && atomic_load_explicit(stop, memory_order_relaxed)))
     {
-        // increment z by 6 * vx to advance y by 1
-        mpz_add(z, z, g);
+        if (q_count == 0)
+        {
+            // no sieve: test every row
+            found = test_primality(z, MR_ROUNDS);
+            if (found)
+                mpz_set(p, z);
+            mpz_add(z, z, g);
+            continue;
+        }
+
+        // * sieve the window rows [0, VY_SEARCH_WINDOW) of the lane
+        bitmap_set_all(window);
+        for (int i = 2; i < q_count; i++)
+        {
+            uint64_t j = next[i];
+            if (j == UINT32_MAX)
+                continue;
+
+            uint64_t q = sieve_primes->array[i];
+            if (j < VY_SEARCH_WINDOW)
+            {
+                bitmap_clear_steps_simd(window, q, j, VY_SEARCH_WINDOW - 1);
+                j += (VY_SEARCH_WINDOW - 1 - j) / q * q + q; // first hit past the window
+            }
+            next[i] = (uint32_t)(j - VY_SEARCH_WINDOW);
+        }
+
+        // * test survivors in lane order
+        for (size_t j = bitmap_next_set_bit(window, 0, VY_SEARCH_WINDOW - 1); j != BITMAP_NPOS;
+             j = bitmap_next_set_bit(window, j + 1, VY_SEARCH_WINDOW - 1))
+        {
+            // another searcher already finished
+            if (stop && atomic_load_explicit(stop, memory_order_relaxed))
+                break;
 
-        // check if z is prime
-        found = test_primality(z, MR_ROUNDS);
+            mpz_set(candidate, z);
+            mpz_addmul_ui(candidate, g, j);
+            found = test_primality(candidate, MR_ROUNDS);
+            if (found)
+            {
+                mpz_set(p, candidate);
+                break;
+            }
+        }
 
-        // if z is prime, set p = z
-        if (found)
-            mpz_set(p, z);
+        // advance to the next window
+        mpz_addmul_ui(z, g, VY_SEARCH_WINDOW);
     }
 
     // cleanup
+    free(next);
+    bitmap_free(&window);
+    ui64_free(&sieve_primes);
     gmp_randclear(state);
-    mpz_clears(z, g, NULL);
+    mpz_clears(z, g, candidate, NULL);
 
     return found;
 }
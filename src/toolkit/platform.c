@@ -112,6 +112,17 @@ int iz_platform_l2_cache_size_bits(void)
     return 256 * 1024 * 8;
 }
 
+int iz_platform_cpu_has_avx512ifma(void)
+{
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+           __builtin_cpu_supports("avx512ifma");
+#else
+    return 0;
+#endif
+}
+
 double iz_platform_monotonic_seconds(void)
 {
 #if IZ_PLATFORM_WINDOWS
@@ -331,6 +331,42 @@ int RUN_TEST_INTEGRATIONS(int verbose)
     else
         failed_tests++;
 
+    // * Run vx_random_prime_constrained tests
+    printf("\n\n");
+    result = TEST_vx_random_prime_constrained(verbose);
+    total_tests++;
+    if (result)
+        passed_tests++;
+    else
+        failed_tests++;
+
+    // * Run vx_random_safe_prime tests
+    printf("\n\n");
+    result = TEST_vx_random_safe_prime(verbose);
+    total_tests++;
+    if (result)
+        passed_tests++;
+    else
+        failed_tests++;
+
+    // * Run iZ_random_primes tests
+    printf("\n\n");
+    result = TEST_iZ_random_primes(verbose);
+    total_tests++;
+    if (result)
+        passed_tests++;
+    else
+        failed_tests++;
+
+    // * Run iZ_next_prime_batch tests
+    printf("\n\n");
+    result = TEST_iZ_next_prime_batch(verbose);
+    total_tests++;
+    if (result)
+        passed_tests++;
+    else
+        failed_tests++;
+
     // * Print overall summary
     printf("\n\n");
     print_line(60, '*');
@@ -1,5 +1,34 @@
 #include <bitmap.h>
 
+/**
+ * @brief Visitor context used to check bitmap_for_each_set_bit() against bitmap_get_bit().
+ */
+typedef struct
+{
+    BITMAP *bitmap;    /**< Bitmap being scanned. */
+    size_t expected;   /**< Next index the visitor is expected to see. */
+    size_t visited;    /**< Number of visited indices. */
+    int ordered_ok;    /**< Cleared when an index is skipped or repeated. */
+} TEST_BIT_VISIT_CTX;
+
+static void test_bit_visitor(size_t idx, void *ctx)
+{
+    TEST_BIT_VISIT_CTX *visit = (TEST_BIT_VISIT_CTX *)ctx;
+
+    // every index between the previous visit and this one must be clear
+    while (visit->expected < idx)
+    {
+        if (bitmap_get_bit(visit->bitmap, visit->expected))
+            visit->ordered_ok = 0;
+        visit->expected++;
+    }
+    if (visit->expected != idx || !bitmap_get_bit(visit->bitmap, idx))
+        visit->ordered_ok = 0;
+
+    visit->expected = idx + 1;
+    visit->visited++;
+}
+
 /**
  * @brief Test function for BITMAP.
  *
@@ -414,7 +443,232 @@ int TEST_BITMAP(int verbose)
     }
     remove(file_path); // Clean up test file
 
-    // * Test 13: bitmap_free
+    // * Test 13: bitmap_count_range
+    current_test_idx++;
+    current_test_result = 1;
+    if (read_bitmap == NULL)
+    {
+        current_test_result = 0;
+        failed_tests++;
+    }
+    else
+    {
+        // unaligned windows crossing word boundaries, plus the capped tail
+        size_t ranges[][2] = {{0, test_size - 1}, {1, 63}, {5, 5}, {60, 130}, {64, 127}, {333, 999}, {900, test_size + 50}};
+        for (size_t r = 0; r < sizeof(ranges) / sizeof(ranges[0]) && current_test_result; r++)
+        {
+            size_t expected = 0;
+            for (size_t i = ranges[r][0]; i <= ranges[r][1] && i < test_size; i++)
+                expected += bitmap_get_bit(read_bitmap, i);
+
+            size_t counted = bitmap_count_range(read_bitmap, ranges[r][0], ranges[r][1]);
+            if (counted != expected)
+            {
+                current_test_result = 0;
+                failed_tests++;
+                if (verbose)
+                {
+                    print_test_module_result(0, current_test_idx, "bitmap_count_range", "Range [%zu, %zu] counted %zu, expected %zu", ranges[r][0], ranges[r][1], counted, expected);
+                }
+            }
+        }
+    }
+    if (current_test_result)
+    {
+        passed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(1, current_test_idx, "bitmap_count_range", "Popcount matches per-bit reference");
+        }
+    }
+
+    // * Test 14: bitmap_next_set_bit
+    current_test_idx++;
+    current_test_result = 1;
+    if (read_bitmap == NULL)
+    {
+        current_test_result = 0;
+        failed_tests++;
+    }
+    else
+    {
+        for (size_t i = 0; i < test_size; i++)
+        {
+            size_t expected = BITMAP_NPOS;
+            for (size_t j = i; j < test_size; j++)
+                if (bitmap_get_bit(read_bitmap, j))
+                {
+                    expected = j;
+                    break;
+                }
+
+            if (bitmap_next_set_bit(read_bitmap, i, test_size - 1) != expected)
+            {
+                current_test_result = 0;
+                failed_tests++;
+                if (verbose)
+                {
+                    print_test_module_result(0, current_test_idx, "bitmap_next_set_bit", "Wrong result starting at %zu", i);
+                }
+                break;
+            }
+        }
+
+        // a limit that excludes the next set bit must report BITMAP_NPOS
+        if (current_test_result && bitmap_next_set_bit(read_bitmap, 3, 3) != BITMAP_NPOS)
+        {
+            current_test_result = 0;
+            failed_tests++;
+            if (verbose)
+            {
+                print_test_module_result(0, current_test_idx, "bitmap_next_set_bit", "Limit not honoured");
+            }
+        }
+    }
+    if (current_test_result)
+    {
+        passed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(1, current_test_idx, "bitmap_next_set_bit", "Set-bit scan matches per-bit reference");
+        }
+    }
+
+    // * Test 15: bitmap_for_each_set_bit
+    current_test_idx++;
+    current_test_result = 1;
+    if (read_bitmap == NULL)
+    {
+        current_test_result = 0;
+        failed_tests++;
+    }
+    else
+    {
+        TEST_BIT_VISIT_CTX visit = {read_bitmap, 7, 0, 1};
+        bitmap_for_each_set_bit(read_bitmap, 7, 870, test_bit_visitor, &visit);
+
+        if (!visit.ordered_ok || visit.visited != bitmap_count_range(read_bitmap, 7, 870))
+        {
+            current_test_result = 0;
+            failed_tests++;
+            if (verbose)
+            {
+                print_test_module_result(0, current_test_idx, "bitmap_for_each_set_bit", "Visited %zu bits, order ok: %d", visit.visited, visit.ordered_ok);
+            }
+        }
+    }
+    if (current_test_result)
+    {
+        passed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(1, current_test_idx, "bitmap_for_each_set_bit", "All set bits visited in order");
+        }
+    }
+
+    // * Test 16: bitmap_apply_pattern
+    current_test_idx++;
+    current_test_result = 1;
+    {
+        // odd, unaligned sizes and starts, including a start beyond the limit
+        uint64_t steps[] = {5, 7, 23, 29, 61, 127};
+        uint64_t starts[] = {3, 0, 100, 64, 7, 5000};
+        int steps_count = sizeof(steps) / sizeof(steps[0]);
+        size_t pattern_size = 4099;
+        uint64_t pattern_limit = 4001;
+
+        BITMAP_PATTERN *pattern = bitmap_pattern_init(steps, steps_count);
+        BITMAP *expected_bm = bitmap_init(pattern_size, 1);
+        BITMAP *pattern_bm = bitmap_init(pattern_size, 1);
+        if (!pattern || !expected_bm || !pattern_bm)
+        {
+            current_test_result = 0;
+            failed_tests++;
+        }
+        else
+        {
+            for (int i = 0; i < steps_count; i++)
+                if (starts[i] <= pattern_limit)
+                    bitmap_clear_steps(expected_bm, steps[i], starts[i], pattern_limit);
+            bitmap_apply_pattern(pattern_bm, pattern, starts, pattern_limit);
+
+            for (size_t i = 0; i < pattern_size; i++)
+            {
+                if (bitmap_get_bit(pattern_bm, i) != bitmap_get_bit(expected_bm, i))
+                {
+                    current_test_result = 0;
+                    failed_tests++;
+                    if (verbose)
+                    {
+                        print_test_module_result(0, current_test_idx, "bitmap_apply_pattern", "Bit %zu differs from bitmap_clear_steps", i);
+                    }
+                    break;
+                }
+            }
+        }
+        bitmap_pattern_free(&pattern);
+        bitmap_free(&expected_bm);
+        bitmap_free(&pattern_bm);
+    }
+    if (current_test_result)
+    {
+        passed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(1, current_test_idx, "bitmap_apply_pattern", "Word masks match bitmap_clear_steps");
+        }
+    }
+
+    // * Test 17: bitmap_clear_steps_simd
+    current_test_idx++;
+    current_test_result = 1;
+    {
+        // small (word-mask), medium (wheel) and large (scalar) steps, unaligned bounds
+        uint64_t steps[] = {1, 2, 3, 7, 8, 13, 64, 97, 131, 1021, 3001};
+        int steps_count = sizeof(steps) / sizeof(steps[0]);
+        size_t steps_size = 5003;
+
+        BITMAP *expected_bm = bitmap_init(steps_size, 1);
+        BITMAP *simd_bm = bitmap_init(steps_size, 1);
+        if (!expected_bm || !simd_bm)
+        {
+            current_test_result = 0;
+            failed_tests++;
+        }
+        for (int i = 0; i < steps_count && current_test_result; i++)
+        {
+            for (uint64_t start = 0; start < 70 && current_test_result; start += 11)
+            {
+                uint64_t limit = steps_size - 1 - start * 3;
+                bitmap_set_all(expected_bm);
+                bitmap_set_all(simd_bm);
+                bitmap_clear_steps(expected_bm, steps[i], start, limit);
+                bitmap_clear_steps_simd(simd_bm, steps[i], start, limit);
+
+                if (memcmp(expected_bm->data, simd_bm->data, expected_bm->byte_size) != 0)
+                {
+                    current_test_result = 0;
+                    failed_tests++;
+                    if (verbose)
+                    {
+                        print_test_module_result(0, current_test_idx, "bitmap_clear_steps_simd", "Mismatch for step %" PRIu64 " start %" PRIu64, steps[i], start);
+                    }
+                }
+            }
+        }
+        bitmap_free(&expected_bm);
+        bitmap_free(&simd_bm);
+    }
+    if (current_test_result)
+    {
+        passed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(1, current_test_idx, "bitmap_clear_steps_simd", "All kernels match bitmap_clear_steps");
+        }
+    }
+
+    // * Test 18: bitmap_free
     current_test_idx++;
     current_test_result = 1;
     bitmap_free(&read_bitmap);
@@ -246,6 +246,14 @@ int TEST_CLI(int verbose)
     create_dir(DIR_output);
     const char *stream_file = DIR_output "/cli_stream_test.txt";
     const char *bench_file = DIR_output "/cli_bench_test.csv";
+    const char *bases_file = DIR_output "/cli_bases_test.txt";
+
+    FILE *bases_out = fopen(bases_file, "w");
+    if (bases_out)
+    {
+        fputs("# bases for batch next/prev\n10^2+1\n\n  1000  \n", bases_out);
+        fclose(bases_out);
+    }
 
     CLI_TEST_CASE cases[] = {
         {.name = "general help", .argc = 1, .argv = {"izprime"}, .expected_exit = EXIT_SUCCESS, .stdout_contains = "iZprime CLI"},
@@ -265,15 +273,27 @@ int TEST_CLI(int verbose)
         {.name = "count primes", .argc = 6, .argv = {"izprime", "count_primes", "--range", "[0, 200]", "--cores", "1"}, .expected_exit = EXIT_SUCCESS, .stdout_contains = "Prime count in [0, 200] = 46"},
         {.name = "count alias", .argc = 6, .argv = {"izprime", "count", "--range", "[0, 200]", "--cores", "1"}, .expected_exit = EXIT_SUCCESS, .stdout_contains = "Prime count in [0, 200] = 46"},
         {.name = "count invalid cores", .argc = 6, .argv = {"izprime", "count_primes", "--range", "[0, 200]", "--cores", "0"}, .expected_exit = EXIT_FAILURE, .stderr_contains = "Invalid --cores value"},
+        {.name = "count primality bpsw", .argc = 8, .argv = {"izprime", "count_primes", "--range", "[0, 200]", "--cores", "1", "--primality", "bpsw"}, .expected_exit = EXIT_SUCCESS, .stdout_contains = "Prime count in [0, 200] = 46"},
+        {.name = "count invalid primality", .argc = 6, .argv = {"izprime", "count_primes", "--range", "[0, 200]", "--primality", "aks"}, .expected_exit = EXIT_FAILURE, .stderr_contains = "Invalid --primality value"},
+        {.name = "count sieve depth", .argc = 8, .argv = {"izprime", "count_primes", "--range", "[10^14, 10^14 + 10^5]", "--cores", "1", "--sieve-depth", "2^24"}, .expected_exit = EXIT_SUCCESS, .stdout_contains = "Prime count in [100000000000000, 100000000100000] = 3045"},
+        {.name = "count invalid sieve depth", .argc = 6, .argv = {"izprime", "count_primes", "--range", "[0, 200]", "--sieve-depth", "2^33"}, .expected_exit = EXIT_FAILURE, .stderr_contains = "Invalid --sieve-depth value"},
+        {.name = "count sieve depth above 2^26", .argc = 6, .argv = {"izprime", "count_primes", "--range", "[0, 200]", "--sieve-depth", "2^26+1"}, .expected_exit = EXIT_FAILURE, .stderr_contains = "Invalid --sieve-depth value"},
+        {.name = "count sieve depth 4 cores", .argc = 8, .argv = {"izprime", "count_primes", "--range", "[10^14, 10^14 + 10^5]", "--cores", "4", "--sieve-depth", "2^22"}, .expected_exit = EXIT_SUCCESS, .stdout_contains = "Prime count in [100000000000000, 100000000100000] = 3045"},
         {.name = "count precondition", .argc = 4, .argv = {"izprime", "count_primes", "--range", "[0, 99]"}, .expected_exit = EXIT_FAILURE, .stderr_contains = "Range size must be > 100"},
 
         {.name = "next prime", .argc = 4, .argv = {"izprime", "next_prime", "--n", "10^2+1"}, .expected_exit = EXIT_SUCCESS, .stdout_contains = "Next prime after 101 is 103"},
         {.name = "next alias", .argc = 4, .argv = {"izprime", "next", "--n", "10^2+1"}, .expected_exit = EXIT_SUCCESS, .stdout_contains = "Next prime after 101 is 103"},
         {.name = "prev prime", .argc = 4, .argv = {"izprime", "prev_prime", "--n", "10^2+1"}, .expected_exit = EXIT_SUCCESS, .stdout_contains = "Previous prime before 101 is 97"},
+        {.name = "next prime cores without input", .argc = 6, .argv = {"izprime", "next_prime", "--n", "10^2+1", "--cores", "2"}, .expected_exit = EXIT_FAILURE, .stderr_contains = "--cores only applies to --input"},
+        {.name = "next batch input", .argc = 6, .argv = {"izprime", "next", "--input", bases_file, "--cores", "2"}, .expected_exit = EXIT_SUCCESS, .stdout_contains = "103\n1009\n", .stderr_contains = "for 2 bases"},
+        {.name = "prev batch input", .argc = 4, .argv = {"izprime", "prev", "--input", bases_file}, .expected_exit = EXIT_SUCCESS, .stdout_contains = "97\n997\n"},
+        {.name = "next batch missing file", .argc = 4, .argv = {"izprime", "next", "--input", DIR_output "/does_not_exist.txt"}, .expected_exit = EXIT_FAILURE, .stderr_contains = "Failed to open input file"},
+        {.name = "next n and input", .argc = 6, .argv = {"izprime", "next", "--n", "7", "--input", bases_file}, .expected_exit = EXIT_FAILURE, .stderr_contains = "Use either --n VALUE or --input FILE"},
         {.name = "prev alias", .argc = 4, .argv = {"izprime", "prev", "--n", "10^2+1"}, .expected_exit = EXIT_SUCCESS, .stdout_contains = "Previous prime before 101 is 97"},
 
         {.name = "is prime yes", .argc = 6, .argv = {"izprime", "is_prime", "--n", "97", "--rounds", "5"}, .expected_exit = EXIT_SUCCESS, .stdout_contains = "97 is prime"},
         {.name = "is prime no", .argc = 6, .argv = {"izprime", "is_prime", "--n", "99", "--rounds", "5"}, .expected_exit = EXIT_SUCCESS, .stdout_contains = "99 is composite"},
+        {.name = "is prime bpsw", .argc = 6, .argv = {"izprime", "is_prime", "--n", "2^127-1", "--primality", "bpsw"}, .expected_exit = EXIT_SUCCESS, .stdout_contains = "is prime (probably prime)"},
         {.name = "is prime invalid rounds", .argc = 6, .argv = {"izprime", "is_prime", "--n", "97", "--rounds", "0"}, .expected_exit = EXIT_FAILURE, .stderr_contains = "Invalid --rounds value"},
 
         {.name = "gcd named args", .argc = 6, .argv = {"izprime", "gcd", "--a", "48", "--b", "18"}, .expected_exit = EXIT_SUCCESS, .stdout_contains = "6"},
@@ -135,6 +135,60 @@ int TEST_FFI(int verbose)
             print_test_module_result(0, current_test_idx, "izp_ffi_stream_range", "status=%d count=%" PRIu64 " err=%s", status, stream_count, izp_ffi_last_error());
     }
 
+    current_test_idx++;
+    IZP_STR_BUFFER batch = {0};
+    double batch_rate = 0.0;
+    status = izp_ffi_random_primes(128, 6, 2, &batch, &batch_rate);
+    int batch_ok = status == IZP_FFI_OK && batch.len == 6 && batch.data && batch_rate > 0.0;
+    IZP_STR_BUFFER too_small = {0};
+    batch_ok = batch_ok && izp_ffi_random_primes(16, 2, 1, &too_small, NULL) == IZP_FFI_ERR_INVALID_ARG && too_small.len == 0;
+    for (size_t i = 0; batch_ok && i < batch.len; i++)
+    {
+        mpz_t q;
+        batch_ok = batch.data[i] && mpz_init_set_str(q, batch.data[i], 10) == 0;
+        batch_ok = batch_ok && mpz_probab_prime_p(q, 30) > 0;
+        mpz_clear(q);
+    }
+    if (batch_ok)
+    {
+        passed_tests++;
+        if (verbose)
+            print_test_module_result(1, current_test_idx, "izp_ffi_random_primes", "count=%zu rate=%.1f primes/s", batch.len, batch_rate);
+    }
+    else
+    {
+        failed_tests++;
+        if (verbose)
+            print_test_module_result(0, current_test_idx, "izp_ffi_random_primes", "status=%d len=%zu err=%s", status, batch.len, izp_ffi_last_error());
+    }
+    izp_ffi_free_str_buffer(&batch);
+
+    current_test_idx++;
+    const char *next_bases[] = {"10^2+1", "2^64", "10^60 + 7"};
+    IZP_STR_BUFFER next_batch = {0};
+    status = izp_ffi_next_prime_batch(next_bases, 3, 0, 2, &next_batch);
+    int next_ok = status == IZP_FFI_OK && next_batch.len == 3 && next_batch.data;
+    for (size_t i = 0; next_ok && i < next_batch.len; i++)
+    {
+        char *single = NULL;
+        next_ok = izp_ffi_next_prime(next_bases[i], 0, &single) == IZP_FFI_OK &&
+                  next_batch.data[i] && strcmp(single, next_batch.data[i]) == 0;
+        izp_ffi_free_string(&single);
+    }
+    if (next_ok)
+    {
+        passed_tests++;
+        if (verbose)
+            print_test_module_result(1, current_test_idx, "izp_ffi_next_prime_batch", "count=%zu first=%s", next_batch.len, next_batch.data[0]);
+    }
+    else
+    {
+        failed_tests++;
+        if (verbose)
+            print_test_module_result(0, current_test_idx, "izp_ffi_next_prime_batch", "status=%d len=%zu err=%s", status, next_batch.len, izp_ffi_last_error());
+    }
+    izp_ffi_free_str_buffer(&next_batch);
+
     print_test_summary(module_name, passed_tests, failed_tests, verbose);
     return (failed_tests == 0) ? 1 : 0;
 }
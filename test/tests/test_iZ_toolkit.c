@@ -195,6 +195,433 @@ int TEST_IZM(int verbose)
         }
     }
 
+    // * Test 7: vx_buckets_sieve
+    current_test_idx++;
+    current_test_result = 1; // reset
+    {
+        // bucket-sieve primes in (vx, 2000] over consecutive segments and compare
+        // with a direct walk of each prime's global hits
+        int b_vx = VX2;
+        int b_segments = 400;
+        UI64_ARRAY *b_primes = SiZ(2000);
+        VX_BUCKETS *buckets = vx_buckets_init(b_vx, 2000);
+        BITMAP *b_x5 = bitmap_init(b_vx + 8, 1);
+        BITMAP *b_x7 = bitmap_init(b_vx + 8, 1);
+        BITMAP *ref_x5 = bitmap_init(b_vx + 8, 1);
+        BITMAP *ref_x7 = bitmap_init(b_vx + 8, 1);
+
+        if (!b_primes || !buckets || !b_x5 || !b_x7 || !ref_x5 || !ref_x7)
+        {
+            current_test_result = 0;
+        }
+        else
+        {
+            int next_idx = 0;
+            while (b_primes->array[next_idx] <= (uint64_t)b_vx)
+                next_idx++;
+
+            for (int y = 1; y <= b_segments && current_test_result; y++)
+            {
+                uint64_t yvx = (uint64_t)y * b_vx;
+
+                // park each prime once its first hit (near p^2) reaches the current segment
+                while (next_idx < b_primes->count)
+                {
+                    uint64_t p = b_primes->array[next_idx];
+                    uint64_t x5_hit = iZm_solve_for_x0(-1, p, b_vx, 0);
+                    uint64_t x7_hit = iZm_solve_for_x0(1, p, b_vx, 0);
+                    if (MIN(x5_hit, x7_hit) > yvx + b_vx)
+                        break;
+                    vx_buckets_add(buckets, p, x5_hit - yvx, x7_hit - yvx);
+                    next_idx++;
+                }
+
+                bitmap_set_all(b_x5);
+                bitmap_set_all(b_x7);
+                bitmap_set_all(ref_x5);
+                bitmap_set_all(ref_x7);
+                vx_buckets_sieve(buckets, b_x5, b_x7, b_vx);
+
+                for (int i = 0; i < b_primes->count; i++)
+                {
+                    uint64_t p = b_primes->array[i];
+                    if (p <= (uint64_t)b_vx)
+                        continue;
+                    for (uint64_t X = iZm_solve_for_x0(-1, p, b_vx, 0); X <= yvx + b_vx; X += p)
+                        if (X > yvx)
+                            bitmap_clear_bit(ref_x5, X - yvx);
+                    for (uint64_t X = iZm_solve_for_x0(1, p, b_vx, 0); X <= yvx + b_vx; X += p)
+                        if (X > yvx)
+                            bitmap_clear_bit(ref_x7, X - yvx);
+                }
+
+                if (memcmp(b_x5->data, ref_x5->data, b_x5->byte_size) != 0 ||
+                    memcmp(b_x7->data, ref_x7->data, b_x7->byte_size) != 0)
+                {
+                    current_test_result = 0;
+                    if (verbose)
+                    {
+                        print_test_module_result(0, current_test_idx, "vx_buckets_sieve", "Bucket hits differ from reference at y=%d", y);
+                    }
+                }
+            }
+        }
+
+        ui64_free(&b_primes);
+        vx_buckets_free(&buckets);
+        bitmap_free(&b_x5);
+        bitmap_free(&b_x7);
+        bitmap_free(&ref_x5);
+        bitmap_free(&ref_x7);
+    }
+    if (current_test_result)
+    {
+        passed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(1, current_test_idx, "vx_buckets_sieve", "Bucket sieve matches direct marking over consecutive segments");
+        }
+    }
+    else
+    {
+        failed_tests++;
+    }
+
+    // * Test 8: vx_state_sync, vx_state_advance
+    current_test_idx++;
+    current_test_result = 1; // reset
+    {
+        // batched residues and carried offsets must match the per-prime mpz solver
+        IZM *s_iZm = iZm_init(VX4);
+        VX_SIEVE_STATE *s_state = s_iZm ? vx_state_init(s_iZm) : NULL;
+        mpz_t s_y;
+        mpz_init_set_str(s_y, "123456789012345678901234567890123456789012345678901234567890", 10);
+
+        if (!s_state)
+        {
+            current_test_result = 0;
+        }
+        else
+        {
+            for (int step = 0; step < 3 && current_test_result; step++)
+            {
+                if (step == 0)
+                    vx_state_sync(s_state, s_y);
+                else
+                    vx_state_advance(s_state);
+
+                for (int i = 0; i < s_state->count; i++)
+                {
+                    uint64_t p = s_state->primes[i];
+                    if (s_state->x5_next[i] != iZm_solve_for_x0_mpz(-1, p, VX4, s_y) ||
+                        s_state->x7_next[i] != iZm_solve_for_x0_mpz(1, p, VX4, s_y))
+                    {
+                        current_test_result = 0;
+                        break;
+                    }
+                }
+                mpz_add_ui(s_y, s_y, 1);
+            }
+        }
+
+        mpz_clear(s_y);
+        vx_state_free(&s_state);
+        iZm_free(&s_iZm);
+    }
+    if (current_test_result)
+    {
+        passed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(1, current_test_idx, "vx_state_sync", "Batched offsets match the mpz solver across segments");
+        }
+    }
+    else
+    {
+        failed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(0, current_test_idx, "vx_state_sync", "Batched offsets differ from the mpz solver");
+        }
+    }
+
+    // * Test 9: test_bpsw
+    current_test_idx++;
+    current_test_result = 1; // reset
+    {
+        mpz_t n;
+        mpz_init(n);
+
+        // agree with GMP on every n < 10^5 (covers the small strong base-2 pseudoprimes 2047, 3277, ...)
+        for (unsigned long v = 0; v < 100000 && current_test_result; v++)
+        {
+            mpz_set_ui(n, v);
+            current_test_result = (test_bpsw(n) > 0) == (mpz_probab_prime_p(n, MR_ROUNDS) > 0);
+        }
+
+        // large cases: Mersenne primes, their neighbours, and a strong pseudoprime to bases 2..23
+        const char *primes[] = {"2305843009213693951", "170141183460469231731687303715884105727"};
+        const char *composites[] = {"3825123056546413051", "170141183460469231731687303715884105729",
+                                    "318665857834031151167461"};
+        for (int i = 0; i < 2 && current_test_result; i++)
+        {
+            mpz_set_str(n, primes[i], 10);
+            current_test_result = test_bpsw(n) == 1 && test_primality_with(n, 0, IZ_PRIMALITY_BPSW) > 0;
+        }
+        for (int i = 0; i < 3 && current_test_result; i++)
+        {
+            mpz_set_str(n, composites[i], 10);
+            current_test_result = test_bpsw(n) == 0 && test_primality_with(n, 0, IZ_PRIMALITY_BPSW) == 0;
+        }
+
+        // the Miller-Rabin backend is GMP's test with the requested rounds at every size
+        for (int i = 0; i < 2 && current_test_result; i++)
+        {
+            mpz_set_str(n, primes[i], 10);
+            current_test_result = test_primality_with(n, 5, IZ_PRIMALITY_MR) == mpz_probab_prime_p(n, 5);
+        }
+        for (int i = 0; i < 3 && current_test_result; i++)
+        {
+            mpz_set_str(n, composites[i], 10);
+            current_test_result = test_primality_with(n, 5, IZ_PRIMALITY_MR) == 0;
+        }
+
+        mpz_clear(n);
+    }
+    if (current_test_result)
+    {
+        passed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(1, current_test_idx, "test_bpsw", "BPSW agrees with GMP and rejects strong pseudoprimes");
+        }
+    }
+    else
+    {
+        failed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(0, current_test_idx, "test_bpsw", "BPSW result mismatch");
+        }
+    }
+
+    // * Test 10: test_primality_u64
+    current_test_idx++;
+    current_test_result = 1; // reset
+    {
+        mpz_t n;
+        mpz_init(n);
+        gmp_randstate_t state;
+        gmp_randinit_default(state);
+        gmp_randseed_ui(state, 64);
+
+        // agree with GMP on every n < 10^5 and on random values of every size up to 64 bits
+        for (uint64_t v = 0; v < 100000 && current_test_result; v++)
+        {
+            mpz_set_ui(n, v);
+            current_test_result = test_primality_u64(v) == (mpz_probab_prime_p(n, MR_ROUNDS) > 0);
+        }
+        for (int i = 0; i < 20000 && current_test_result; i++)
+        {
+            mpz_urandomb(n, state, 2 + i % 63);
+            mpz_setbit(n, 0);
+            current_test_result = test_primality_u64(mpz_get_ui(n)) == (mpz_probab_prime_p(n, MR_ROUNDS) > 0);
+        }
+
+        // strong pseudoprimes to the first few prime bases, and the ends of the 64-bit range
+        const uint64_t composites[] = {3215031751ULL, 3474749660383ULL, 341550071728321ULL,
+                                       3825123056546413051ULL, UINT64_MAX};
+        for (int i = 0; i < 5 && current_test_result; i++)
+            current_test_result = !test_primality_u64(composites[i]);
+        current_test_result = current_test_result && test_primality_u64(18446744073709551557ULL) &&
+                              test_primality_u64(2305843009213693951ULL);
+
+        gmp_randclear(state);
+        mpz_clear(n);
+    }
+    if (current_test_result)
+    {
+        passed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(1, current_test_idx, "test_primality_u64", "Deterministic 64-bit test agrees with GMP");
+        }
+    }
+    else
+    {
+        failed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(0, current_test_idx, "test_primality_u64", "64-bit test result mismatch");
+        }
+    }
+
+    // * Test 11: test_primality_u128
+    current_test_idx++;
+    current_test_result = 1; // reset
+    {
+        mpz_t n, q;
+        mpz_inits(n, q, NULL);
+        gmp_randstate_t state;
+        gmp_randinit_default(state);
+        gmp_randseed_ui(state, 128);
+
+        // agree with GMP on random two-word values, their next primes and prime squares
+        for (int i = 0; i < 6000 && current_test_result; i++)
+        {
+            int bits = 65 + i % 63;
+            mpz_urandomb(n, state, bits);
+            mpz_setbit(n, 64);
+            if (i % 3 == 1)
+                mpz_nextprime(n, n);
+            if (i % 3 == 2)
+            {
+                mpz_urandomb(q, state, bits / 2);
+                mpz_setbit(q, 32);
+                mpz_nextprime(q, q);
+                mpz_mul(n, q, q);
+            }
+
+            uint64_t w[2] = {0, 0};
+            mpz_export(w, NULL, -1, sizeof(uint64_t), 0, 0, n);
+            current_test_result = test_primality_u128(w[1], w[0]) == (mpz_probab_prime_p(n, MR_ROUNDS) > 0);
+        }
+
+        // largest prime below 2^128 is 2^128 - 159; 2^128 - 1 is composite
+        current_test_result = current_test_result && test_primality_u128(UINT64_MAX, UINT64_MAX - 158) &&
+                              !test_primality_u128(UINT64_MAX, UINT64_MAX) && test_primality_u128(0, 2305843009213693951ULL);
+
+        gmp_randclear(state);
+        mpz_clears(n, q, NULL);
+    }
+    if (current_test_result)
+    {
+        passed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(1, current_test_idx, "test_primality_u128", "128-bit BPSW agrees with GMP");
+        }
+    }
+    else
+    {
+        failed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(0, current_test_idx, "test_primality_u128", "128-bit test result mismatch");
+        }
+    }
+
+    // * Test 12: test_primality_u64_batch
+    current_test_idx++;
+    current_test_result = 1; // reset
+    {
+        // mixed sizes in one batch (both sides of 2^32 and 2^52), plus strong pseudoprimes
+        enum { BATCH = 3000 };
+        uint64_t *values = malloc(BATCH * sizeof(uint64_t));
+        uint8_t *flags = malloc(BATCH);
+        const uint64_t pseudoprimes[] = {2047ULL, 3215031751ULL, 4759123141ULL, 2152302898747ULL, 3474749660383ULL,
+                                         341550071728321ULL, 3825123056546413051ULL, 18446744073709551557ULL};
+        uint8_t *expected_flags = malloc(BATCH);
+        uint64_t lcg = 0x9E3779B97F4A7C15ULL;
+        int expected = 0;
+        mpz_t z;
+        mpz_init(z);
+        for (int i = 0; i < BATCH; i++)
+        {
+            lcg = lcg * 6364136223846793005ULL + 1442695040888963407ULL;
+            values[i] = i < 8 ? pseudoprimes[i] : (lcg >> (i % 40)) | 1;
+            mpz_set_ui(z, values[i]);
+            expected_flags[i] = mpz_probab_prime_p(z, 25) > 0;
+            expected += expected_flags[i];
+        }
+        mpz_clear(z);
+
+        // both lane paths against GMP: CPU-selected lanes (IFMA where available), then forced scalar lanes
+        for (int force_scalar = 0; force_scalar <= 1 && current_test_result; force_scalar++)
+        {
+            test_primality_u64_batch_force_scalar(force_scalar);
+            int primes = test_primality_u64_batch(values, BATCH, flags);
+            current_test_result = primes == expected && memcmp(flags, expected_flags, BATCH) == 0;
+        }
+        test_primality_u64_batch_force_scalar(0);
+
+        free(values);
+        free(flags);
+        free(expected_flags);
+    }
+    if (current_test_result)
+    {
+        passed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(1, current_test_idx, "test_primality_u64_batch", "IFMA and scalar lanes agree with GMP");
+        }
+    }
+    else
+    {
+        failed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(0, current_test_idx, "test_primality_u64_batch", "Batched result mismatch");
+        }
+    }
+
+    // * Test 13: iZm_roots_solve_for_x0, iZm_roots_solve_for_y0, iZm_roots_mod
+    current_test_idx++;
+    current_test_result = 1; // reset
+    {
+        // table-driven solvers (and a cloned table) must match the direct solvers
+        IZM *r_iZm = iZm_init(VX4);
+        IZM *r_clone = r_iZm ? iZm_clone(r_iZm) : NULL;
+        uint64_t r_ys[] = {1, 2, 999, 123456789, 1ULL << 40};
+        uint64_t r_as[] = {0, 1, 12345, UINT32_MAX, 1ULL << 63, UINT64_MAX};
+
+        if (!r_clone || !r_clone->roots || r_clone->roots->count != r_iZm->root_primes->count)
+        {
+            current_test_result = 0;
+        }
+        else
+        {
+            const IZM_ROOTS *roots = r_clone->roots;
+            for (int i = 2; i < roots->count && current_test_result; i++)
+            {
+                uint64_t p = r_iZm->root_primes->array[i];
+                for (int m = -1; m <= 1; m += 2)
+                {
+                    for (int j = 0; j < (int)(sizeof(r_ys) / sizeof(r_ys[0])); j++)
+                        if (iZm_roots_solve_for_x0(roots, i, m, r_ys[j]) != iZm_solve_for_x0(m, p, VX4, r_ys[j]))
+                            current_test_result = 0;
+
+                    for (uint64_t x = 1; x <= VX4; x += 997)
+                        if (iZm_roots_solve_for_y0(roots, i, m, x) != iZm_solve_for_y0(m, p, VX4, x))
+                            current_test_result = 0;
+                }
+                for (int j = 0; j < (int)(sizeof(r_as) / sizeof(r_as[0])); j++)
+                    if (iZm_roots_mod(roots, i, r_as[j]) != r_as[j] % p)
+                        current_test_result = 0;
+            }
+        }
+
+        iZm_free(&r_clone);
+        iZm_free(&r_iZm);
+    }
+    if (current_test_result)
+    {
+        passed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(1, current_test_idx, "iZm_roots_solve", "Root prime table matches the direct solvers");
+        }
+    }
+    else
+    {
+        failed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(0, current_test_idx, "iZm_roots_solve", "Root prime table differs from the direct solvers");
+        }
+    }
+
     print_test_summary(module_name, passed_tests, failed_tests, verbose);
 
     return (failed_tests == 0) ? 1 : 0;
@@ -429,6 +856,248 @@ int TEST_VX_SEG(int verbose)
         }
     }
 
+    // * Test vx_init_with_state
+    current_test_idx++;
+    current_test_result = 1;
+    VX_SIEVE_STATE *state = vx_state_init(iZm);
+    if (!state)
+    {
+        current_test_result = 0;
+    }
+    else
+    {
+        // consecutive runs (carried offsets) from small, u64 and mpz-sized y, then a jump back (re-solve)
+        const char *run_starts[] = {"1", "1000000000", "100000000000000000000000000", "7"};
+        mpz_t y;
+        mpz_init(y);
+
+        for (int r = 0; r < 4 && current_test_result; r++)
+        {
+            mpz_set_str(y, run_starts[r], 10);
+            for (int i = 0; i < 4 && current_test_result; i++)
+            {
+                char *y_str = mpz_get_str(NULL, 10, y);
+                VX_SEG *direct = vx_init(iZm, 1, vx, y_str, 5);
+                VX_SEG *carried = vx_init_with_state(iZm, state, 1, vx, y_str, 5);
+                free(y_str);
+
+                current_test_result = direct && carried &&
+                                      memcmp(direct->x5->data, carried->x5->data, direct->x5->byte_size) == 0 &&
+                                      memcmp(direct->x7->data, carried->x7->data, direct->x7->byte_size) == 0;
+
+                vx_free(&direct);
+                vx_free(&carried);
+                mpz_add_ui(y, y, 1);
+            }
+        }
+
+        // a clone continues from the same offsets as its source
+        VX_SIEVE_STATE *clone = current_test_result ? vx_state_clone(state) : NULL;
+        current_test_result = current_test_result && clone;
+        for (int i = 0; i < 2 && current_test_result; i++)
+        {
+            char *y_str = mpz_get_str(NULL, 10, y);
+            VX_SEG *carried = vx_init_with_state(iZm, state, 1, vx, y_str, 5);
+            VX_SEG *cloned = vx_init_with_state(iZm, clone, 1, vx, y_str, 5);
+            free(y_str);
+
+            current_test_result = carried && cloned &&
+                                  memcmp(carried->x5->data, cloned->x5->data, carried->x5->byte_size) == 0 &&
+                                  memcmp(carried->x7->data, cloned->x7->data, carried->x7->byte_size) == 0;
+
+            vx_free(&carried);
+            vx_free(&cloned);
+            mpz_add_ui(y, y, 1);
+        }
+
+        mpz_clear(y);
+        vx_state_free(&clone);
+        vx_state_free(&state);
+    }
+
+    if (current_test_result)
+    {
+        passed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(1, current_test_idx, "vx_init_with_state, vx_state_clone", "Carried offsets match direct solving across segments");
+        }
+    }
+    else
+    {
+        failed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(0, current_test_idx, "vx_init_with_state, vx_state_clone", "Carried offsets differ from direct solving");
+        }
+    }
+
+    // * Test vx_create, vx_reset
+    current_test_idx++;
+    VX_SEG *long_lived = vx_create(iZm, 5);
+    current_test_result = long_lived != NULL;
+    if (current_test_result)
+    {
+        // consecutive steps, a jump forward, a jump back to y = 0, and partial x ranges
+        const char *ys[] = {"1", "2", "3", "5000000000000000000000", "5000000000000000000001", "0", "1", "2"};
+        mpz_t y;
+        mpz_init(y);
+
+        for (int i = 0; i < 8 && current_test_result; i++)
+        {
+            int sx = (i % 3 == 0) ? 1000 : 1;
+            int ex = (i % 4 == 1) ? vx - 777 : vx;
+            mpz_set_str(y, ys[i], 10);
+
+            VX_SEG *direct = vx_init(iZm, sx, ex, (char *)ys[i], 5);
+            current_test_result = direct && vx_reset(long_lived, y, sx, ex) &&
+                                  mpz_cmp(direct->yvx, long_lived->yvx) == 0 &&
+                                  mpz_cmp(direct->root_limit, long_lived->root_limit) == 0 &&
+                                  direct->p_count == long_lived->p_count &&
+                                  memcmp(direct->x5->data, long_lived->x5->data, direct->x5->byte_size) == 0 &&
+                                  memcmp(direct->x7->data, long_lived->x7->data, direct->x7->byte_size) == 0;
+            vx_free(&direct);
+        }
+
+        mpz_clear(y);
+        vx_free(&long_lived);
+    }
+
+    if (current_test_result)
+    {
+        passed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(1, current_test_idx, "vx_create, vx_reset", "Reused segment matches fresh vx_init segments");
+        }
+    }
+    else
+    {
+        failed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(0, current_test_idx, "vx_create, vx_reset", "Reused segment differs from fresh vx_init segments");
+        }
+    }
+
+    // * Test vx_set_sieve_depth, iZ_auto_sieve_depth
+    current_test_idx++;
+    IZM *iZm_small = iZm_init(VX4);
+    VX_SEG *shallow = iZm_small ? vx_create(iZm_small, 5) : NULL;
+    VX_SEG *deep = iZm_small ? vx_create(iZm_small, 5) : NULL;
+    VX_SEG *adopted = iZm_small ? vx_create(iZm_small, 5) : NULL;
+    VX_SIEVE_STATE *prepared = iZm_small ? vx_state_init_depth(iZm_small, 1ULL << 17) : NULL;
+    current_test_result = shallow && deep && vx_set_sieve_depth(deep, 1ULL << 17) && deep->sieve_depth == (1ULL << 17);
+    current_test_result = current_test_result && adopted && vx_set_sieve_state(adopted, prepared) && adopted->sieve_depth == (1ULL << 17);
+    if (current_test_result)
+    {
+        // consecutive multi-word segments (probabilistic phase), then a segment with root limit < depth
+        const char *ys[] = {"100000000000000000000", "100000000000000000001", "100000000000000000002", "5000", "5001"};
+        mpz_t y;
+        mpz_init(y);
+
+        for (int i = 0; i < 5 && current_test_result; i++)
+        {
+            int ex = (i == 1) ? VX4 - 333 : VX4;
+            mpz_set_str(y, ys[i], 10);
+            current_test_result = vx_reset(shallow, y, 1, ex) && vx_reset(deep, y, 1, ex);
+
+            // deep survivors must be a subset of the shallow ones, and the extra primes must remove some
+            size_t removed = 0;
+            for (size_t b = 0; current_test_result && b < deep->x5->byte_size; b++)
+            {
+                current_test_result = (deep->x5->data[b] & ~shallow->x5->data[b]) == 0 &&
+                                      (deep->x7->data[b] & ~shallow->x7->data[b]) == 0;
+                removed += deep->x5->data[b] != shallow->x5->data[b];
+            }
+            current_test_result = current_test_result && (i >= 3 ? !deep->is_large_limit : removed > 0);
+
+            // an adopted state sieves exactly like one set by depth
+            current_test_result = current_test_result && vx_reset(adopted, y, 1, ex) &&
+                                  memcmp(deep->x5->data, adopted->x5->data, deep->x5->byte_size) == 0 &&
+                                  memcmp(deep->x7->data, adopted->x7->data, deep->x7->byte_size) == 0;
+
+            vx_full_sieve(shallow, 0);
+            vx_full_sieve(deep, 0);
+            current_test_result = current_test_result && deep->p_count == shallow->p_count &&
+                                  memcmp(deep->x5->data, shallow->x5->data, deep->x5->byte_size) == 0 &&
+                                  memcmp(deep->x7->data, shallow->x7->data, deep->x7->byte_size) == 0;
+        }
+
+        mpz_clear(y);
+    }
+    current_test_result = current_test_result &&
+                          iZ_auto_sieve_depth(VX6, 40, 0) == VX6 &&
+                          iZ_auto_sieve_depth(VX6, 50, 100 * VX6) <= (1ULL << 25) &&
+                          iZ_auto_sieve_depth(VX6, 333, 100 * VX6) > VX6 &&
+                          iZ_auto_sieve_depth(VX6, 333, 100 * VX6) <= IZ_SIEVE_DEPTH_AUTO_MAX;
+    if (adopted && adopted->state != prepared)
+        vx_state_free(&prepared); // not adopted
+    vx_free(&shallow);
+    vx_free(&deep);
+    vx_free(&adopted);
+    iZm_free(&iZm_small);
+
+    if (current_test_result)
+    {
+        passed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(1, current_test_idx, "vx_set_sieve_depth, vx_set_sieve_state", "Deeper sieving removes candidates without changing results");
+        }
+    }
+    else
+    {
+        failed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(0, current_test_idx, "vx_set_sieve_depth, vx_set_sieve_state", "Deeper sieving changed results or removed nothing");
+        }
+    }
+
+    // * Test vx_search_ctx_init, vx_search_prime_ctx
+    current_test_idx++;
+    VX_SEARCH_CTX *search = vx_search_ctx_init(VX4);
+    current_test_result = search != NULL;
+    if (current_test_result)
+    {
+        // several searches on one context, on both lines and across bit sizes
+        int search_bits[] = {10, 64, 65, 128, 256, 512};
+        mpz_t p;
+        mpz_init(p);
+
+        for (int i = 0; i < 12 && current_test_result; i++)
+        {
+            int m_id = (i % 2) ? 1 : -1;
+            int bits = search_bits[i % 6];
+            current_test_result = vx_search_prime_ctx(search, p, m_id, bits) &&
+                                  mpz_probab_prime_p(p, MR_ROUNDS) &&
+                                  mpz_fdiv_ui(p, 6) == (unsigned long)(m_id == -1 ? 5 : 1) &&
+                                  mpz_sizeinbase(p, 2) <= (size_t)MAX(bits, 20) + 1;
+        }
+
+        mpz_clear(p);
+    }
+    vx_search_ctx_free(&search);
+    current_test_result = current_test_result && search == NULL;
+
+    if (current_test_result)
+    {
+        passed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(1, current_test_idx, "vx_search_prime_ctx", "Reused search context yields primes on the requested line");
+        }
+    }
+    else
+    {
+        failed_tests++;
+        if (verbose)
+        {
+            print_test_module_result(0, current_test_idx, "vx_search_prime_ctx", "Reused search context failed to yield valid primes");
+        }
+    }
+
     iZm_free(&iZm);
 
     // * Print test summary
@@ -76,7 +76,7 @@ int gmp_random_next_prime(mpz_t p, int bit_size)
 int TEST_iZ_next_prime(int verbose)
 {
     print_test_fn_header("iZ_next_prime");
-    printf("Comparing iZ_next_prime results with GMP's mpz_nextprime for the same base of various bit sizes...\n");
+    printf("Comparing iZ_next_prime results with GMP references for the same base of various bit sizes, in both directions...\n");
 
     int failed_tests = 0;
 
@@ -137,11 +137,60 @@ int TEST_iZ_next_prime(int verbose)
             }
         }
 
+        // previous prime: iZ_next_prime backward against stepping down odd values with GMP
+        mpz_sub_ui(gmp_prime, base, 1);
+        if (mpz_even_p(gmp_prime))
+            mpz_sub_ui(gmp_prime, gmp_prime, 1);
+        while (!mpz_probab_prime_p(gmp_prime, MR_ROUNDS))
+            mpz_sub_ui(gmp_prime, gmp_prime, 2);
+
+        if (iZ_next_prime(iz_prime, base, 0) && mpz_cmp(iz_prime, gmp_prime) == 0)
+        {
+            if (verbose)
+                printf("[%d] Test Passed for bit size %d (previous prime)\n", i, bit_size);
+        }
+        else
+        {
+            failed_tests++;
+            if (verbose)
+            {
+                printf("[%d] Test Failed for bit size %d (previous prime)\n", i, bit_size);
+                gmp_printf("Base: %Zd\niZ_next_prime: %Zd\nGMP reference: %Zd\n", base, iz_prime, gmp_prime);
+            }
+        }
+
         // cleanup
         mpz_clears(base, iz_prime, gmp_prime, NULL);
         gmp_randclear(state);
     }
 
+    // Consecutive 64-bit bases (every residue mod 6, both directions) and one multi-word run
+    const char *runs[] = {"2000000", "1000000000000000000", "18446744073709551000", "1000000000000000000000000000000"};
+    for (int i = 0; i < 4; i++)
+    {
+        mpz_t base, iz_prime, ref_prime;
+        mpz_inits(base, iz_prime, ref_prime, NULL);
+        mpz_set_str(base, runs[i], 10);
+
+        int run_failed = 0;
+        for (int j = 0; j < 120; j++, mpz_add_ui(base, base, 1))
+        {
+            mpz_nextprime(ref_prime, base);
+            run_failed += !iZ_next_prime(iz_prime, base, 1) || mpz_cmp(iz_prime, ref_prime) != 0;
+
+            mpz_sub_ui(ref_prime, base, 1);
+            while (!mpz_probab_prime_p(ref_prime, MR_ROUNDS))
+                mpz_sub_ui(ref_prime, ref_prime, 1);
+            run_failed += !iZ_next_prime(iz_prime, base, 0) || mpz_cmp(iz_prime, ref_prime) != 0;
+        }
+
+        failed_tests += run_failed > 0;
+        if (verbose)
+            printf("[%d] Consecutive bases from %s: %s\n", num_tests + i + 1, runs[i], run_failed ? "Test Failed" : "Test Passed");
+
+        mpz_clears(base, iz_prime, ref_prime, NULL);
+    }
+
     printf("\n\n");
     print_line(60, '*');
     if (failed_tests == 0 && verbose)
@@ -169,26 +218,27 @@ int TEST_vy_random_prime(int verbose)
     printf("Testing vy_random_prime for various bit sizes and checking primality of results...\n");
 
     int failed_tests = 0;
-    int bit_size[] = {512, 1024, 2048, 4096};
-    int test_rounds = 4;
+    int bit_size[] = {512, 1024, 2048, 4096, 512, 1024};
+    int cores[] = {1, 1, 1, 1, 4, 4}; // the last rounds race worker threads
+    int test_rounds = 6;
 
     for (int i = 1; i <= test_rounds; i++)
     {
         mpz_t p;
         mpz_init(p);
-        int iz_found = vy_random_prime(p, bit_size[i - 1], 1);
+        int iz_found = vy_random_prime(p, bit_size[i - 1], cores[i - 1]);
         int iz_is_prime = mpz_probab_prime_p(p, MR_ROUNDS);
         if (iz_found && iz_is_prime)
         {
             if (verbose)
-                printf("[%d] vy_random_prime: Test Passed for bit size %d\n", i, bit_size[i - 1]);
+                printf("[%d] vy_random_prime: Test Passed for bit size %d (%d cores)\n", i, bit_size[i - 1], cores[i - 1]);
         }
         else
         {
             failed_tests++;
             if (verbose)
             {
-                printf("[%d] vy_random_prime: Test Failed for bit size %d\n", i, bit_size[i - 1]);
+                printf("[%d] vy_random_prime: Test Failed for bit size %d (%d cores)\n", i, bit_size[i - 1], cores[i - 1]);
                 printf("Generated p: %s\n", mpz_get_str(NULL, 10, p));
             }
         }
@@ -215,26 +265,27 @@ int TEST_vx_random_prime(int verbose)
     printf("Testing vx_random_prime for various bit sizes and checking primality of results...\n");
 
     int failed_tests = 0;
-    int bit_size[] = {512, 1024, 2048, 4096};
-    int test_rounds = 4;
+    int bit_size[] = {512, 1024, 2048, 4096, 512, 1024};
+    int cores[] = {1, 1, 1, 1, 4, 4}; // the last rounds race worker threads
+    int test_rounds = 6;
 
     for (int i = 1; i <= test_rounds; i++)
     {
         mpz_t p;
         mpz_init(p);
-        int iz_found = vx_random_prime(p, bit_size[i - 1], 1);
+        int iz_found = vx_random_prime(p, bit_size[i - 1], cores[i - 1]);
         int iz_is_prime = mpz_probab_prime_p(p, MR_ROUNDS);
         if (iz_found && iz_is_prime)
         {
             if (verbose)
-                printf("[%d] vx_random_prime: Test Passed for bit size %d\n", i, bit_size[i - 1]);
+                printf("[%d] vx_random_prime: Test Passed for bit size %d (%d cores)\n", i, bit_size[i - 1], cores[i - 1]);
         }
         else
         {
             failed_tests++;
             if (verbose)
             {
-                printf("[%d] vx_random_prime: Test Failed for bit size %d\n", i, bit_size[i - 1]);
+                printf("[%d] vx_random_prime: Test Failed for bit size %d (%d cores)\n", i, bit_size[i - 1], cores[i - 1]);
                 printf("Generated p: %s\n", mpz_get_str(NULL, 10, p));
             }
         }
@@ -255,6 +306,298 @@ int TEST_vx_random_prime(int verbose)
     return (failed_tests == 0) ? 1 : 0;
 }
 
+// tests for vx_random_prime_constrained: results must be prime and satisfy
+// every constraint, and unsatisfiable specs must be rejected without a search.
+int TEST_vx_random_prime_constrained(int verbose)
+{
+    print_test_fn_header("vx_random_prime_constrained");
+    printf("Testing vx_random_prime_constrained for top bits, residue classes and gcd(p - 1, e) = 1...\n");
+
+    int failed_tests = 0;
+    int bit_size[] = {1024, 512, 256, 512};
+    int cores[] = {1, 1, 1, 4}; // the last round races worker threads
+    IZ_PRIME_CONSTRAINTS specs[] = {
+        {.top_bits = 2, .e = 65537},                            // RSA
+        {.top_bits = 2, .modulus = 4, .residue = 3, .e = 3},    // Blum prime, e = 3
+        {.top_bits = 1, .modulus = 56, .residue = 13, .e = 5 * 17 * 257},
+        {.top_bits = 2, .modulus = 8, .residue = 7, .e = 65537},
+    };
+    int test_rounds = 4;
+
+    for (int i = 1; i <= test_rounds; i++)
+    {
+        IZ_PRIME_CONSTRAINTS *c = &specs[i - 1];
+        mpz_t p, g;
+        mpz_inits(p, g, NULL);
+        int iz_found = vx_random_prime_constrained(p, bit_size[i - 1], c, cores[i - 1]);
+
+        mpz_sub_ui(g, p, 1);
+        mpz_gcd_ui(g, g, c->e);
+        int iz_ok = iz_found && mpz_probab_prime_p(p, MR_ROUNDS) &&
+                    mpz_sizeinbase(p, 2) == (size_t)bit_size[i - 1] &&
+                    mpz_cmp_ui(g, 1) == 0 &&
+                    (c->modulus < 2 || mpz_fdiv_ui(p, c->modulus) == c->residue);
+        for (int b = 1; iz_ok && b <= c->top_bits; b++)
+            iz_ok = mpz_tstbit(p, bit_size[i - 1] - b);
+
+        if (iz_ok)
+        {
+            if (verbose)
+                printf("[%d] vx_random_prime_constrained: Test Passed for bit size %d (%d cores)\n", i, bit_size[i - 1], cores[i - 1]);
+        }
+        else
+        {
+            failed_tests++;
+            if (verbose)
+            {
+                printf("[%d] vx_random_prime_constrained: Test Failed for bit size %d (%d cores)\n", i, bit_size[i - 1], cores[i - 1]);
+                gmp_printf("Generated p: %Zd\n", p);
+            }
+        }
+        mpz_clears(p, g, NULL);
+    }
+
+    // unsatisfiable: even e, residue sharing a factor with the modulus, p = 1 (mod 5) with 5 | e
+    IZ_PRIME_CONSTRAINTS bad[] = {
+        {.e = 4},
+        {.modulus = 6, .residue = 3},
+        {.modulus = 5, .residue = 1, .e = 5},
+    };
+    for (int i = 0; i < 3; i++)
+    {
+        mpz_t p;
+        mpz_init(p);
+        if (vx_random_prime_constrained(p, 256, &bad[i], 1))
+        {
+            failed_tests++;
+            if (verbose)
+                printf("[%d] vx_random_prime_constrained: Test Failed, unsatisfiable spec %d accepted\n", test_rounds + i + 1, i);
+        }
+        else if (verbose)
+        {
+            printf("[%d] vx_random_prime_constrained: Test Passed, unsatisfiable spec %d rejected\n", test_rounds + i + 1, i);
+        }
+        mpz_clear(p);
+    }
+
+    printf("\n\n");
+    print_line(60, '*');
+    if (failed_tests == 0 && verbose)
+    {
+        printf("[SUCCESS] All vx_random_prime_constrained tests passed! ^_^\n");
+    }
+    else if (failed_tests > 0 && verbose)
+    {
+        printf("[FAILURE] %d vx_random_prime_constrained tests failed :\\\n", failed_tests);
+    }
+    print_line(60, '*');
+
+    return (failed_tests == 0) ? 1 : 0;
+}
+
+// tests for vx_random_safe_prime: p and (p - 1) / 2 must both be prime,
+// with p of the requested size, in-process and with racing threads.
+int TEST_vx_random_safe_prime(int verbose)
+{
+    print_test_fn_header("vx_random_safe_prime");
+    printf("Testing vx_random_safe_prime for various bit sizes and checking both p and (p - 1) / 2...\n");
+
+    int failed_tests = 0;
+    int bit_size[] = {64, 256, 512, 256};
+    int cores[] = {1, 1, 1, 4}; // the last round races worker threads
+    int test_rounds = 4;
+
+    for (int i = 1; i <= test_rounds; i++)
+    {
+        mpz_t p, s;
+        mpz_inits(p, s, NULL);
+        int iz_found = vx_random_safe_prime(p, bit_size[i - 1], cores[i - 1]);
+        mpz_sub_ui(s, p, 1);
+        mpz_fdiv_q_2exp(s, s, 1);
+        int iz_is_safe = mpz_probab_prime_p(p, MR_ROUNDS) && mpz_probab_prime_p(s, MR_ROUNDS) &&
+                         mpz_sizeinbase(p, 2) <= (size_t)bit_size[i - 1] + 1;
+        if (iz_found && iz_is_safe)
+        {
+            if (verbose)
+                printf("[%d] vx_random_safe_prime: Test Passed for bit size %d (%d cores)\n", i, bit_size[i - 1], cores[i - 1]);
+        }
+        else
+        {
+            failed_tests++;
+            if (verbose)
+            {
+                printf("[%d] vx_random_safe_prime: Test Failed for bit size %d (%d cores)\n", i, bit_size[i - 1], cores[i - 1]);
+                gmp_printf("Generated p: %Zd\n", p);
+            }
+        }
+        mpz_clears(p, s, NULL);
+    }
+    printf("\n\n");
+    print_line(60, '*');
+    if (failed_tests == 0 && verbose)
+    {
+        printf("[SUCCESS] All vx_random_safe_prime tests passed! ^_^\n");
+    }
+    else if (failed_tests > 0 && verbose)
+    {
+        printf("[FAILURE] %d vx_random_safe_prime tests failed :\\\n", failed_tests);
+    }
+    print_line(60, '*');
+
+    return (failed_tests == 0) ? 1 : 0;
+}
+
+// tests for iZ_random_primes: every slot of the batch must hold a prime of
+// the requested size, for the in-thread and threaded paths.
+int TEST_iZ_random_primes(int verbose)
+{
+    print_test_fn_header("iZ_random_primes");
+    printf("Testing iZ_random_primes batches and checking primality and size of every result...\n");
+
+    int failed_tests = 0;
+    int bit_size[] = {256, 1024, 512, IZ_RANDOM_PRIMES_MIN_BITS};
+    int threads[] = {1, 4, 3, 1000}; // oversized requests are capped at the batch size
+    int batch_size = 8;
+    int test_rounds = 4;
+
+    mpz_t batch[batch_size];
+    for (int j = 0; j < batch_size; j++)
+        mpz_init(batch[j]);
+
+    for (int i = 1; i <= test_rounds; i++)
+    {
+        double rate = 0.0;
+        int found = iZ_random_primes(batch, batch_size, bit_size[i - 1], threads[i - 1], &rate);
+
+        int all_ok = found == batch_size && rate > 0.0;
+        for (int j = 0; all_ok && j < batch_size; j++)
+            all_ok = mpz_probab_prime_p(batch[j], MR_ROUNDS) &&
+                     mpz_sizeinbase(batch[j], 2) <= (size_t)bit_size[i - 1] + 1;
+
+        if (all_ok)
+        {
+            if (verbose)
+                printf("[%d] iZ_random_primes: Test Passed for %d x %d bits (%d threads, %.1f primes/s)\n",
+                       i, batch_size, bit_size[i - 1], threads[i - 1], rate);
+        }
+        else
+        {
+            failed_tests++;
+            if (verbose)
+                printf("[%d] iZ_random_primes: Test Failed for %d x %d bits (%d threads, %d found)\n",
+                       i, batch_size, bit_size[i - 1], threads[i - 1], found);
+        }
+    }
+
+    // sizes below the first vx segment are rejected
+    if (iZ_random_primes(batch, batch_size, IZ_RANDOM_PRIMES_MIN_BITS - 1, 1, NULL) != 0)
+    {
+        failed_tests++;
+        if (verbose)
+            printf("[%d] iZ_random_primes: Test Failed, %d bits was not rejected\n",
+                   test_rounds + 1, IZ_RANDOM_PRIMES_MIN_BITS - 1);
+    }
+    else if (verbose)
+    {
+        printf("[%d] iZ_random_primes: Test Passed, %d bits rejected\n", test_rounds + 1, IZ_RANDOM_PRIMES_MIN_BITS - 1);
+    }
+
+    for (int j = 0; j < batch_size; j++)
+        mpz_clear(batch[j]);
+
+    printf("\n\n");
+    print_line(60, '*');
+    if (failed_tests == 0 && verbose)
+    {
+        printf("[SUCCESS] All iZ_random_primes tests passed! ^_^\n");
+    }
+    else if (failed_tests > 0 && verbose)
+    {
+        printf("[FAILURE] %d iZ_random_primes tests failed :\\\n", failed_tests);
+    }
+    print_line(60, '*');
+
+    return (failed_tests == 0) ? 1 : 0;
+}
+
+// tests for iZ_next_prime_batch: every slot must match a single iZ_next_prime
+// call on its base, for bases of mixed sizes, both directions and thread counts.
+int TEST_iZ_next_prime_batch(int verbose)
+{
+    print_test_fn_header("iZ_next_prime_batch");
+    printf("Comparing iZ_next_prime_batch results with per-base iZ_next_prime calls...\n");
+
+    int failed_tests = 0;
+    int threads[] = {1, 4, 1, 3};
+    int forward[] = {1, 1, 0, 0};
+    int test_rounds = 4;
+
+    // small, 64-bit, 128-bit and random multi-word bases, one 6x + 5 and one 6x boundary
+    int batch_size = 12;
+    const char *fixed[] = {"100", "1000000007", "18446744073709551615", "340282366920938463463374607431768211455"};
+    int random_bits[] = {256, 512, 1024, 384, 256, 512};
+
+    gmp_randstate_t state;
+    gmp_randinit_default(state);
+    gmp_seed_randstate(state);
+
+    mpz_t bases[batch_size], out[batch_size], ref;
+    mpz_init(ref);
+    for (int j = 0; j < batch_size; j++)
+    {
+        mpz_inits(bases[j], out[j], NULL);
+        if (j < 4)
+            mpz_set_str(bases[j], fixed[j], 10);
+        else if (j < 10)
+            mpz_urandomb(bases[j], state, random_bits[j - 4]);
+        else
+            mpz_ui_pow_ui(bases[j], 6, 100 + j); // 6x
+    }
+    mpz_sub_ui(bases[11], bases[11], 1); // 6x + 5
+
+    for (int i = 1; i <= test_rounds; i++)
+    {
+        int found = iZ_next_prime_batch(out, bases, batch_size, forward[i - 1], threads[i - 1]);
+
+        int all_ok = found == batch_size;
+        for (int j = 0; all_ok && j < batch_size; j++)
+            all_ok = iZ_next_prime(ref, bases[j], forward[i - 1]) && mpz_cmp(ref, out[j]) == 0;
+
+        if (all_ok)
+        {
+            if (verbose)
+                printf("[%d] iZ_next_prime_batch: Test Passed for %d bases (%s, %d threads)\n",
+                       i, batch_size, forward[i - 1] ? "forward" : "backward", threads[i - 1]);
+        }
+        else
+        {
+            failed_tests++;
+            if (verbose)
+                printf("[%d] iZ_next_prime_batch: Test Failed for %d bases (%s, %d threads, %d found)\n",
+                       i, batch_size, forward[i - 1] ? "forward" : "backward", threads[i - 1], found);
+        }
+    }
+
+    for (int j = 0; j < batch_size; j++)
+        mpz_clears(bases[j], out[j], NULL);
+    mpz_clear(ref);
+    gmp_randclear(state);
+
+    printf("\n\n");
+    print_line(60, '*');
+    if (failed_tests == 0 && verbose)
+    {
+        printf("[SUCCESS] All iZ_next_prime_batch tests passed! ^_^\n");
+    }
+    else if (failed_tests > 0 && verbose)
+    {
+        printf("[FAILURE] %d iZ_next_prime_batch tests failed :\\\n", failed_tests);
+    }
+    print_line(60, '*');
+
+    return (failed_tests == 0) ? 1 : 0;
+}
+
 // ========================================================================
 // * Benchmarking Random Prime Generation Algorithms
 // ========================================================================
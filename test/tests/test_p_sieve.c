@@ -2,16 +2,24 @@
 
 // Sieve function type, takes uint64_t limit and returns a UI64_ARRAY pointer
 
+// threaded model adapters: an explicit worker count, so the threaded paths
+// run even on single-core hosts (0 would fall back to the serial sieves there)
+static UI64_ARRAY *SiZm_mt_4(uint64_t n) { return SiZm_mt(n, 4); }
+static UI64_ARRAY *SiZm_vy_mt_4(uint64_t n) { return SiZm_vy_mt(n, 4); }
+
 // * List of available algorithms
-const SIEVE_MODEL _SoE = {SoE, "SoE"};             // * Sieve of Eratosthenes
-const SIEVE_MODEL _SSoE = {SSoE, "SSoE"};          // * Segmented Sieve of Eratosthenes
-const SIEVE_MODEL _SoS = {SoS, "SoS"};             // * Sieve of Sundaram
-const SIEVE_MODEL _SSoS = {SSoS, "SSoS"};          // * Segmented Sieve of Sundaram
-const SIEVE_MODEL _SoEu = {SoEu, "SoEu"};          // * Sieve of Euler (linear sieve)
-const SIEVE_MODEL _SoA = {SoA, "SoA"};             // * Sieve of Atkin
-const SIEVE_MODEL _SiZ = {SiZ, "SiZ"};             // * Sieve-iZ
-const SIEVE_MODEL _SiZm = {SiZm, "SiZm"};          // * Sieve-iZm
-const SIEVE_MODEL _SiZm_vy = {SiZm_vy, "SiZm_vy"}; // * Sieve-iZm_vy (unordered)
+const SIEVE_MODEL _SoE = {SoE, "SoE"};                                     // * Sieve of Eratosthenes
+const SIEVE_MODEL _SSoE = {SSoE, "SSoE"};                                  // * Segmented Sieve of Eratosthenes
+const SIEVE_MODEL _SoS = {SoS, "SoS"};                                     // * Sieve of Sundaram
+const SIEVE_MODEL _SSoS = {SSoS, "SSoS"};                                  // * Segmented Sieve of Sundaram
+const SIEVE_MODEL _SoEu = {SoEu, "SoEu"};                                  // * Sieve of Euler (linear sieve)
+const SIEVE_MODEL _SoA = {SoA, "SoA"};                                     // * Sieve of Atkin
+const SIEVE_MODEL _SiZ = {SiZ, "SiZ"};                                     // * Sieve-iZ
+const SIEVE_MODEL _SiZm = {SiZm, "SiZm"};                                  // * Sieve-iZm
+const SIEVE_MODEL _SiZm_mt = {SiZm_mt_4, "SiZm_mt"};                       // * Sieve-iZm (multi-threaded)
+const SIEVE_MODEL _SiZm_vy = {SiZm_vy, "SiZm_vy"};                         // * Sieve-iZm_vy (unordered)
+const SIEVE_MODEL _SiZm_vy_mt = {SiZm_vy_mt_4, "SiZm_vy_mt"};              // * Sieve-iZm_vy (multi-threaded, unordered)
+const SIEVE_MODEL _SiZm_vy_ordered = {SiZm_vy_ordered, "SiZm_vy_ordered"}; // * Sieve-iZm_vy (row-major, ordered)
 
 // * Define new sieve models here to include them in tests and benchmarks
 // const SIEVE_MODEL _MySieve = {MySieve, "MySieve"}; // Example: add your custom sieve implementation here
@@ -27,7 +35,10 @@ SIEVE_MODEL SIEVE_MODELS[] = {
     _SoA,
     _SiZ,
     _SiZm,
+    _SiZm_mt,
     _SiZm_vy,
+    _SiZm_vy_mt,
+    _SiZm_vy_ordered,
     // _MySieve, // Example: add your custom sieve implementation here
 };
 